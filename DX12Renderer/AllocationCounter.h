@@ -0,0 +1,79 @@
+/**
+ * Counts heap allocations while an instance is alive, to check that hot loops do not allocate.
+ */
+
+#pragma once
+
+#if defined(_DEBUG)
+#include <crtdbg.h>
+#include <mutex>
+#endif
+
+// Uses the debug CRT allocation hook, so it only counts in Debug builds (Release always reports 0).
+// Only allocations made by the thread that created the instance are counted, so other threads
+// (background streaming, other recording threads) do not show up in it. Instances nest; each
+// counts everything its thread allocates while it is alive. GetCount belongs on the same thread.
+//
+// The hook is installed once, on first use, and calls whichever hook was installed before it.
+class ScopedAllocationCounter
+{
+public:
+    ScopedAllocationCounter()
+    {
+#if defined(_DEBUG)
+        InstallHook();
+        m_Start = t_Count;
+        ++t_Armed;
+#endif
+    }
+
+    ~ScopedAllocationCounter()
+    {
+#if defined(_DEBUG)
+        --t_Armed;
+#endif
+    }
+
+    ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+    long GetCount() const
+    {
+#if defined(_DEBUG)
+        return t_Count - m_Start;
+#else
+        return 0;
+#endif
+    }
+
+private:
+#if defined(_DEBUG)
+    static void InstallHook()
+    {
+        static std::once_flag installed;
+        std::call_once(installed, []() { PreviousHook() = _CrtSetAllocHook(&Hook); });
+    }
+
+    static _CRT_ALLOC_HOOK& PreviousHook()
+    {
+        static _CRT_ALLOC_HOOK previousHook = nullptr;
+        return previousHook;
+    }
+
+    static int __cdecl Hook(int allocType, void* userData, size_t size, int blockType, long requestNumber,
+        const unsigned char* fileName, int lineNumber)
+    {
+        if (t_Armed > 0 && (allocType == _HOOK_ALLOC || allocType == _HOOK_REALLOC))
+            ++t_Count;
+
+        _CRT_ALLOC_HOOK previousHook = PreviousHook();
+        return previousHook ? previousHook(allocType, userData, size, blockType, requestNumber, fileName, lineNumber) : TRUE;
+    }
+
+    // Plain values, so reading them from inside the hook never allocates
+    static inline thread_local int t_Armed = 0;
+    static inline thread_local long t_Count = 0;
+
+    long m_Start = 0;
+#endif
+};
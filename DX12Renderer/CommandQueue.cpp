@@ -1,223 +1,331 @@
-#include "CommandQueue.h"
-#include "Helpers.h"
-#include <cassert>
-#include "d3dx12.h"
-#include "DXAccess.h"
-#include "Application.h"
-#include <iostream>
-
-
-CommandQueue::CommandQueue(Microsoft::WRL::ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type)
-    : m_FenceValue(0)
-    , m_CommandListType(type)
-    , m_d3d12Device(device)
-{
-    D3D12_COMMAND_QUEUE_DESC desc = {};
-    desc.Type = type;
-    desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
-    desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
-    desc.NodeMask = 0;
-
-    ThrowIfFailed(m_d3d12Device->CreateCommandQueue(&desc, IID_PPV_ARGS(&m_d3d12CommandQueue)));
-    ThrowIfFailed(m_d3d12Device->CreateFence(m_FenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_d3d12Fence)));
-    ThrowIfFailed(m_d3d12Device->CreateCommandAllocator(type, IID_PPV_ARGS(&m_CommandAllocator)));
-    ThrowIfFailed(m_d3d12Device->CreateCommandList(0, type, m_CommandAllocator.Get(), nullptr, IID_PPV_ARGS(&m_CommandList)));
-    m_CommandList->SetPrivateDataInterface(__uuidof(ID3D12CommandAllocator), m_CommandAllocator.Get());
-    ThrowIfFailed(m_CommandList->Close());
-
-    m_FenceEvent = ::CreateEvent(NULL, FALSE, FALSE, NULL);
-    assert(m_FenceEvent && "Failed to create fence event handle.");
-}
-
-CommandQueue::~CommandQueue()
-{
-}
-
-void CommandQueue::UploadData(ComPtr<ID3D12Resource> resource, D3D12_SUBRESOURCE_DATA subresource, UINT subresourceNumber)
-{
-    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
-    CD3DX12_RESOURCE_BARRIER copyBarrier = CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(), D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST);
-    CD3DX12_RESOURCE_BARRIER pixelBarrier = CD3DX12_RESOURCE_BARRIER::Transition(resource.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-    ThrowIfFailed(m_CommandAllocator->Reset());
-    ThrowIfFailed(m_CommandList->Reset(m_CommandAllocator.Get(), nullptr));
-
-    m_CommandList->ResourceBarrier(1, &copyBarrier);
-
-    UINT64 size = GetRequiredIntermediateSize(resource.Get(), 0, 1);
-    ComPtr<ID3D12Resource> intermediate;
-    D3D12_HEAP_PROPERTIES properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-    D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Buffer(size);
-
-    ThrowIfFailed(device->CreateCommittedResource(
-        &properties,
-        D3D12_HEAP_FLAG_NONE,
-        &desc,
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(&intermediate)
-    ));
-
-    UpdateSubresources(m_CommandList.Get(), resource.Get(), intermediate.Get(), 0, 0, subresourceNumber, &subresource);
-    m_CommandList->ResourceBarrier(1, &pixelBarrier);
-    m_CommandList->Close();
-
-    ExecuteCommandList();
-    WaitForFenceValue(Signal());
-}
-
-void CommandQueue::UploadData(ID3D12Resource* resource, std::vector<D3D12_SUBRESOURCE_DATA> subresources, UINT subresourceNumber    )
-{
-    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
-    CD3DX12_RESOURCE_BARRIER copyBarrier = CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_COPY_DEST);
-    CD3DX12_RESOURCE_BARRIER pixelBarrier = CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-
-    ThrowIfFailed(m_CommandAllocator->Reset());
-    ThrowIfFailed(m_CommandList->Reset(m_CommandAllocator.Get(), nullptr));
-
-    m_CommandList->ResourceBarrier(1, &copyBarrier);
-
-    // upload is implemented by application developer. Here's one solution using <d3dx12.h>
-    const UINT64 uploadBufferSize = GetRequiredIntermediateSize(resource,
-        0, static_cast<unsigned int>(subresources.size()));
-
-    ComPtr<ID3D12Resource> textureUploadHeap;
-    device->CreateCommittedResource(
-        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
-        D3D12_HEAP_FLAG_NONE,
-        &CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
-        D3D12_RESOURCE_STATE_GENERIC_READ,
-        nullptr,
-        IID_PPV_ARGS(textureUploadHeap.GetAddressOf()));
-
-    UpdateSubresources(m_CommandList.Get(),
-        resource, textureUploadHeap.Get(),
-        0, 0, static_cast<unsigned int>(subresources.size()),
-        subresources.data());
-
-    m_CommandList->ResourceBarrier(1, &pixelBarrier);
-    m_CommandList->Close();
-
-    ExecuteCommandList();
-    WaitForFenceValue(Signal());
-}
-
-uint64_t CommandQueue::Signal()
-{
-    uint64_t fenceValue = ++m_FenceValue;
-    m_d3d12CommandQueue->Signal(m_d3d12Fence.Get(), fenceValue);
-    return fenceValue;
-}
-
-bool CommandQueue::IsFenceComplete(uint64_t fenceValue)
-{
-    return m_d3d12Fence->GetCompletedValue() >= fenceValue;
-}
-
-void CommandQueue::WaitForFenceValue(uint64_t fenceValue)
-{
-    if (!IsFenceComplete(fenceValue))
-    {
-        m_d3d12Fence->SetEventOnCompletion(fenceValue, m_FenceEvent);
-        ::WaitForSingleObject(m_FenceEvent, DWORD_MAX);
-    }
-}
-
-void CommandQueue::Flush()
-{
-    WaitForFenceValue(Signal());
-}
-
-Microsoft::WRL::ComPtr<ID3D12CommandAllocator> CommandQueue::CreateCommandAllocator()
-{
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
-    ThrowIfFailed(m_d3d12Device->CreateCommandAllocator(m_CommandListType, IID_PPV_ARGS(&commandAllocator)));
-
-    return commandAllocator;
-}
-
-Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> CommandQueue::CreateCommandList(Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator)
-{
-    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList;
-    ThrowIfFailed(m_d3d12Device->CreateCommandList(0, m_CommandListType, allocator.Get(), nullptr, IID_PPV_ARGS(&commandList)));
-
-    return commandList;
-}
-
-Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> CommandQueue::GetCommandList()
-{
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
-    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList;
-
-    if (!m_CommandAllocatorQueue.empty() && IsFenceComplete(m_CommandAllocatorQueue.front().fenceValue))
-    {
-        commandAllocator = m_CommandAllocatorQueue.front().commandAllocator;
-        m_CommandAllocatorQueue.pop();
-
-        ThrowIfFailed(commandAllocator->Reset());
-    }
-    else
-    {
-        commandAllocator = CreateCommandAllocator();
-    }
-
-    if (!m_CommandListQueue.empty())
-    {
-        commandList = m_CommandListQueue.front();
-        m_CommandListQueue.pop();
-
-        ThrowIfFailed(commandList->Reset(commandAllocator.Get(), nullptr));
-    }
-    else
-    {
-        commandList = CreateCommandList(commandAllocator);
-    }
-
-    // Associate the command allocator with the command list so that it can be
-    // retrieved when the command list is executed.
-    ThrowIfFailed(commandList->SetPrivateDataInterface(__uuidof(ID3D12CommandAllocator), commandAllocator.Get()));
-
-    return commandList;
-}
-
-// Execute a command list.
-// Returns the fence value to wait for for this command list.
-uint64_t CommandQueue::ExecuteCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList)
-{
-    commandList->Close();
-
-
-    ID3D12CommandAllocator* commandAllocator;
-    UINT dataSize = sizeof(commandAllocator);
-
-    ThrowIfFailed(commandList->GetPrivateData(__uuidof(ID3D12CommandAllocator), &dataSize, &commandAllocator));
-
-    ID3D12CommandList* const ppCommandLists[] = {
-        commandList.Get()
-    };
-
-    m_d3d12CommandQueue->ExecuteCommandLists(1, ppCommandLists);
-    uint64_t fenceValue = Signal();
-
-    m_CommandAllocatorQueue.emplace(CommandAllocatorEntry{ fenceValue, commandAllocator });
-    m_CommandListQueue.push(commandList);
-
-    // The ownership of the command allocator has been transferred to the ComPtr
-    // in the command allocator queue. It is safe to release the reference 
-    // in this temporary COM pointer here.
-    commandAllocator->Release();
-
-    return fenceValue;
-}
-
-void CommandQueue::ExecuteCommandList()
-{
-    ID3D12CommandList* const commandLists[] = { m_CommandList.Get() };
-    m_d3d12CommandQueue->ExecuteCommandLists(_countof(commandLists), commandLists);
-    uint64_t fenceValue = Signal();
-}
-
-Microsoft::WRL::ComPtr<ID3D12CommandQueue> CommandQueue::GetD3D12CommandQueue() const
-{
-    return m_d3d12CommandQueue;
+#include "CommandQueue.h"
+#include "Helpers.h"
+#include <cassert>
+#include "d3dx12.h"
+#include "DXAccess.h"
+#include "Application.h"
+#include "DescriptorHeap.h"
+#include "ResourceStateTracker.h"
+#include <iostream>
+
+
+CommandQueue::CommandQueue(Microsoft::WRL::ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type)
+    : m_FenceValue(0)
+    , m_CommandListType(type)
+    , m_d3d12Device(device)
+{
+    D3D12_COMMAND_QUEUE_DESC desc = {};
+    desc.Type = type;
+    desc.Priority = D3D12_COMMAND_QUEUE_PRIORITY_NORMAL;
+    desc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+    desc.NodeMask = 0;
+
+    ThrowIfFailed(m_d3d12Device->CreateCommandQueue(&desc, IID_PPV_ARGS(&m_d3d12CommandQueue)));
+    ThrowIfFailed(m_d3d12Device->CreateFence(m_FenceValue.load(), D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&m_d3d12Fence)));
+
+    m_FenceEvent = ::CreateEvent(NULL, FALSE, FALSE, NULL);
+    assert(m_FenceEvent && "Failed to create fence event handle.");
+}
+
+CommandQueue::~CommandQueue()
+{
+}
+
+void CommandQueue::UploadData(ComPtr<ID3D12Resource> resource, D3D12_SUBRESOURCE_DATA subresource, UINT subresourceNumber)
+{
+    UploadData(resource.Get(), std::vector<D3D12_SUBRESOURCE_DATA>{ subresource }, subresourceNumber);
+}
+
+void CommandQueue::UploadData(ID3D12Resource* resource, std::vector<D3D12_SUBRESOURCE_DATA> subresources, UINT subresourceNumber    )
+{
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+
+    ComPtr<ID3D12GraphicsCommandList2> commandList = GetCommandList();
+    ResourceStateTracker& stateTracker = GetResourceStateTracker(commandList.Get());
+
+    // From whatever state the resource was created or last left in
+    stateTracker.TransitionResource(resource, D3D12_RESOURCE_STATE_COPY_DEST);
+    stateTracker.FlushResourceBarriers(commandList.Get());
+
+    // upload is implemented by application developer. Here's one solution using <d3dx12.h>
+    const UINT64 uploadBufferSize = GetRequiredIntermediateSize(resource,
+        0, static_cast<unsigned int>(subresources.size()));
+
+    ComPtr<ID3D12Resource> textureUploadHeap;
+    ThrowIfFailed(device->CreateCommittedResource(
+        &CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+        D3D12_HEAP_FLAG_NONE,
+        &CD3DX12_RESOURCE_DESC::Buffer(uploadBufferSize),
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(textureUploadHeap.GetAddressOf())));
+
+    // The source data is copied into the upload heap here, so callers may free it on return
+    UpdateSubresources(commandList.Get(),
+        resource, textureUploadHeap.Get(),
+        0, 0, static_cast<unsigned int>(subresources.size()),
+        subresources.data());
+
+    stateTracker.TransitionResource(resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    // Later submissions on this queue are ordered after the copy, so there is nothing to wait for;
+    // the upload heap only has to outlive the copy itself.
+    uint64_t fenceValue = ExecuteCommandList(commandList);
+    ReleaseDeferred(textureUploadHeap, fenceValue);
+}
+
+uint64_t CommandQueue::UploadData(ID3D12Resource* resource, ID3D12Resource* uploadBuffer, UINT64 uploadOffset,
+    const D3D12_SUBRESOURCE_DATA& subresource)
+{
+    // Placed footprints start on 512-byte boundaries
+    assert(uploadOffset % D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT == 0);
+
+    ComPtr<ID3D12GraphicsCommandList2> commandList = GetCommandList();
+    ResourceStateTracker& stateTracker = GetResourceStateTracker(commandList.Get());
+
+    stateTracker.TransitionResource(resource, D3D12_RESOURCE_STATE_COPY_DEST);
+    stateTracker.FlushResourceBarriers(commandList.Get());
+    UpdateSubresources(commandList.Get(), resource, uploadBuffer, uploadOffset, 0, 1, &subresource);
+    stateTracker.TransitionResource(resource, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+    return ExecuteCommandList(commandList);
+}
+
+uint64_t CommandQueue::Signal()
+{
+    uint64_t fenceValue = ++m_FenceValue;
+    m_d3d12CommandQueue->Signal(m_d3d12Fence.Get(), fenceValue);
+    return fenceValue;
+}
+
+bool CommandQueue::IsFenceComplete(uint64_t fenceValue)
+{
+    return m_d3d12Fence->GetCompletedValue() >= fenceValue;
+}
+
+void CommandQueue::WaitForFenceValue(uint64_t fenceValue)
+{
+    if (!IsFenceComplete(fenceValue))
+    {
+        m_d3d12Fence->SetEventOnCompletion(fenceValue, m_FenceEvent);
+        ::WaitForSingleObject(m_FenceEvent, DWORD_MAX);
+    }
+}
+
+void CommandQueue::Flush()
+{
+    WaitForFenceValue(Signal());
+    ProcessDeferredReleases();
+}
+
+uint64_t CommandQueue::GetNextFenceValue() const
+{
+    return m_FenceValue.load() + 1;
+}
+
+void CommandQueue::ReleaseDeferred(ComPtr<ID3D12Pageable> resource, uint64_t fenceValue)
+{
+    if (!resource)
+        return;
+
+    DeferredRelease entry{};
+    entry.resource = std::move(resource);
+    RetireDeferred(std::move(entry), fenceValue);
+}
+
+void CommandQueue::FreeDescriptorDeferred(std::shared_ptr<DescriptorHeap> heap, UINT index, uint64_t fenceValue)
+{
+    DeferredRelease entry{};
+    entry.descriptorHeap = std::move(heap);
+    entry.descriptorIndex = index;
+    RetireDeferred(std::move(entry), fenceValue);
+}
+
+void CommandQueue::ReleaseDeferred(std::function<void()> release, uint64_t fenceValue)
+{
+    DeferredRelease entry{};
+    entry.release = std::move(release);
+    RetireDeferred(std::move(entry), fenceValue);
+}
+
+void CommandQueue::RetireDeferred(DeferredRelease&& entry, uint64_t fenceValue)
+{
+    std::lock_guard<std::mutex> lock(m_DeferredReleaseMutex);
+    entry.fenceValue = fenceValue != 0 ? fenceValue : GetNextFenceValue();
+    m_DeferredReleases.push_back(std::move(entry));
+}
+
+void CommandQueue::ProcessDeferredReleases()
+{
+    const uint64_t completedValue = m_d3d12Fence->GetCompletedValue();
+
+    for (;;)
+    {
+        DeferredRelease entry;
+        {
+            std::lock_guard<std::mutex> lock(m_DeferredReleaseMutex);
+            // Released front to back; an entry behind a later fence just waits a little longer
+            if (m_DeferredReleases.empty() || m_DeferredReleases.front().fenceValue > completedValue)
+                break;
+
+            entry = std::move(m_DeferredReleases.front());
+            m_DeferredReleases.pop_front();
+        }
+
+        // Run outside the lock so a release callback may retire something else
+        if (entry.descriptorHeap)
+            entry.descriptorHeap->FreeIndex(entry.descriptorIndex);
+        if (entry.release)
+            entry.release();
+    }
+}
+
+Microsoft::WRL::ComPtr<ID3D12CommandAllocator> CommandQueue::CreateCommandAllocator()
+{
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+    ThrowIfFailed(m_d3d12Device->CreateCommandAllocator(m_CommandListType, IID_PPV_ARGS(&commandAllocator)));
+
+    return commandAllocator;
+}
+
+Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> CommandQueue::CreateCommandList(Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator)
+{
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList;
+    ThrowIfFailed(m_d3d12Device->CreateCommandList(0, m_CommandListType, allocator.Get(), nullptr, IID_PPV_ARGS(&commandList)));
+
+    std::lock_guard<std::mutex> lock(m_CommandListMutex);
+    m_ResourceStateTrackers.emplace(commandList.Get(), std::make_unique<ResourceStateTracker>());
+
+    return commandList;
+}
+
+Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> CommandQueue::GetCommandList()
+{
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList;
+
+    // Only taking them out of the pools is locked; resetting and creating is not
+    {
+        std::lock_guard<std::mutex> lock(m_CommandListMutex);
+
+        if (!m_CommandAllocatorQueue.empty() && IsFenceComplete(m_CommandAllocatorQueue.front().fenceValue))
+        {
+            commandAllocator = m_CommandAllocatorQueue.front().commandAllocator;
+            m_CommandAllocatorQueue.pop();
+        }
+
+        if (!m_CommandListQueue.empty())
+        {
+            commandList = m_CommandListQueue.front();
+            m_CommandListQueue.pop();
+        }
+    }
+
+    if (commandAllocator)
+        ThrowIfFailed(commandAllocator->Reset());
+    else
+        commandAllocator = CreateCommandAllocator();
+
+    if (commandList)
+        ThrowIfFailed(commandList->Reset(commandAllocator.Get(), nullptr));
+    else
+        commandList = CreateCommandList(commandAllocator);
+
+    // Associate the command allocator with the command list so that it can be
+    // retrieved when the command list is executed.
+    ThrowIfFailed(commandList->SetPrivateDataInterface(__uuidof(ID3D12CommandAllocator), commandAllocator.Get()));
+
+    return commandList;
+}
+
+// Execute a command list.
+// Returns the fence value to wait for for this command list.
+uint64_t CommandQueue::ExecuteCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList)
+{
+    return ExecuteCommandLists(std::span(&commandList, 1));
+}
+
+uint64_t CommandQueue::ExecuteCommandLists(std::span<const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>> commandLists)
+{
+    for (const auto& commandList : commandLists)
+    {
+        // Transitions queued after the last draw or copy still belong in the list
+        GetResourceStateTracker(commandList.Get()).FlushResourceBarriers(commandList.Get());
+        commandList->Close();
+    }
+
+    uint64_t fenceValue;
+    {
+        std::unique_lock<std::mutex> lock = ResourceStateTracker::LockGlobalState();
+        m_SubmittedCommandLists.clear();
+
+        // The states a list expects its resources in on entry are only known now, against what the
+        // lists before it left them in. The transitions that takes, if any, are recorded on a list
+        // of their own that runs right before it.
+        for (const auto& commandList : commandLists)
+        {
+            ResourceStateTracker& stateTracker = GetResourceStateTracker(commandList.Get());
+
+            if (stateTracker.ResolvePendingResourceBarriers() > 0)
+            {
+                Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> pendingCommandList = GetCommandList();
+                stateTracker.FlushPendingResourceBarriers(pendingCommandList.Get());
+                pendingCommandList->Close();
+
+                m_SubmittedCommandLists.push_back(pendingCommandList.Get());
+                m_PendingCommandLists.push_back(std::move(pendingCommandList));
+            }
+            stateTracker.CommitFinalResourceStates();
+            m_SubmittedCommandLists.push_back(commandList.Get());
+        }
+
+        m_d3d12CommandQueue->ExecuteCommandLists(static_cast<UINT>(m_SubmittedCommandLists.size()), m_SubmittedCommandLists.data());
+        fenceValue = Signal();
+
+        for (const auto& pendingCommandList : m_PendingCommandLists)
+            RetireCommandList(pendingCommandList, fenceValue);
+        m_PendingCommandLists.clear();
+    }
+
+    for (const auto& commandList : commandLists)
+    {
+        GetResourceStateTracker(commandList.Get()).Reset();
+        RetireCommandList(commandList, fenceValue);
+    }
+
+    ProcessDeferredReleases();
+
+    return fenceValue;
+}
+
+ResourceStateTracker& CommandQueue::GetResourceStateTracker(ID3D12GraphicsCommandList2* commandList)
+{
+    std::lock_guard<std::mutex> lock(m_CommandListMutex);
+    auto it = m_ResourceStateTrackers.find(commandList);
+    assert(it != m_ResourceStateTrackers.end() && "Command list does not come from this queue");
+    return *it->second;
+}
+
+void CommandQueue::RetireCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, uint64_t fenceValue)
+{
+    ID3D12CommandAllocator* commandAllocator;
+    UINT dataSize = sizeof(commandAllocator);
+
+    ThrowIfFailed(commandList->GetPrivateData(__uuidof(ID3D12CommandAllocator), &dataSize, &commandAllocator));
+
+    {
+        std::lock_guard<std::mutex> lock(m_CommandListMutex);
+        m_CommandAllocatorQueue.emplace(CommandAllocatorEntry{ fenceValue, commandAllocator });
+        m_CommandListQueue.push(commandList);
+    }
+
+    // The ownership of the command allocator has been transferred to the ComPtr
+    // in the command allocator queue. It is safe to release the reference 
+    // in this temporary COM pointer here.
+    commandAllocator->Release();
+}
+
+Microsoft::WRL::ComPtr<ID3D12CommandQueue> CommandQueue::GetD3D12CommandQueue() const
+{
+    return m_d3d12CommandQueue;
 }
\ No newline at end of file
@@ -1,71 +1,165 @@
-/**
- * Wrapper class for a ID3D12CommandQueue.
- */
-
-#pragma once
-
-#include <d3d12.h>  // For ID3D12CommandQueue, ID3D12Device2, and ID3D12Fence
-#include <wrl.h>    // For Microsoft::WRL::ComPtr
-
-#include <cstdint>  // For uint64_t
-#include <queue>    // For std::queue
-
-using namespace Microsoft::WRL;
-
-class CommandQueue
-{
-public:
-    CommandQueue(Microsoft::WRL::ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type);
-    virtual ~CommandQueue();
-
-    // Get an available command list from the command queue.
-    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> GetCommandList();
-
-    // Execute a command list.
-    // Returns the fence value to wait for for this command list.
-    uint64_t ExecuteCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList);
-    void ExecuteCommandList();
-
-    /// <summary>
-    /// Allows you to update/upload data to the GPU
-    /// </summary>
-    /// <param name="resource"></param>
-    /// <param name="subresource"></param>
-    void UploadData(ComPtr<ID3D12Resource> resource, D3D12_SUBRESOURCE_DATA subresource, UINT subresourceNumber = 1);
-    void UploadData(ID3D12Resource* resource, std::vector<D3D12_SUBRESOURCE_DATA> subresources, UINT subresourceNumber = 1);
-
-    uint64_t Signal();
-    bool IsFenceComplete(uint64_t fenceValue);
-    void WaitForFenceValue(uint64_t fenceValue);
-    void Flush();
-
-    Microsoft::WRL::ComPtr<ID3D12CommandQueue> GetD3D12CommandQueue() const;
-protected:
-
-    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> CreateCommandAllocator();
-    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> CreateCommandList(Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator);
-
-private:
-    // Keep track of command allocators that are "in-flight"
-    struct CommandAllocatorEntry
-    {
-        uint64_t fenceValue;
-        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
-    };
-
-    using CommandAllocatorQueue = std::queue<CommandAllocatorEntry>;
-    using CommandListQueue = std::queue< Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> >;
-
-    D3D12_COMMAND_LIST_TYPE                     m_CommandListType;
-    Microsoft::WRL::ComPtr<ID3D12Device2>       m_d3d12Device;
-    Microsoft::WRL::ComPtr<ID3D12CommandQueue>  m_d3d12CommandQueue;
-    Microsoft::WRL::ComPtr<ID3D12Fence>         m_d3d12Fence;
-    HANDLE                                      m_FenceEvent;
-    uint64_t                                    m_FenceValue;
-
-    CommandAllocatorQueue                       m_CommandAllocatorQueue;
-    CommandListQueue                            m_CommandListQueue;
-
-    ComPtr<ID3D12CommandAllocator> m_CommandAllocator;
-    ComPtr<ID3D12GraphicsCommandList2> m_CommandList;
+/**
+ * Wrapper class for a ID3D12CommandQueue.
+ */
+
+#pragma once
+
+#include <d3d12.h>  // For ID3D12CommandQueue, ID3D12Device2, and ID3D12Fence
+#include <wrl.h>    // For Microsoft::WRL::ComPtr
+
+#include <atomic>   // For std::atomic
+#include <cstdint>  // For uint64_t
+#include <deque>    // For std::deque
+#include <functional> // For std::function
+#include <memory>   // For std::shared_ptr
+#include <mutex>    // For std::mutex
+#include <queue>    // For std::queue
+#include <span>     // For std::span
+#include <unordered_map> // For std::unordered_map
+#include <vector>   // For std::vector
+
+class DescriptorHeap;
+class ResourceStateTracker;
+
+using namespace Microsoft::WRL;
+
+class CommandQueue
+{
+public:
+    CommandQueue(Microsoft::WRL::ComPtr<ID3D12Device2> device, D3D12_COMMAND_LIST_TYPE type);
+    virtual ~CommandQueue();
+
+    // Get an available command list from the command queue.
+    // Safe to call from any thread; each list (and its allocator) is recorded by one thread at a time.
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> GetCommandList();
+
+    // Execute a command list.
+    // Returns the fence value to wait for for this command list.
+    uint64_t ExecuteCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList);
+
+    /// <summary>
+    /// Executes command lists in the given order with a single ExecuteCommandLists call, e.g. the
+    /// lists several threads recorded a frame into. Their pending barriers are resolved in that
+    /// order too, each list against the states the ones before it leave; a list whose resources
+    /// need transitions on entry gets a pooled list for them in front of it. Returns the fence
+    /// value to wait for for all of them.
+    /// </summary>
+    uint64_t ExecuteCommandLists(std::span<const Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>> commandLists);
+
+    /// <summary>
+    /// The resource state tracker of a command list from GetCommandList. Transitions go through
+    /// it rather than straight to the list; ExecuteCommandList flushes what is left, moves the
+    /// resources from their global states to the ones the list starts with, and commits the
+    /// states it ends with.
+    /// </summary>
+    ResourceStateTracker& GetResourceStateTracker(ID3D12GraphicsCommandList2* commandList);
+
+    /// <summary>
+    /// Allows you to update/upload data to the GPU. Recorded on a pooled command list and
+    /// executed without waiting; the intermediate upload heap is released deferred.
+    /// </summary>
+    /// <param name="resource"></param>
+    /// <param name="subresource"></param>
+    void UploadData(ComPtr<ID3D12Resource> resource, D3D12_SUBRESOURCE_DATA subresource, UINT subresourceNumber = 1);
+    void UploadData(ID3D12Resource* resource, std::vector<D3D12_SUBRESOURCE_DATA> subresources, UINT subresourceNumber = 1);
+
+    /// <summary>
+    /// Rewrites a texture that is already in use, copying through a caller-owned upload buffer at
+    /// uploadOffset instead of creating one. The texture ends up in PIXEL_SHADER_RESOURCE; the
+    /// caller must not touch that part of the upload buffer again until the returned fence value
+    /// has completed.
+    /// </summary>
+    uint64_t UploadData(ID3D12Resource* resource, ID3D12Resource* uploadBuffer, UINT64 uploadOffset,
+        const D3D12_SUBRESOURCE_DATA& subresource);
+
+    uint64_t Signal();
+    bool IsFenceComplete(uint64_t fenceValue);
+    void WaitForFenceValue(uint64_t fenceValue);
+    void Flush();
+
+    /// <summary>
+    /// The fence value that the next submission on this queue will signal. Anything recorded
+    /// but not yet executed completes with (at the latest) this value.
+    /// </summary>
+    uint64_t GetNextFenceValue() const;
+
+    /// <summary>
+    /// Keeps a resource alive until the GPU has passed fenceValue, instead of flushing the queue
+    /// before releasing it. A fenceValue of 0 means the next submission (GetNextFenceValue).
+    /// </summary>
+    void ReleaseDeferred(ComPtr<ID3D12Pageable> resource, uint64_t fenceValue = 0);
+
+    /// <summary>
+    /// Returns a descriptor slot to its heap once the GPU has passed fenceValue, so a new
+    /// descriptor cannot overwrite one that in-flight command lists still read.
+    /// </summary>
+    void FreeDescriptorDeferred(std::shared_ptr<DescriptorHeap> heap, UINT index, uint64_t fenceValue = 0);
+
+    /// <summary>
+    /// Runs release once the GPU has passed fenceValue (e.g. handing upload pages back to a pool).
+    /// </summary>
+    void ReleaseDeferred(std::function<void()> release, uint64_t fenceValue = 0);
+
+    /// <summary>
+    /// Releases every retired entry whose fence has completed. Called on each submission and
+    /// after a flush, so callers normally do not need to call it themselves.
+    /// </summary>
+    void ProcessDeferredReleases();
+
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue> GetD3D12CommandQueue() const;
+protected:
+
+    Microsoft::WRL::ComPtr<ID3D12CommandAllocator> CreateCommandAllocator();
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> CreateCommandList(Microsoft::WRL::ComPtr<ID3D12CommandAllocator> allocator);
+
+private:
+    // Keep track of command allocators that are "in-flight"
+    struct CommandAllocatorEntry
+    {
+        uint64_t fenceValue;
+        Microsoft::WRL::ComPtr<ID3D12CommandAllocator> commandAllocator;
+    };
+
+    // Something retired by the CPU that the GPU may still be reading until fenceValue completes
+    struct DeferredRelease
+    {
+        uint64_t fenceValue;
+        Microsoft::WRL::ComPtr<ID3D12Pageable> resource;
+        std::shared_ptr<DescriptorHeap> descriptorHeap;
+        UINT descriptorIndex;
+        std::function<void()> release;
+    };
+
+    void RetireDeferred(DeferredRelease&& entry, uint64_t fenceValue);
+
+    // Hands an executed command list and its allocator back to the pools
+    void RetireCommandList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, uint64_t fenceValue);
+
+    using CommandAllocatorQueue = std::queue<CommandAllocatorEntry>;
+    using CommandListQueue = std::queue< Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> >;
+
+    D3D12_COMMAND_LIST_TYPE                     m_CommandListType;
+    Microsoft::WRL::ComPtr<ID3D12Device2>       m_d3d12Device;
+    Microsoft::WRL::ComPtr<ID3D12CommandQueue>  m_d3d12CommandQueue;
+    Microsoft::WRL::ComPtr<ID3D12Fence>         m_d3d12Fence;
+    HANDLE                                      m_FenceEvent;
+    // Atomic so threads retiring resources can read it while the render thread signals
+    std::atomic<uint64_t>                       m_FenceValue;
+
+    // Guards the pools and the trackers, for threads getting and executing lists at the same time
+    std::mutex                                  m_CommandListMutex;
+    CommandAllocatorQueue                       m_CommandAllocatorQueue;
+    CommandListQueue                            m_CommandListQueue;
+
+    // One per command list this queue has created; lists are pooled, never destroyed
+    std::unordered_map<ID3D12GraphicsCommandList2*, std::unique_ptr<ResourceStateTracker>> m_ResourceStateTrackers;
+
+    // Scratch of ExecuteCommandLists, kept so submitting does not allocate; guarded by the global
+    // resource state lock it is used under
+    std::vector<Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>> m_PendingCommandLists;
+    std::vector<ID3D12CommandList*>             m_SubmittedCommandLists;
+
+    // Retired in fence order, so only the front ever needs checking
+    std::mutex                                  m_DeferredReleaseMutex;
+    std::deque<DeferredRelease>                 m_DeferredReleases;
 };
\ No newline at end of file
@@ -1,108 +1,155 @@
-struct Mat
-{
-    matrix ModelMatrix;
-    matrix ModelViewMatrix;
-    matrix InverseTransposeModelViewMatrix;
-    matrix ModelViewProjectionMatrix;
-};
-
-cbuffer MatCB : register(b4)
-{
-    Mat Matrices;
-}
-
-cbuffer ChunkOffset : register(b5)
-{
-    float4 chunkOffset;
-}
-
-Texture2D<float4> heightmap : register(t8);
-
-SamplerState hmsampler : register(s0);
-
-struct DS_OUTPUT
-{
-    float4 pos : SV_POSITION;
-    float4 WorldPos : POSITION1;
-    float4 ShadowPos : POSITION2;
-    float4 norm : NORMAL;
-    float2 UV : TEXCOORD;
-    float3 FragPos : COLOR0;
-};
- 
-// Output control point
-struct HS_CONTROL_POINT_OUTPUT
-{
-    float4 pos : POSITION0;
-    float4 norm : NORMAL;
-    float2 UV : TEXCOORD;
-    float3 FragPos : COLOR0;
-};
- 
-// Output patch constant data.
-struct HS_CONSTANT_DATA_OUTPUT
-{
-    float EdgeTessFactor[4]         : SV_TessFactor; // e.g. would be [4] for a quad domain
-    float InsideTessFactor[2]          : SV_InsideTessFactor; // e.g. would be Inside[2] for a quad domain
-};
- 
-#define NUM_CONTROL_POINTS 4
- 
-[domain("quad")]
-DS_OUTPUT main(
-    HS_CONSTANT_DATA_OUTPUT input,
-    float2 domain : SV_DomainLocation,
-    const OutputPatch<HS_CONTROL_POINT_OUTPUT, NUM_CONTROL_POINTS> patch)
-{
-    DS_OUTPUT output;
-
-    float2 bottomUV = lerp(patch[0].UV, patch[1].UV, domain.x);
-    float2 topUV    = lerp(patch[2].UV, patch[3].UV, domain.x);
-    float2 interpolatedUV = lerp(bottomUV, topUV, domain.y);
-
-    // ***changed from barycentric to (u,v) coordinates. Now need to use bilinear interpolation to find the new points.
-    float4 bottom = lerp(patch[0].pos, patch[1].pos, domain.x);
-    float4 top    = lerp(patch[2].pos, patch[3].pos, domain.x);
-    float4 interpolatedWorldPos = lerp(bottom, top, domain.y);
-
-    // Remove hardcoded values
-    float scale = 1020.0f / 4.0f;
-
-    float2 worldUV = (interpolatedWorldPos.xz - (chunkOffset.xy * 1020)) / 1020;
-    //float2 worldUV = (interpolatedWorldPos.xz - chunkOffset.xy) / chunkOffset.zw;
-
-    // Sample from the chunks local heightmap texture
-    float displacement = heightmap.SampleLevel(hmsampler, worldUV, 0.0).r;
-
-    // Apply height
-    interpolatedWorldPos.y += displacement * scale;
-    
-    output.WorldPos = interpolatedWorldPos;
-     
-    output.pos = output.WorldPos;
-    output.pos = mul(Matrices.ModelViewProjectionMatrix, output.pos);
-
-    float4 shadowPos = mul(output.WorldPos, Matrices.ModelMatrix);
-    output.ShadowPos = float4(shadowPos.xyz, 1);
-
-    output.FragPos = mul( Matrices.ModelViewMatrix, interpolatedWorldPos);
-
-    // Normal calculation
-    float2 localUV = worldUV;
-    float eps = 1.0 / 1020; // texel step
-    float hC = displacement;
-    float hL = heightmap.SampleLevel(hmsampler, localUV + float2(-eps,0), 0).r;
-    float hR = heightmap.SampleLevel(hmsampler, localUV + float2(eps,0), 0).r;
-    float hD = heightmap.SampleLevel(hmsampler, localUV + float2(0,-eps), 0).r;
-    float hU = heightmap.SampleLevel(hmsampler, localUV + float2(0,eps), 0).r;
-    // convert these to world units if needed: e.g. (hR - hL)*heightScale, etc.
-    float3 tangent = float3(2.0/1020 * 1020, (hR - hL)*1020, 0);
-    float3 bitangent = float3(0, (hU - hD)*255, 2.0/1020 * 1020);
-    float3 normal = normalize(cross(bitangent, tangent));
-
-    output.norm = float4(normal, 1);
-    //output.norm = lerp(lerp(patch[0].norm, patch[1].norm, domain.x), lerp(patch[2].norm, patch[3].norm, domain.x), domain.y);
-    output.UV = worldUV;
-
-    return output;
+struct Mat
+{
+    matrix ModelMatrix;
+    matrix ModelViewMatrix;
+    matrix InverseTransposeModelViewMatrix;
+    matrix ModelViewProjectionMatrix;
+};
+
+cbuffer MatCB : register(b4)
+{
+    Mat Matrices;
+}
+
+cbuffer ChunkOffset : register(b5)
+{
+    float4 chunkOffset;
+    float4 heightRange; // x = min, y = max normalized height of this chunk,
+                        // z = seam bitmask as a float (TerrainSide: 1 -X, 2 +X, 4 -Z, 8 +Z), w unused
+    float4 heightmapSlice; // x = this chunk's slice, y = texels per slice side
+}
+
+Texture2DArray<float> heightmap : register(t8);
+Texture2DArray<float2> normalmap : register(t9); // Octahedral RG8, baked per chunk on the CPU
+
+SamplerState hmsampler : register(s0);
+
+// The heightmap stores each chunk's own [min, max] range at full 16-bit precision
+float SampleHeight(float2 uv)
+{
+    return lerp(heightRange.x, heightRange.y, heightmap.SampleLevel(hmsampler, float3(uv, heightmapSlice.x), 0.0));
+}
+
+// Inverse of PixelConversion::BakeNormalsOctahedral (R = x, G = z, +y up)
+float3 DecodeOctahedralNormal(float2 encoded)
+{
+    float2 f = encoded * 2.0 - 1.0;
+    float3 n = float3(f.x, 1.0 - abs(f.x) - abs(f.y), f.y);
+    float t = saturate(-n.y);
+    n.x += n.x >= 0.0 ? -t : t;
+    n.z += n.z >= 0.0 ? -t : t;
+    return normalize(n);
+}
+
+struct DS_OUTPUT
+{
+    float4 pos : SV_POSITION;
+    float4 WorldPos : POSITION1;
+    float4 ShadowPos : POSITION2;
+    float4 norm : NORMAL;
+    float2 UV : TEXCOORD;
+    float3 FragPos : COLOR0;
+};
+ 
+// Output control point
+struct HS_CONTROL_POINT_OUTPUT
+{
+    float4 pos : POSITION0;
+    float4 norm : NORMAL;
+    float2 UV : TEXCOORD;
+    float3 FragPos : COLOR0;
+    float Height : HEIGHT;
+};
+ 
+// Output patch constant data.
+struct HS_CONSTANT_DATA_OUTPUT
+{
+    float EdgeTessFactor[4]         : SV_TessFactor; // e.g. would be [4] for a quad domain
+    float InsideTessFactor[2]          : SV_InsideTessFactor; // e.g. would be Inside[2] for a quad domain
+};
+ 
+#define NUM_CONTROL_POINTS 4
+
+// Chunk edges that border another LOD tier (heightRange.z, bits -X, +X, -Z, +Z) take their
+// height straight from the control points at the ends of the patch edge. The chunk on the other
+// side has the same points with the same heights, while its heightmap has another resolution.
+// corners[i] = (x, z, height) of control point i.
+bool SeamHeight(float3 corners[NUM_CONTROL_POINTS], float2 domain, out float height)
+{
+    uint seams = (uint)heightRange.z;
+    float2 chunkMin = chunkOffset.xy * chunkOffset.z;
+    float2 chunkMax = chunkMin + chunkOffset.z;
+    height = 0.0f;
+
+    if ((seams & 1) && domain.x == 0.0f && corners[0].x == chunkMin.x && corners[2].x == chunkMin.x)
+        height = lerp(corners[0].z, corners[2].z, domain.y);
+    else if ((seams & 2) && domain.x == 1.0f && corners[1].x == chunkMax.x && corners[3].x == chunkMax.x)
+        height = lerp(corners[1].z, corners[3].z, domain.y);
+    else if ((seams & 4) && domain.y == 0.0f && corners[0].y == chunkMin.y && corners[1].y == chunkMin.y)
+        height = lerp(corners[0].z, corners[1].z, domain.x);
+    else if ((seams & 8) && domain.y == 1.0f && corners[2].y == chunkMax.y && corners[3].y == chunkMax.y)
+        height = lerp(corners[2].z, corners[3].z, domain.x);
+    else
+        return false;
+    return true;
+}
+ 
+[domain("quad")]
+DS_OUTPUT main(
+    HS_CONSTANT_DATA_OUTPUT input,
+    float2 domain : SV_DomainLocation,
+    const OutputPatch<HS_CONTROL_POINT_OUTPUT, NUM_CONTROL_POINTS> patch)
+{
+    DS_OUTPUT output;
+
+    float2 bottomUV = lerp(patch[0].UV, patch[1].UV, domain.x);
+    float2 topUV    = lerp(patch[2].UV, patch[3].UV, domain.x);
+    float2 interpolatedUV = lerp(bottomUV, topUV, domain.y);
+
+    // ***changed from barycentric to (u,v) coordinates. Now need to use bilinear interpolation to find the new points.
+    float4 bottom = lerp(patch[0].pos, patch[1].pos, domain.x);
+    float4 top    = lerp(patch[2].pos, patch[3].pos, domain.x);
+    float4 interpolatedWorldPos = lerp(bottom, top, domain.y);
+
+    // Remove hardcoded values
+    float scale = 1020.0f / 4.0f;
+
+    float2 worldUV = (interpolatedWorldPos.xz - (chunkOffset.xy * chunkOffset.z)) / chunkOffset.z;
+    //float2 worldUV = (interpolatedWorldPos.xz - chunkOffset.xy) / chunkOffset.zw;
+
+    // Texel i sits on vertex i, whatever the heightmap's resolution (chunkOffset.w texels, in the
+    // top-left of the slice)
+    float2 heightmapUV = (worldUV * (chunkOffset.w - 1.0f) + 0.5f) / heightmapSlice.y;
+
+    float3 corners[NUM_CONTROL_POINTS];
+    [unroll]
+    for (int i = 0; i < NUM_CONTROL_POINTS; ++i)
+        corners[i] = float3(patch[i].pos.x, patch[i].pos.z, patch[i].Height);
+
+    // Sample from the chunks local heightmap texture, except on seams between LOD tiers
+    float displacement;
+    if (!SeamHeight(corners, domain, displacement))
+        displacement = SampleHeight(heightmapUV);
+
+    // Apply height
+    interpolatedWorldPos.y += displacement * scale;
+    
+    output.WorldPos = interpolatedWorldPos;
+     
+    output.pos = output.WorldPos;
+    output.pos = mul(Matrices.ModelViewProjectionMatrix, output.pos);
+
+    float4 shadowPos = mul(output.WorldPos, Matrices.ModelMatrix);
+    output.ShadowPos = float4(shadowPos.xyz, 1);
+
+    output.FragPos = mul( Matrices.ModelViewMatrix, interpolatedWorldPos);
+
+    // Normal of the displaced surface, baked with the heightmap
+    float3 normal = DecodeOctahedralNormal(normalmap.SampleLevel(hmsampler, float3(heightmapUV, heightmapSlice.x), 0.0));
+
+    output.norm = float4(normal, 1);
+    //output.norm = lerp(lerp(patch[0].norm, patch[1].norm, domain.x), lerp(patch[2].norm, patch[3].norm, domain.x), domain.y);
+    output.UV = worldUV;
+
+    return output;
 }
\ No newline at end of file
@@ -1,95 +1,95 @@
-#include "Application.h"
-#include "Game.h"
-#include "Window.h"
-
-#include <cassert>
-#include <DirectXMath.h>
-
-Game::Game(const std::wstring& name, int width, int height, bool vSync)
-    : m_Name(name)
-    , m_Width(width)
-    , m_Height(height)
-    , m_vSync(vSync)
-{
-}
-
-Game::~Game()
-{
-    assert(!m_pWindow && "Use Game::Destroy() before destruction.");
-}
-
-bool Game::Initialize()
-{
-    // Check for DirectX Math library support.
-    if (!DirectX::XMVerifyCPUSupport())
-    {
-        MessageBoxA(NULL, "Failed to verify DirectX Math library support.", "Error", MB_OK | MB_ICONERROR);
-        return false;
-    }
-
-    m_pWindow = Application::Get().CreateRenderWindow(m_Name, m_Width, m_Height, m_vSync);
-    m_pWindow->RegisterCallbacks(shared_from_this());
-    m_pWindow->Show();
-
-    return true;
-}
-
-void Game::Destroy()
-{
-    Application::Get().DestroyWindow(m_pWindow);
-    m_pWindow.reset();
-}
-
-void Game::OnUpdate(UpdateEventArgs& e)
-{
-
-}
-
-void Game::OnRender(RenderEventArgs& e)
-{
-
-}
-
-void Game::OnKeyPressed(KeyEventArgs& e)
-{
-    // By default, do nothing.
-}
-
-void Game::OnKeyReleased(KeyEventArgs& e)
-{
-    // By default, do nothing.
-}
-
-void Game::OnMouseMoved(class MouseMotionEventArgs& e)
-{
-    // By default, do nothing.
-}
-
-void Game::OnMouseButtonPressed(MouseButtonEventArgs& e)
-{
-    // By default, do nothing.
-}
-
-void Game::OnMouseButtonReleased(MouseButtonEventArgs& e)
-{
-    // By default, do nothing.
-}
-
-void Game::OnMouseWheel(MouseWheelEventArgs& e)
-{
-    // By default, do nothing.
-}
-
-void Game::OnResize(ResizeEventArgs& e)
-{
-    m_Width = e.Width;
-    m_Height = e.Height;
-}
-
-void Game::OnWindowDestroy()
-{
-    // If the Window which we are registered to is 
-    // destroyed, then any resources which are associated 
-    // to the window must be released.
-    UnloadContent();
+#include "Application.h"
+#include "Game.h"
+#include "Window.h"
+
+#include <cassert>
+#include <DirectXMath.h>
+
+Game::Game(const std::wstring& name, int width, int height, bool vSync)
+    : m_Name(name)
+    , m_Width(width)
+    , m_Height(height)
+    , m_vSync(vSync)
+{
+}
+
+Game::~Game()
+{
+    assert(!m_pWindow && "Use Game::Destroy() before destruction.");
+}
+
+bool Game::Initialize()
+{
+    // Check for DirectX Math library support.
+    if (!DirectX::XMVerifyCPUSupport())
+    {
+        MessageBoxA(NULL, "Failed to verify DirectX Math library support.", "Error", MB_OK | MB_ICONERROR);
+        return false;
+    }
+
+    m_pWindow = Application::Get().CreateRenderWindow(m_Name, m_Width, m_Height, m_vSync);
+    m_pWindow->RegisterCallbacks(shared_from_this());
+    m_pWindow->Show();
+
+    return true;
+}
+
+void Game::Destroy()
+{
+    Application::Get().DestroyWindow(m_pWindow);
+    m_pWindow.reset();
+}
+
+void Game::OnUpdate(UpdateEventArgs& e)
+{
+
+}
+
+void Game::OnRender(RenderEventArgs& e)
+{
+
+}
+
+void Game::OnKeyPressed(KeyEventArgs& e)
+{
+    // By default, do nothing.
+}
+
+void Game::OnKeyReleased(KeyEventArgs& e)
+{
+    // By default, do nothing.
+}
+
+void Game::OnMouseMoved(class MouseMotionEventArgs& e)
+{
+    // By default, do nothing.
+}
+
+void Game::OnMouseButtonPressed(MouseButtonEventArgs& e)
+{
+    // By default, do nothing.
+}
+
+void Game::OnMouseButtonReleased(MouseButtonEventArgs& e)
+{
+    // By default, do nothing.
+}
+
+void Game::OnMouseWheel(MouseWheelEventArgs& e)
+{
+    // By default, do nothing.
+}
+
+void Game::OnResize(ResizeEventArgs& e)
+{
+    m_Width = e.Width;
+    m_Height = e.Height;
+}
+
+void Game::OnWindowDestroy()
+{
+    // If the Window which we are registered to is 
+    // destroyed, then any resources which are associated 
+    // to the window must be released.
+    UnloadContent();
 }
\ No newline at end of file
@@ -1 +1 @@
-#include "Material.h"
+#include "Material.h"
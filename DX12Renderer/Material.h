@@ -1,10 +1,10 @@
-#pragma once
-
-class Material
-{
-	bool m_usePBR = false;
-	bool m_useSpecular = false;
-	bool m_useDiffuse = false;
-	float m_roughness = 1.0f;
-	bool m_dummy = false;
+#pragma once
+
+class Material
+{
+	bool m_usePBR = false;
+	bool m_useSpecular = false;
+	bool m_useDiffuse = false;
+	float m_roughness = 1.0f;
+	bool m_dummy = false;
 };
\ No newline at end of file
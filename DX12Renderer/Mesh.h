@@ -1,91 +1,147 @@
-#pragma once
-#include "Material.h"
-#include "Vertex.h"
-
-#include <DirectXMath.h>
-#include <vector>
-#include <unordered_map>
-#include <string>
-#include <d3d12.h>
-#include <memory>
-#include <wrl.h>
-
-using namespace DirectX;
-
-class Texture;
-
-struct VertexPosColor
-{
-	VertexPosColor() = default;
-	VertexPosColor(float px, float py, float pz,
-		float nx, float ny, float nz,
-		float u, float v) :
-		Position(px, py, pz),
-		Normal(nx, ny, nz),
-		TexCoord(u, v) {}
-
-	void SetPosition(const DirectX::XMFLOAT3& position)
-	{
-		Position = position;
-	}
-	void SetNormal(const DirectX::XMFLOAT3& normal)
-	{
-		Normal = normal;
-	}
-	void SetTexCoord(const DirectX::XMFLOAT2& texCoord)
-	{
-		TexCoord = texCoord;
-	}
-
-	DirectX::XMFLOAT3 Position;
-	DirectX::XMFLOAT3 Normal;
-	DirectX::XMFLOAT2 TexCoord;
-};
-
-struct BufferData
-{
-	Microsoft::WRL::ComPtr<ID3D12Resource> m_bufferResource;
-	D3D12_VERTEX_BUFFER_VIEW m_vertexView{};
-	D3D12_INDEX_BUFFER_VIEW m_indexView{};
-};
-
-class Mesh
-{
-public:
-	void CreateBuffers();
-
-	void AddVertexData(const std::vector<VertexPosColor>& vertexList);
-	void AddVertexData(const std::vector<VertexPosition>& m_vertexListPosition);
-	void AddIndexData(const std::vector<UINT>& indexList);
-	void AddTextureData(const std::unordered_map<std::string, Texture*>& textureList);
-	void AddMaterial(const Material& material);
-
-	std::vector<VertexPosColor>& GetVertexList() { return m_vertexList; }
-	std::vector<UINT>& GetIndexList() { return m_indexList; }
-	std::unordered_map<std::string, Texture*>& GetTextureList() { return m_textureList; }
-	std::vector<VertexPosColor> GetVertexList() const { return m_vertexList; }
-	std::vector<UINT> GetIndexList() const { return m_indexList; }
-	std::unordered_map<std::string, Texture*> GetTextureList() const { return m_textureList; }
-	Material& GetMaterial() { return m_material; }
-	void* GetVertexBuffer();
-	void* GetIndexBuffer();
-
-	void Draw(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, D3D_PRIMITIVE_TOPOLOGY topologyType);
-
-	void Shutdown();
-private:
-	void CreateVertexBuffer();
-	void CreateIndexBuffer();
-	void CreateTexturesBuffer();
-
-	std::vector<VertexPosColor> m_vertexList;
-	std::vector<VertexPosition> m_vertexListPosition;
-	std::vector<UINT> m_indexList;
-	std::unordered_map<std::string, Texture*> m_textureList;
-
-	Material m_material;
-
-	std::shared_ptr<BufferData> m_vertexBuffer = nullptr;
-	std::shared_ptr<BufferData> m_indexBuffer = nullptr;
-};
-
+#pragma once
+#include "Material.h"
+#include "Vertex.h"
+
+#include <DirectXMath.h>
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <d3d12.h>
+#include <memory>
+#include <span>
+#include <wrl.h>
+
+using namespace DirectX;
+
+class Texture;
+
+struct VertexPosColor
+{
+	VertexPosColor() = default;
+	VertexPosColor(float px, float py, float pz,
+		float nx, float ny, float nz,
+		float u, float v) :
+		Position(px, py, pz),
+		Normal(nx, ny, nz),
+		TexCoord(u, v) {}
+
+	void SetPosition(const DirectX::XMFLOAT3& position)
+	{
+		Position = position;
+	}
+	void SetNormal(const DirectX::XMFLOAT3& normal)
+	{
+		Normal = normal;
+	}
+	void SetTexCoord(const DirectX::XMFLOAT2& texCoord)
+	{
+		TexCoord = texCoord;
+	}
+
+	DirectX::XMFLOAT3 Position;
+	DirectX::XMFLOAT3 Normal;
+	DirectX::XMFLOAT2 TexCoord;
+};
+
+struct BufferData
+{
+	BufferData() = default;
+
+	// A GPU buffer has exactly one owner; meshes share it through std::shared_ptr instead of copying.
+	BufferData(const BufferData&) = delete;
+	BufferData& operator=(const BufferData&) = delete;
+	BufferData(BufferData&&) = default;
+	BufferData& operator=(BufferData&&) = default;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> m_bufferResource;
+	D3D12_VERTEX_BUFFER_VIEW m_vertexView{};
+	D3D12_INDEX_BUFFER_VIEW m_indexView{};
+};
+
+/// <summary>
+/// A contiguous run of indices to draw, for meshes whose index order groups related
+/// primitives together (e.g. culled terrain patches).
+/// </summary>
+struct IndexRange
+{
+	UINT startIndex;
+	UINT indexCount;
+};
+
+/// <summary>
+/// CPU copy of a mesh's geometry. Shared by every copy of a Mesh (copy-on-write through the
+/// non-const getters), so copying a Mesh only bumps reference counts.
+/// </summary>
+struct MeshGeometry
+{
+	std::vector<VertexPosColor> m_vertexList;
+	std::vector<VertexPosition> m_vertexListPosition;
+	std::vector<UINT> m_indexList;
+};
+
+/// <summary>
+/// Cheap handle over shared geometry, textures and GPU buffers. Copies are shallow.
+/// </summary>
+class Mesh
+{
+public:
+	using TextureMap = std::unordered_map<std::string, Texture*>;
+
+	void CreateBuffers();
+
+	void AddVertexData(const std::vector<VertexPosColor>& vertexList);
+	void AddVertexData(const std::vector<VertexPosition>& m_vertexListPosition);
+	void AddVertexData(std::vector<VertexPosition>&& m_vertexListPosition);
+	void AddIndexData(const std::vector<UINT>& indexList);
+	// Draw with an index buffer owned elsewhere (e.g. one shared by many meshes) instead of
+	// creating one from AddIndexData.
+	void SetSharedIndexBuffer(std::shared_ptr<BufferData> indexBuffer, UINT indexCount);
+	// Draw from a vertex buffer owned elsewhere (e.g. a pooled one that is rewritten in place)
+	// instead of creating one from AddVertexData. Shutdown leaves it to its other owners.
+	void SetSharedVertexBuffer(std::shared_ptr<BufferData> vertexBuffer);
+	void AddTextureData(const TextureMap& textureList);
+	void AddMaterial(const Material& material);
+
+	/// <summary>
+	/// Drop the CPU copy of the geometry once it is on the GPU. Draw only needs the buffers.
+	/// </summary>
+	void ReleaseCPUData();
+
+	std::vector<VertexPosColor>& GetVertexList() { return EditGeometry().m_vertexList; }
+	std::vector<UINT>& GetIndexList() { return EditGeometry().m_indexList; }
+	TextureMap& GetTextureList() { return EditTextures(); }
+	std::span<const VertexPosColor> GetVertexList() const;
+	std::span<const UINT> GetIndexList() const;
+	const TextureMap& GetTextureList() const;
+	// Returns nullptr when the mesh has no texture with that name.
+	Texture* GetTexture(const std::string& name) const;
+	UINT GetIndexCount() const { return m_indexCount; }
+	Material& GetMaterial() { return m_material; }
+	void* GetVertexBuffer();
+	void* GetIndexBuffer();
+
+	void Draw(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, D3D_PRIMITIVE_TOPOLOGY topologyType) const;
+	/// <summary>
+	/// Binds the buffers once and issues one draw per range.
+	/// </summary>
+	void Draw(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, D3D_PRIMITIVE_TOPOLOGY topologyType, std::span<const IndexRange> ranges) const;
+
+	void Shutdown();
+private:
+	void CreateVertexBuffer();
+	void CreateIndexBuffer();
+	void CreateTexturesBuffer();
+
+	// Unshare before modifying, so other copies of this mesh are not affected.
+	MeshGeometry& EditGeometry();
+	TextureMap& EditTextures();
+
+	std::shared_ptr<MeshGeometry> m_geometry;
+	std::shared_ptr<TextureMap> m_textureList;
+
+	Material m_material;
+
+	std::shared_ptr<BufferData> m_vertexBuffer = nullptr;
+	std::shared_ptr<BufferData> m_indexBuffer = nullptr;
+	UINT m_indexCount = 0;
+};
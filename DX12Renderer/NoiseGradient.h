@@ -0,0 +1,184 @@
+#pragma once
+
+#include "SimdLanes.h"
+
+/// <summary>
+/// Value-and-gradient companion to FastNoiseLite's 2D Perlin noise (NoiseType_Perlin,
+/// FractalType_None). The value is bit-identical to FastNoiseLite::GetNoise under /fp:precise;
+/// the gradient is the exact derivative of that value with respect to the input coordinates
+/// (frequency included), so callers no longer need extra samples at x+eps / y+eps.
+///
+/// Kernels are templated on the Simd lane types, so the same code runs for 1, 4 or 8 samples.
+/// </summary>
+namespace NoiseGradient
+{
+    // FastNoiseLite::Lookup<float>::Gradients2D (private in FastNoiseLite, so copied verbatim).
+    alignas(32) inline const float Gradients2D[256] =
+    {
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.130526192220052f, 0.99144486137381f, 0.38268343236509f, 0.923879532511287f, 0.608761429008721f, 0.793353340291235f, 0.793353340291235f, 0.608761429008721f,
+        0.923879532511287f, 0.38268343236509f, 0.99144486137381f, 0.130526192220051f, 0.99144486137381f, -0.130526192220051f, 0.923879532511287f, -0.38268343236509f,
+        0.793353340291235f, -0.60876142900872f, 0.608761429008721f, -0.793353340291235f, 0.38268343236509f, -0.923879532511287f, 0.130526192220052f, -0.99144486137381f,
+        -0.130526192220052f, -0.99144486137381f, -0.38268343236509f, -0.923879532511287f, -0.608761429008721f, -0.793353340291235f, -0.793353340291235f, -0.608761429008721f,
+        -0.923879532511287f, -0.38268343236509f, -0.99144486137381f, -0.130526192220052f, -0.99144486137381f, 0.130526192220051f, -0.923879532511287f, 0.38268343236509f,
+        -0.793353340291235f, 0.608761429008721f, -0.608761429008721f, 0.793353340291235f, -0.38268343236509f, 0.923879532511287f, -0.130526192220052f, 0.99144486137381f,
+        0.38268343236509f, 0.923879532511287f, 0.923879532511287f, 0.38268343236509f, 0.923879532511287f, -0.38268343236509f, 0.38268343236509f, -0.923879532511287f,
+        -0.38268343236509f, -0.923879532511287f, -0.923879532511287f, -0.38268343236509f, -0.923879532511287f, 0.38268343236509f, -0.38268343236509f, 0.923879532511287f,
+    };
+
+    constexpr int32_t PrimeX = 501125321;
+    constexpr int32_t PrimeY = 1136930381;
+
+    template <class L>
+    struct Sample
+    {
+        typename L::F value;
+        typename L::F dx;
+        typename L::F dy;
+    };
+
+    namespace Detail
+    {
+        template <class L>
+        inline typename L::I GradIndex(typename L::I seed, typename L::I xPrimed, typename L::I yPrimed)
+        {
+            auto hash = (seed ^ xPrimed ^ yPrimed) * L::SetI(0x27d4eb2d);
+            hash = hash ^ Simd::ShiftRightArithmetic<15>(hash);
+            return hash & L::SetI(127 << 1);
+        }
+
+        template <class L>
+        inline typename L::F InterpQuintic(typename L::F t)
+        {
+            return t * t * t * (t * (t * L::Set(6.0f) - L::Set(15.0f)) + L::Set(10.0f));
+        }
+
+        // d/dt of InterpQuintic: 30 t^2 (t - 1)^2
+        template <class L>
+        inline typename L::F InterpQuinticDerivative(typename L::F t)
+        {
+            auto tm1 = t - L::Set(1.0f);
+            return L::Set(30.0f) * t * t * tm1 * tm1;
+        }
+
+        template <class L>
+        inline typename L::F Lerp(typename L::F a, typename L::F b, typename L::F t)
+        {
+            return a + t * (b - a);
+        }
+    }
+
+    /// <summary>
+    /// FastNoiseLite::SinglePerlin after TransformNoiseCoordinate, plus its analytic gradient.
+    /// </summary>
+    template <class L, bool WithGradient = true>
+    inline Sample<L> PerlinSample(int seed, float frequency, typename L::F x, typename L::F y)
+    {
+        using F = typename L::F;
+        using I = typename L::I;
+        using namespace Detail;
+
+        x = x * L::Set(frequency);
+        y = y * L::Set(frequency);
+
+        I x0 = Simd::FastFloor(x);
+        I y0 = Simd::FastFloor(y);
+
+        F xd0 = x - Simd::ToFloat(x0);
+        F yd0 = y - Simd::ToFloat(y0);
+        F xd1 = xd0 - L::Set(1.0f);
+        F yd1 = yd0 - L::Set(1.0f);
+
+        F xs = InterpQuintic<L>(xd0);
+        F ys = InterpQuintic<L>(yd0);
+
+        x0 = x0 * L::SetI(PrimeX);
+        y0 = y0 * L::SetI(PrimeY);
+        I x1 = x0 + L::SetI(PrimeX);
+        I y1 = y0 + L::SetI(PrimeY);
+
+        const I vseed = L::SetI(seed);
+        const I h00 = GradIndex<L>(vseed, x0, y0);
+        const I h10 = GradIndex<L>(vseed, x1, y0);
+        const I h01 = GradIndex<L>(vseed, x0, y1);
+        const I h11 = GradIndex<L>(vseed, x1, y1);
+        const I one = L::SetI(1);
+
+        F gx00 = Simd::Gather(Gradients2D, h00), gy00 = Simd::Gather(Gradients2D, h00 | one);
+        F gx10 = Simd::Gather(Gradients2D, h10), gy10 = Simd::Gather(Gradients2D, h10 | one);
+        F gx01 = Simd::Gather(Gradients2D, h01), gy01 = Simd::Gather(Gradients2D, h01 | one);
+        F gx11 = Simd::Gather(Gradients2D, h11), gy11 = Simd::Gather(Gradients2D, h11 | one);
+
+        F v00 = xd0 * gx00 + yd0 * gy00;
+        F v10 = xd1 * gx10 + yd0 * gy10;
+        F v01 = xd0 * gx01 + yd1 * gy01;
+        F v11 = xd1 * gx11 + yd1 * gy11;
+
+        F xf0 = Lerp<L>(v00, v10, xs);
+        F xf1 = Lerp<L>(v01, v11, xs);
+
+        const F scale = L::Set(1.4247691104677813f);
+        Sample<L> result;
+        result.value = Lerp<L>(xf0, xf1, ys) * scale;
+
+        if constexpr (WithGradient) {
+            F dxs = InterpQuinticDerivative<L>(xd0);
+            F dys = InterpQuinticDerivative<L>(yd0);
+
+            // Each corner contributes dot(gradient, offset), whose derivative is the gradient itself.
+            F dxf0_dx = Lerp<L>(gx00, gx10, xs) + dxs * (v10 - v00);
+            F dxf1_dx = Lerp<L>(gx01, gx11, xs) + dxs * (v11 - v01);
+            F dxf0_dy = Lerp<L>(gy00, gy10, xs);
+            F dxf1_dy = Lerp<L>(gy01, gy11, xs);
+
+            // Chain rule through TransformNoiseCoordinate (x * frequency).
+            const F outer = scale * L::Set(frequency);
+            result.dx = Lerp<L>(dxf0_dx, dxf1_dx, ys) * outer;
+            result.dy = (Lerp<L>(dxf0_dy, dxf1_dy, ys) + dys * (xf1 - xf0)) * outer;
+        }
+        return result;
+    }
+
+    template <class L>
+    inline typename L::F Perlin(int seed, float frequency, typename L::F x, typename L::F y)
+    {
+        return PerlinSample<L, false>(seed, frequency, x, y).value;
+    }
+
+    // Scalar convenience overloads.
+    inline float Perlin(int seed, float frequency, float x, float y)
+    {
+        return Perlin<Simd::ScalarLanes>(seed, frequency, x, y);
+    }
+
+    inline float PerlinWithGradient(int seed, float frequency, float x, float y, float& dx, float& dy)
+    {
+        Sample<Simd::ScalarLanes> s = PerlinSample<Simd::ScalarLanes>(seed, frequency, x, y);
+        dx = s.dx;
+        dy = s.dy;
+        return s.value;
+    }
+}
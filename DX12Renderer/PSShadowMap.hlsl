@@ -1,9 +1,9 @@
-struct PixelShaderInput
-{
-	float4 PosH : SV_Position;
-};
-
-void main(PixelShaderInput IN)
-{
-    //return float4(1, 1, 1, 1); // Depth-only
+struct PixelShaderInput
+{
+	float4 PosH : SV_Position;
+};
+
+void main(PixelShaderInput IN)
+{
+    //return float4(1, 1, 1, 1); // Depth-only
 }
\ No newline at end of file
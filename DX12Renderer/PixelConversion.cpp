@@ -0,0 +1,380 @@
+#include "PixelConversion.h"
+#include "SimdLanes.h"
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    using Simd::Level;
+
+    // Smallest normal half, 2^-14. Below it halves are denormal: value * 2^24 in the mantissa.
+    constexpr float HalfMinNormal = 6.103515625e-05f;
+    constexpr float HalfDenormalScale = 16777216.0f; // 2^24
+
+    float RangeScale(float rangeMin, float rangeMax)
+    {
+        return rangeMax > rangeMin ? 1.0f / (rangeMax - rangeMin) : 0.0f;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Scalar. Same operation order as the SIMD paths, so every width gives the same bits.
+    ////////////////////////////////////////////////////////////////////////////////
+
+    float Remap01(float x, float rangeMin, float scale)
+    {
+        float t = (x - rangeMin) * scale;
+        t = Simd::Max(t, 0.0f); // NaN becomes 0
+        return Simd::Min(t, 1.0f);
+    }
+
+    uint16_t ToUnorm16(float t)
+    {
+        return uint16_t(std::nearbyint(t * 65535.0f));
+    }
+
+    // Upper-hemisphere octahedral encoding of the unnormalized normal (nx, 1, nz), so there is no
+    // fold to handle. Returns R in the low byte and G in the high byte.
+    uint16_t EncodeOctahedral(float nx, float nz)
+    {
+        float inv = 1.0f / (std::fabs(nx) + 1.0f + std::fabs(nz));
+        float u = (nx * inv) * 0.5f + 0.5f;
+        float v = (nz * inv) * 0.5f + 0.5f;
+        return uint16_t(int(std::nearbyint(u * 255.0f)) | (int(std::nearbyint(v * 255.0f)) << 8));
+    }
+
+    // t is in [0, 1], so there is no sign, infinity or NaN to handle
+    uint16_t ToHalf(float t)
+    {
+        if (t < HalfMinNormal)
+            return uint16_t(std::nearbyint(t * HalfDenormalScale));
+
+        uint32_t bits;
+        std::memcpy(&bits, &t, sizeof(bits));
+        // Rebias the exponent (127 -> 15) and round the mantissa to nearest even
+        return uint16_t((bits - 0x38000000u + 0x0FFFu + ((bits >> 13) & 1u)) >> 13);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // SSE4.1
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __m128 Remap01(__m128 x, __m128 rangeMin, __m128 scale)
+    {
+        __m128 t = _mm_mul_ps(_mm_sub_ps(x, rangeMin), scale);
+        t = _mm_max_ps(t, _mm_setzero_ps()); // Returns the second operand for NaN
+        return _mm_min_ps(t, _mm_set1_ps(1.0f));
+    }
+
+    __m128i ToHalf(__m128 t)
+    {
+        __m128i bits = _mm_castps_si128(t);
+        __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 13), _mm_set1_epi32(1));
+        __m128i normal = _mm_add_epi32(_mm_sub_epi32(bits, _mm_set1_epi32(0x38000000)), _mm_set1_epi32(0x0FFF));
+        normal = _mm_srli_epi32(_mm_add_epi32(normal, odd), 13);
+        __m128i denormal = _mm_cvtps_epi32(_mm_mul_ps(t, _mm_set1_ps(HalfDenormalScale)));
+        __m128 isDenormal = _mm_cmplt_ps(t, _mm_set1_ps(HalfMinNormal));
+        return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(normal), _mm_castsi128_ps(denormal), isDenormal));
+    }
+
+    __m128 Abs(__m128 x)
+    {
+        return _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+    }
+
+    __m128i EncodeOctahedral(__m128 nx, __m128 nz)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 unormMax = _mm_set1_ps(255.0f);
+        __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_add_ps(_mm_add_ps(Abs(nx), _mm_set1_ps(1.0f)), Abs(nz)));
+        __m128 u = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(nx, inv), half), half);
+        __m128 v = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(nz, inv), half), half);
+        __m128i r = _mm_cvtps_epi32(_mm_mul_ps(u, unormMax));
+        __m128i g = _mm_cvtps_epi32(_mm_mul_ps(v, unormMax));
+        return _mm_or_si128(r, _mm_slli_epi32(g, 8));
+    }
+
+    // Interior columns [1, width - 1) of one row; returns the first column left for the scalar path
+    int NormalRowSSE41(const float* row, const float* up, const float* down, int width, float kx, float kz, uint16_t* out)
+    {
+        const __m128 vkx = _mm_set1_ps(kx);
+        const __m128 vkz = _mm_set1_ps(kz);
+        int x = 1;
+        for (; x + 8 <= width - 1; x += 8) {
+            __m128i a = EncodeOctahedral(
+                _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(row + x - 1), _mm_loadu_ps(row + x + 1)), vkx),
+                _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(down + x), _mm_loadu_ps(up + x)), vkz));
+            __m128i b = EncodeOctahedral(
+                _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(row + x + 3), _mm_loadu_ps(row + x + 5)), vkx),
+                _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(down + x + 4), _mm_loadu_ps(up + x + 4)), vkz));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packus_epi32(a, b));
+        }
+        return x;
+    }
+
+    size_t MinMaxSSE41(const float* in, size_t count, float& outMin, float& outMax)
+    {
+        if (count < 4)
+            return 0;
+
+        __m128 vmin = _mm_loadu_ps(in);
+        __m128 vmax = vmin;
+        size_t i = 4;
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_loadu_ps(in + i);
+            vmin = _mm_min_ps(vmin, x);
+            vmax = _mm_max_ps(vmax, x);
+        }
+
+        alignas(16) float mins[4], maxs[4];
+        _mm_store_ps(mins, vmin);
+        _mm_store_ps(maxs, vmax);
+        outMin = Simd::Min(Simd::Min(mins[0], mins[1]), Simd::Min(mins[2], mins[3]));
+        outMax = Simd::Max(Simd::Max(maxs[0], maxs[1]), Simd::Max(maxs[2], maxs[3]));
+        return i;
+    }
+
+    size_t ToUnorm16SSE41(const float* in, uint16_t* out, size_t count, float rangeMin, float scale)
+    {
+        const __m128 vmin = _mm_set1_ps(rangeMin);
+        const __m128 vscale = _mm_set1_ps(scale);
+        const __m128 unormMax = _mm_set1_ps(65535.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i a = _mm_cvtps_epi32(_mm_mul_ps(Remap01(_mm_loadu_ps(in + i), vmin, vscale), unormMax));
+            __m128i b = _mm_cvtps_epi32(_mm_mul_ps(Remap01(_mm_loadu_ps(in + i + 4), vmin, vscale), unormMax));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi32(a, b));
+        }
+        return i;
+    }
+
+    size_t ToHalfSSE41(const float* in, uint16_t* out, size_t count, float rangeMin, float scale)
+    {
+        const __m128 vmin = _mm_set1_ps(rangeMin);
+        const __m128 vscale = _mm_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i a = ToHalf(Remap01(_mm_loadu_ps(in + i), vmin, vscale));
+            __m128i b = ToHalf(Remap01(_mm_loadu_ps(in + i + 4), vmin, vscale));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi32(a, b));
+        }
+        return i;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // AVX2
+    ////////////////////////////////////////////////////////////////////////////////
+
+    __m256 Remap01(__m256 x, __m256 rangeMin, __m256 scale)
+    {
+        __m256 t = _mm256_mul_ps(_mm256_sub_ps(x, rangeMin), scale);
+        t = _mm256_max_ps(t, _mm256_setzero_ps()); // Returns the second operand for NaN
+        return _mm256_min_ps(t, _mm256_set1_ps(1.0f));
+    }
+
+    __m256i ToHalf(__m256 t)
+    {
+        __m256i bits = _mm256_castps_si256(t);
+        __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 13), _mm256_set1_epi32(1));
+        __m256i normal = _mm256_add_epi32(_mm256_sub_epi32(bits, _mm256_set1_epi32(0x38000000)), _mm256_set1_epi32(0x0FFF));
+        normal = _mm256_srli_epi32(_mm256_add_epi32(normal, odd), 13);
+        __m256i denormal = _mm256_cvtps_epi32(_mm256_mul_ps(t, _mm256_set1_ps(HalfDenormalScale)));
+        __m256 isDenormal = _mm256_cmp_ps(t, _mm256_set1_ps(HalfMinNormal), _CMP_LT_OQ);
+        return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(normal), _mm256_castsi256_ps(denormal), isDenormal));
+    }
+
+    // _mm256_packus_epi32 packs within each 128-bit half, so narrow the halves separately
+    void StoreUint16(uint16_t* out, __m256i values)
+    {
+        __m128i packed = _mm_packus_epi32(_mm256_castsi256_si128(values), _mm256_extracti128_si256(values, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), packed);
+    }
+
+    __m256 Abs(__m256 x)
+    {
+        return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+    }
+
+    __m256i EncodeOctahedral(__m256 nx, __m256 nz)
+    {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 unormMax = _mm256_set1_ps(255.0f);
+        __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_add_ps(_mm256_add_ps(Abs(nx), _mm256_set1_ps(1.0f)), Abs(nz)));
+        __m256 u = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(nx, inv), half), half);
+        __m256 v = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(nz, inv), half), half);
+        __m256i r = _mm256_cvtps_epi32(_mm256_mul_ps(u, unormMax));
+        __m256i g = _mm256_cvtps_epi32(_mm256_mul_ps(v, unormMax));
+        return _mm256_or_si256(r, _mm256_slli_epi32(g, 8));
+    }
+
+    int NormalRowAVX2(const float* row, const float* up, const float* down, int width, float kx, float kz, uint16_t* out)
+    {
+        const __m256 vkx = _mm256_set1_ps(kx);
+        const __m256 vkz = _mm256_set1_ps(kz);
+        int x = 1;
+        for (; x + 8 <= width - 1; x += 8) {
+            StoreUint16(out + x, EncodeOctahedral(
+                _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(row + x - 1), _mm256_loadu_ps(row + x + 1)), vkx),
+                _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(down + x), _mm256_loadu_ps(up + x)), vkz)));
+        }
+        return x;
+    }
+
+    size_t MinMaxAVX2(const float* in, size_t count, float& outMin, float& outMax)
+    {
+        if (count < 8)
+            return 0;
+
+        __m256 vmin = _mm256_loadu_ps(in);
+        __m256 vmax = vmin;
+        size_t i = 8;
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_loadu_ps(in + i);
+            vmin = _mm256_min_ps(vmin, x);
+            vmax = _mm256_max_ps(vmax, x);
+        }
+
+        alignas(32) float mins[8], maxs[8];
+        _mm256_store_ps(mins, vmin);
+        _mm256_store_ps(maxs, vmax);
+        outMin = mins[0];
+        outMax = maxs[0];
+        for (int lane = 1; lane < 8; ++lane) {
+            outMin = Simd::Min(outMin, mins[lane]);
+            outMax = Simd::Max(outMax, maxs[lane]);
+        }
+        return i;
+    }
+
+    size_t ToUnorm16AVX2(const float* in, uint16_t* out, size_t count, float rangeMin, float scale)
+    {
+        const __m256 vmin = _mm256_set1_ps(rangeMin);
+        const __m256 vscale = _mm256_set1_ps(scale);
+        const __m256 unormMax = _mm256_set1_ps(65535.0f);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            StoreUint16(out + i, _mm256_cvtps_epi32(_mm256_mul_ps(Remap01(_mm256_loadu_ps(in + i), vmin, vscale), unormMax)));
+        }
+        return i;
+    }
+
+    size_t ToHalfAVX2(const float* in, uint16_t* out, size_t count, float rangeMin, float scale)
+    {
+        const __m256 vmin = _mm256_set1_ps(rangeMin);
+        const __m256 vscale = _mm256_set1_ps(scale);
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            StoreUint16(out + i, ToHalf(Remap01(_mm256_loadu_ps(in + i), vmin, vscale)));
+        }
+        return i;
+    }
+}
+
+void PixelConversion::MinMax(const float* in, size_t count, float& outMin, float& outMax)
+{
+    outMin = 0.0f;
+    outMax = 0.0f;
+    if (count == 0)
+        return;
+
+    size_t i = 0;
+    switch (Simd::GetSupportedLevel()) {
+    case Level::AVX2:
+        i = MinMaxAVX2(in, count, outMin, outMax);
+        break;
+    case Level::SSE41:
+        i = MinMaxSSE41(in, count, outMin, outMax);
+        break;
+    default:
+        break;
+    }
+
+    if (i == 0) {
+        outMin = in[0];
+        outMax = in[0];
+        i = 1;
+    }
+    for (; i < count; ++i) {
+        outMin = Simd::Min(outMin, in[i]);
+        outMax = Simd::Max(outMax, in[i]);
+    }
+}
+
+void PixelConversion::FloatToUnorm16(const float* in, uint16_t* out, size_t count, float rangeMin, float rangeMax)
+{
+    const float scale = RangeScale(rangeMin, rangeMax);
+
+    size_t i = 0;
+    switch (Simd::GetSupportedLevel()) {
+    case Level::AVX2:
+        i = ToUnorm16AVX2(in, out, count, rangeMin, scale);
+        break;
+    case Level::SSE41:
+        i = ToUnorm16SSE41(in, out, count, rangeMin, scale);
+        break;
+    default:
+        break;
+    }
+
+    for (; i < count; ++i)
+        out[i] = ToUnorm16(Remap01(in[i], rangeMin, scale));
+}
+
+void PixelConversion::FloatToHalf(const float* in, uint16_t* out, size_t count, float rangeMin, float rangeMax)
+{
+    const float scale = RangeScale(rangeMin, rangeMax);
+
+    size_t i = 0;
+    switch (Simd::GetSupportedLevel()) {
+    case Level::AVX2:
+        i = ToHalfAVX2(in, out, count, rangeMin, scale);
+        break;
+    case Level::SSE41:
+        i = ToHalfSSE41(in, out, count, rangeMin, scale);
+        break;
+    default:
+        break;
+    }
+
+    for (; i < count; ++i)
+        out[i] = ToHalf(Remap01(in[i], rangeMin, scale));
+}
+
+void PixelConversion::BakeNormalsOctahedral(const float* heights, int width, int height, float heightScale, float texelSpacing, uint8_t* outRG)
+{
+    if (width < 2 || height < 2)
+        return;
+
+    // The normal of the surface y = h * heightScale is (-dh/dx, 1, -dh/dz) before normalizing
+    const float centralK = heightScale / (2.0f * texelSpacing);
+    const float edgeK = heightScale / texelSpacing;
+    const Level level = Simd::GetSupportedLevel();
+
+    for (int z = 0; z < height; ++z) {
+        const float* row = heights + size_t(z) * width;
+        const float* down = heights + size_t(z > 0 ? z - 1 : z) * width;
+        const float* up = heights + size_t(z < height - 1 ? z + 1 : z) * width;
+        const float kz = (z > 0 && z < height - 1) ? centralK : edgeK;
+        // Two bytes per texel, R then G, written as little-endian uint16
+        uint16_t* out = reinterpret_cast<uint16_t*>(outRG) + size_t(z) * width;
+
+        int x = 1;
+        switch (level) {
+        case Level::AVX2:
+            x = NormalRowAVX2(row, up, down, width, centralK, kz, out);
+            break;
+        case Level::SSE41:
+            x = NormalRowSSE41(row, up, down, width, centralK, kz, out);
+            break;
+        default:
+            break;
+        }
+
+        for (; x < width - 1; ++x)
+            out[x] = EncodeOctahedral((row[x - 1] - row[x + 1]) * centralK, (down[x] - up[x]) * kz);
+
+        out[0] = EncodeOctahedral((row[0] - row[1]) * edgeK, (down[0] - up[0]) * kz);
+        out[width - 1] = EncodeOctahedral((row[width - 2] - row[width - 1]) * edgeK, (down[width - 1] - up[width - 1]) * kz);
+    }
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Vectorized conversions from float data to 16-bit texel formats, used to pack heightmaps
+/// and their normals into compact textures. Each function picks the widest instruction set the CPU
+/// supports (see Simd::GetSupportedLevel) and produces the same bits at every width.
+/// </summary>
+namespace PixelConversion
+{
+    /// <summary>
+    /// Smallest and largest value in the array. Both are 0 when count is 0.
+    /// </summary>
+    void MinMax(const float* in, size_t count, float& outMin, float& outMax);
+
+    /// <summary>
+    /// Remaps [rangeMin, rangeMax] onto [0, 1], clamps, and stores DXGI_FORMAT_R16_UNORM texels
+    /// (round to nearest). A degenerate range stores 0 everywhere.
+    /// </summary>
+    void FloatToUnorm16(const float* in, uint16_t* out, size_t count, float rangeMin, float rangeMax);
+
+    /// <summary>
+    /// Remaps [rangeMin, rangeMax] onto [0, 1], clamps, and stores DXGI_FORMAT_R16_FLOAT texels
+    /// (IEEE half, round to nearest even). A degenerate range stores 0 everywhere.
+    /// </summary>
+    void FloatToHalf(const float* in, uint16_t* out, size_t count, float rangeMin, float rangeMax);
+
+    /// <summary>
+    /// Bakes the normals of a row-major height grid into an octahedral-encoded DXGI_FORMAT_R8G8_UNORM
+    /// map (R = x, G = z, +y up; two bytes per texel). Slopes are central differences, one-sided on
+    /// the border. heightScale turns a height difference into world units and texelSpacing is the
+    /// world distance between neighbouring samples. The two channels are laid out the way BC5 expects.
+    /// </summary>
+    void BakeNormalsOctahedral(const float* heights, int width, int height, float heightScale, float texelSpacing, uint8_t* outRG);
+}
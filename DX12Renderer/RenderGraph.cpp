@@ -0,0 +1,375 @@
+#include "RenderGraph.h"
+#include "Helpers.h"
+#include <algorithm>
+#include <cassert>
+#include "d3dx12.h"
+#include "ResourceStateTracker.h"
+#include "CommandQueue.h"
+
+RenderGraph::ResourceHandle RenderGraph::ImportResource(const std::string& name)
+{
+    Resource resource;
+    resource.name = name;
+    m_Resources.push_back(std::move(resource));
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+RenderGraph::ResourceHandle RenderGraph::CreateTransient(const std::string& name, const D3D12_RESOURCE_DESC& desc,
+    const D3D12_CLEAR_VALUE& clearValue, const D3D12_RESOURCE_ALLOCATION_INFO& allocationInfo)
+{
+    Resource resource;
+    resource.name = name;
+    resource.transient = true;
+    resource.desc = desc;
+    resource.clearValue = clearValue;
+    resource.allocationInfo = allocationInfo;
+    m_Resources.push_back(std::move(resource));
+    return static_cast<ResourceHandle>(m_Resources.size() - 1);
+}
+
+void RenderGraph::MarkOutput(ResourceHandle resource, D3D12_RESOURCE_STATES finalState)
+{
+    m_Resources[resource].output = true;
+    m_Resources[resource].finalState = finalState;
+}
+
+RenderGraph::PassHandle RenderGraph::AddPass(const std::string& name, ExecuteFunction execute)
+{
+    Pass pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    m_Passes.push_back(std::move(pass));
+    return static_cast<PassHandle>(m_Passes.size() - 1);
+}
+
+void RenderGraph::Read(PassHandle pass, ResourceHandle resource, D3D12_RESOURCE_STATES state)
+{
+    AddUse(pass, resource, state, true, false);
+}
+
+void RenderGraph::Write(PassHandle pass, ResourceHandle resource, D3D12_RESOURCE_STATES state)
+{
+    AddUse(pass, resource, state, false, true);
+}
+
+void RenderGraph::AddUse(PassHandle pass, ResourceHandle resource, D3D12_RESOURCE_STATES state, bool read, bool write)
+{
+    for (ResourceUse& use : m_Passes[pass].uses)
+    {
+        if (use.resource != resource)
+            continue;
+
+        assert(use.state == state && "A pass uses a resource in one state");
+        use.read |= read;
+        use.write |= write;
+        return;
+    }
+
+    m_Passes[pass].uses.push_back({ resource, state, read, write });
+}
+
+void RenderGraph::Compile()
+{
+    CullPasses();
+
+    // Lifetimes, over the passes that are left
+    for (Resource& resource : m_Resources)
+    {
+        resource.firstPass = InvalidHandle;
+        resource.lastPass = InvalidHandle;
+    }
+    for (uint32_t passIndex = 0; passIndex < m_Passes.size(); ++passIndex)
+    {
+        if (m_Passes[passIndex].culled)
+            continue;
+
+        for (const ResourceUse& use : m_Passes[passIndex].uses)
+        {
+            Resource& resource = m_Resources[use.resource];
+            if (resource.firstPass == InvalidHandle)
+                resource.firstPass = passIndex;
+            resource.lastPass = passIndex;
+            // The frame leaves a transient in the state of its last use, which is where the next
+            // frame finds it
+            resource.initialState = use.state;
+        }
+    }
+
+    PlaceTransients();
+    DeriveBarriers();
+}
+
+void RenderGraph::CullPasses()
+{
+    // Backwards from the outputs: a pass is needed if it writes something a later needed pass
+    // reads, or an output
+    std::vector<bool> needed(m_Resources.size());
+    for (size_t i = 0; i < m_Resources.size(); ++i)
+        needed[i] = m_Resources[i].output;
+
+    for (size_t passIndex = m_Passes.size(); passIndex-- > 0;)
+    {
+        Pass& pass = m_Passes[passIndex];
+        pass.culled = std::none_of(pass.uses.begin(), pass.uses.end(),
+            [&needed](const ResourceUse& use) { return use.write && needed[use.resource]; });
+        if (pass.culled)
+            continue;
+
+        // What it replaces no earlier pass has to provide, what it reads they do
+        for (const ResourceUse& use : pass.uses)
+        {
+            if (use.write && !use.read)
+                needed[use.resource] = false;
+        }
+        for (const ResourceUse& use : pass.uses)
+        {
+            if (use.read)
+                needed[use.resource] = true;
+        }
+    }
+}
+
+void RenderGraph::PlaceTransients()
+{
+    std::vector<ResourceHandle> transients;
+    for (ResourceHandle i = 0; i < m_Resources.size(); ++i)
+    {
+        if (m_Resources[i].transient && m_Resources[i].firstPass != InvalidHandle)
+            transients.push_back(i);
+    }
+
+    // Largest first, each at the lowest offset clear of the placed ones that live at the same time
+    std::stable_sort(transients.begin(), transients.end(), [this](ResourceHandle a, ResourceHandle b)
+    {
+        return m_Resources[a].allocationInfo.SizeInBytes > m_Resources[b].allocationInfo.SizeInBytes;
+    });
+
+    m_HeapSize = 0;
+    m_HeapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    std::vector<ResourceHandle> placed;
+    for (ResourceHandle handle : transients)
+    {
+        Resource& resource = m_Resources[handle];
+        const uint64_t size = resource.allocationInfo.SizeInBytes;
+        const uint64_t alignment = std::max<uint64_t>(resource.allocationInfo.Alignment, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+
+        resource.heapOffset = 0;
+        bool moved = true;
+        while (moved)
+        {
+            moved = false;
+            for (ResourceHandle other : placed)
+            {
+                const Resource& placedResource = m_Resources[other];
+                const uint64_t placedEnd = placedResource.heapOffset + placedResource.allocationInfo.SizeInBytes;
+                if (!LifetimesOverlap(resource, placedResource) ||
+                    resource.heapOffset >= placedEnd || resource.heapOffset + size <= placedResource.heapOffset)
+                    continue;
+
+                resource.heapOffset = Math::AlignUp(placedEnd, static_cast<size_t>(alignment));
+                moved = true;
+            }
+        }
+
+        placed.push_back(handle);
+        m_HeapSize = std::max(m_HeapSize, resource.heapOffset + size);
+        m_HeapAlignment = std::max(m_HeapAlignment, alignment);
+    }
+}
+
+void RenderGraph::DeriveBarriers()
+{
+    for (Pass& pass : m_Passes)
+        pass.barriers.clear();
+    m_FinalBarriers.clear();
+
+    // A transient that shares memory takes it over with an aliasing barrier before its first use.
+    // With one other transient in that memory it is the one before; with several, any of them.
+    for (ResourceHandle handle = 0; handle < m_Resources.size(); ++handle)
+    {
+        const Resource& resource = m_Resources[handle];
+        if (!resource.transient || resource.firstPass == InvalidHandle)
+            continue;
+
+        ResourceHandle resourceBefore = InvalidHandle;
+        uint32_t sharing = 0;
+        for (ResourceHandle other = 0; other < m_Resources.size(); ++other)
+        {
+            const Resource& otherResource = m_Resources[other];
+            if (other == handle || !otherResource.transient || otherResource.firstPass == InvalidHandle ||
+                !MemoryOverlaps(resource, otherResource))
+                continue;
+
+            resourceBefore = other;
+            ++sharing;
+        }
+
+        if (sharing > 0)
+        {
+            Barrier barrier = {};
+            barrier.type = Barrier::Type::Aliasing;
+            barrier.resource = handle;
+            barrier.resourceBefore = sharing == 1 ? resourceBefore : InvalidHandle;
+            m_Passes[resource.firstPass].barriers.push_back(barrier);
+        }
+    }
+
+    // Transients start the frame where the last frame left them; imported resources wherever the
+    // command lists before left them, which only the state tracker knows
+    std::vector<D3D12_RESOURCE_STATES> states(m_Resources.size(), D3D12_RESOURCE_STATE_COMMON);
+    std::vector<bool> known(m_Resources.size(), false);
+    for (size_t i = 0; i < m_Resources.size(); ++i)
+    {
+        if (m_Resources[i].transient)
+        {
+            states[i] = m_Resources[i].initialState;
+            known[i] = true;
+        }
+    }
+
+    auto transition = [&states, &known](std::vector<Barrier>& barriers, ResourceHandle resource, D3D12_RESOURCE_STATES stateAfter)
+    {
+        if (known[resource] && states[resource] == stateAfter)
+            return;
+
+        Barrier barrier = {};
+        barrier.type = Barrier::Type::Transition;
+        barrier.resource = resource;
+        barrier.resourceBefore = InvalidHandle;
+        barrier.stateBeforeKnown = known[resource];
+        barrier.stateBefore = states[resource];
+        barrier.stateAfter = stateAfter;
+        barriers.push_back(barrier);
+
+        states[resource] = stateAfter;
+        known[resource] = true;
+    };
+
+    for (Pass& pass : m_Passes)
+    {
+        if (pass.culled)
+            continue;
+
+        for (const ResourceUse& use : pass.uses)
+            transition(pass.barriers, use.resource, use.state);
+    }
+
+    for (ResourceHandle handle = 0; handle < m_Resources.size(); ++handle)
+    {
+        if (m_Resources[handle].output)
+            transition(m_FinalBarriers, handle, m_Resources[handle].finalState);
+    }
+}
+
+void RenderGraph::CreateTransientResources(ID3D12Device2* device)
+{
+    if (m_HeapSize == 0)
+        return;
+
+    D3D12_HEAP_DESC heapDesc = {};
+    heapDesc.SizeInBytes = m_HeapSize;
+    heapDesc.Properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    heapDesc.Alignment = m_HeapAlignment;
+    // Render targets and depth buffers only, which every resource heap tier can keep together
+    heapDesc.Flags = D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES;
+    ThrowIfFailed(device->CreateHeap(&heapDesc, IID_PPV_ARGS(&m_Heap)));
+
+    for (Resource& resource : m_Resources)
+    {
+        if (!resource.transient || resource.firstPass == InvalidHandle)
+            continue;
+
+        assert((resource.desc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL)) &&
+            "Only render targets and depth buffers can be transient");
+
+        ThrowIfFailed(device->CreatePlacedResource(m_Heap.Get(), resource.heapOffset, &resource.desc,
+            resource.initialState, &resource.clearValue, IID_PPV_ARGS(&resource.transientResource)));
+        resource.transientResource->SetName(std::wstring(resource.name.begin(), resource.name.end()).c_str());
+
+        resource.d3d12Resource = resource.transientResource.Get();
+        ResourceStateTracker::AddGlobalResourceState(resource.d3d12Resource, resource.initialState);
+    }
+}
+
+void RenderGraph::Reset()
+{
+    for (const Resource& resource : m_Resources)
+    {
+        if (resource.transientResource)
+            ResourceStateTracker::RemoveGlobalResourceState(resource.transientResource.Get());
+    }
+
+    m_Resources.clear();
+    m_Passes.clear();
+    m_FinalBarriers.clear();
+    m_HeapSize = 0;
+    m_Heap.Reset();
+}
+
+void RenderGraph::SetImportedResource(ResourceHandle resource, ID3D12Resource* d3d12Resource)
+{
+    assert(!m_Resources[resource].transient && "Transients are created by the graph");
+    m_Resources[resource].d3d12Resource = d3d12Resource;
+}
+
+ID3D12Resource* RenderGraph::GetResource(ResourceHandle resource) const
+{
+    return m_Resources[resource].d3d12Resource;
+}
+
+void RenderGraph::Execute(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList, CommandQueue& commandQueue) const
+{
+    for (const Pass& pass : m_Passes)
+    {
+        if (pass.culled)
+            continue;
+
+        // The tracker is looked up again every time, a pass may have moved on to another list
+        ResourceStateTracker& stateTracker = commandQueue.GetResourceStateTracker(commandList.Get());
+        RecordBarriers(pass.barriers, stateTracker);
+        stateTracker.FlushResourceBarriers(commandList.Get());
+
+        pass.execute(commandList);
+    }
+
+    ResourceStateTracker& stateTracker = commandQueue.GetResourceStateTracker(commandList.Get());
+    RecordBarriers(m_FinalBarriers, stateTracker);
+    stateTracker.FlushResourceBarriers(commandList.Get());
+}
+
+void RenderGraph::RecordBarriers(const std::vector<Barrier>& barriers, ResourceStateTracker& stateTracker) const
+{
+    for (const Barrier& barrier : barriers)
+    {
+        const Resource& resource = m_Resources[barrier.resource];
+        if (!resource.d3d12Resource)
+            continue;
+
+        if (barrier.type == Barrier::Type::Aliasing)
+        {
+            ID3D12Resource* resourceBefore = barrier.resourceBefore != InvalidHandle ? m_Resources[barrier.resourceBefore].d3d12Resource : nullptr;
+            stateTracker.AliasResources(resourceBefore, resource.d3d12Resource);
+        }
+        else if (resource.transient)
+        {
+            // The graph is all that touches them, so it knows; a pending barrier would also run
+            // before the aliasing barrier that hands the transient its memory
+            stateTracker.TransitionResourceFromState(resource.d3d12Resource, barrier.stateBefore, barrier.stateAfter);
+        }
+        else
+        {
+            stateTracker.TransitionResource(resource.d3d12Resource, barrier.stateAfter);
+        }
+    }
+}
+
+bool RenderGraph::LifetimesOverlap(const Resource& a, const Resource& b)
+{
+    return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+}
+
+bool RenderGraph::MemoryOverlaps(const Resource& a, const Resource& b)
+{
+    return a.heapOffset < b.heapOffset + b.allocationInfo.SizeInBytes &&
+        b.heapOffset < a.heapOffset + a.allocationInfo.SizeInBytes;
+}
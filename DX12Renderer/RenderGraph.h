@@ -0,0 +1,182 @@
+/**
+ * A frame described as passes that declare the resources they read and write, compiled into the
+ * barriers between them and a heap for the transient resources.
+ */
+
+#pragma once
+
+#include <d3d12.h>  // For ID3D12Resource, ID3D12Heap and D3D12_RESOURCE_DESC
+#include <wrl.h>    // For Microsoft::WRL::ComPtr
+
+#include <cstdint>    // For uint32_t and uint64_t
+#include <functional> // For std::function
+#include <string>     // For std::string
+#include <vector>     // For std::vector
+
+class CommandQueue;
+class ResourceStateTracker;
+
+// Passes run in the order they are added. Compile works out which of them the outputs depend on
+// and culls the rest, the state every resource has to be in for every pass (and so the
+// transitions between them), and where each transient resource lives in a single placed heap.
+// Transients whose lifetimes do not overlap share memory; the pass that uses one first after
+// another had the memory has to clear or discard it.
+//
+// Compile only looks at what was declared, never at a device, so the graph can be built and
+// checked without one. Transients have to be given their allocation info up front for that
+// (ID3D12Device::GetResourceAllocationInfo).
+//
+// The graph is built once and executed every frame; it is rebuilt when the transients change
+// size. Imported resources (the back buffer, textures owned elsewhere) are bound again every frame
+// with SetImportedResource, so they may change between frames.
+//
+// A pass gets the command list by reference and may leave another one in its place, when it
+// hands its work to lists recorded on other threads. The caller submits the lists in the order
+// they were used; the passes after it record on the one it left.
+class RenderGraph
+{
+public:
+    using ResourceHandle = uint32_t;
+    using PassHandle = uint32_t;
+    static constexpr uint32_t InvalidHandle = UINT32_MAX;
+
+    using ExecuteFunction = std::function<void(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList)>;
+
+    /// <summary>
+    /// Adds a resource the graph does not own. The state it is in on entry is whatever the
+    /// command list's ResourceStateTracker knows it to be.
+    /// </summary>
+    ResourceHandle ImportResource(const std::string& name);
+
+    /// <summary>
+    /// Adds a resource that only lives for the frame, to be placed in the graph's heap.
+    /// </summary>
+    ResourceHandle CreateTransient(const std::string& name, const D3D12_RESOURCE_DESC& desc,
+        const D3D12_CLEAR_VALUE& clearValue, const D3D12_RESOURCE_ALLOCATION_INFO& allocationInfo);
+
+    /// <summary>
+    /// Makes the resource something the frame produces: the passes that write it are kept and it
+    /// is left in finalState.
+    /// </summary>
+    void MarkOutput(ResourceHandle resource, D3D12_RESOURCE_STATES finalState);
+
+    PassHandle AddPass(const std::string& name, ExecuteFunction execute);
+
+    /// <summary>
+    /// Declares that the pass uses the resource in the given state. A pass that reads and writes a
+    /// resource declares both, in the same state. A write without a read means the pass replaces
+    /// the contents, so the passes writing it before are not needed for it.
+    /// </summary>
+    void Read(PassHandle pass, ResourceHandle resource, D3D12_RESOURCE_STATES state);
+    void Write(PassHandle pass, ResourceHandle resource, D3D12_RESOURCE_STATES state);
+
+    /// <summary>
+    /// Culls the passes, derives the barriers and places the transients. Needs no device.
+    /// </summary>
+    void Compile();
+
+    /// <summary>
+    /// Creates the heap and the transients in it, after Compile. Each is created in the state the
+    /// frame leaves it in, and added to the ResourceStateTracker's global states.
+    /// </summary>
+    void CreateTransientResources(ID3D12Device2* device);
+
+    /// <summary>
+    /// Releases the transients and forgets every resource and pass, for building the graph again.
+    /// The GPU must be done with the transients.
+    /// </summary>
+    void Reset();
+
+    // May be null: the passes then skip it and no barriers are recorded for it
+    void SetImportedResource(ResourceHandle resource, ID3D12Resource* d3d12Resource);
+    ID3D12Resource* GetResource(ResourceHandle resource) const;
+
+    /// <summary>
+    /// Records the passes that survived culling, each after its barriers, and the transitions to
+    /// the outputs' final states. Transitions go through the state tracker commandQueue keeps for
+    /// whichever list is current. commandList is left as the list the last pass recorded on.
+    /// </summary>
+    void Execute(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList, CommandQueue& commandQueue) const;
+
+    struct Barrier
+    {
+        enum class Type { Transition, Aliasing };
+        Type type;
+        ResourceHandle resource;
+        // Aliasing: the transient that had the memory before, or InvalidHandle for any of them
+        ResourceHandle resourceBefore;
+        // Transition: for imported resources the first one of the frame has no known state before
+        bool stateBeforeKnown;
+        D3D12_RESOURCE_STATES stateBefore;
+        D3D12_RESOURCE_STATES stateAfter;
+    };
+
+    // Results of Compile
+    bool IsPassCulled(PassHandle pass) const { return m_Passes[pass].culled; }
+    // Recorded before the pass
+    const std::vector<Barrier>& GetPassBarriers(PassHandle pass) const { return m_Passes[pass].barriers; }
+    // Recorded after the last pass
+    const std::vector<Barrier>& GetFinalBarriers() const { return m_FinalBarriers; }
+    uint64_t GetHeapSize() const { return m_HeapSize; }
+    uint64_t GetHeapOffset(ResourceHandle transient) const { return m_Resources[transient].heapOffset; }
+    // The state a transient is created in, which is the one the frame leaves it in
+    D3D12_RESOURCE_STATES GetInitialState(ResourceHandle transient) const { return m_Resources[transient].initialState; }
+
+private:
+    struct Resource
+    {
+        std::string name;
+        bool transient = false;
+        D3D12_RESOURCE_DESC desc = {};
+        D3D12_CLEAR_VALUE clearValue = {};
+        D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = {};
+
+        bool output = false;
+        D3D12_RESOURCE_STATES finalState = D3D12_RESOURCE_STATE_COMMON;
+
+        // Filled in by Compile, over the passes that are not culled
+        uint32_t firstPass = InvalidHandle;
+        uint32_t lastPass = InvalidHandle;
+        uint64_t heapOffset = 0;
+        D3D12_RESOURCE_STATES initialState = D3D12_RESOURCE_STATE_COMMON;
+
+        ID3D12Resource* d3d12Resource = nullptr;
+        Microsoft::WRL::ComPtr<ID3D12Resource> transientResource;
+    };
+
+    struct ResourceUse
+    {
+        ResourceHandle resource;
+        D3D12_RESOURCE_STATES state;
+        bool read;
+        bool write;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        ExecuteFunction execute;
+        std::vector<ResourceUse> uses;
+
+        bool culled = false;
+        std::vector<Barrier> barriers;
+    };
+
+    void AddUse(PassHandle pass, ResourceHandle resource, D3D12_RESOURCE_STATES state, bool read, bool write);
+
+    void CullPasses();
+    void PlaceTransients();
+    void DeriveBarriers();
+    void RecordBarriers(const std::vector<Barrier>& barriers, ResourceStateTracker& stateTracker) const;
+
+    static bool LifetimesOverlap(const Resource& a, const Resource& b);
+    static bool MemoryOverlaps(const Resource& a, const Resource& b);
+
+    std::vector<Resource> m_Resources;
+    std::vector<Pass> m_Passes;
+    std::vector<Barrier> m_FinalBarriers;
+
+    uint64_t m_HeapSize = 0;
+    uint64_t m_HeapAlignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    Microsoft::WRL::ComPtr<ID3D12Heap> m_Heap;
+};
@@ -0,0 +1,64 @@
+#include "ResourceBarrierBatch.h"
+#include <cassert>
+#include <iterator>
+#include "d3dx12.h"
+
+void ResourceBarrierBatch::Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter,
+    UINT subresource)
+{
+    ++m_Stats.requested;
+    if (stateBefore == stateAfter)
+        return;
+
+    // Only the resource's latest pending transition can take this one: past a transition of
+    // another of its subresources (or of all of them) the order matters
+    for (auto it = m_Pending.rbegin(); it != m_Pending.rend(); ++it)
+    {
+        if (it->Type == D3D12_RESOURCE_BARRIER_TYPE_ALIASING)
+        {
+            if (it->Aliasing.pResourceBefore == resource || it->Aliasing.pResourceAfter == resource)
+                break;
+            continue;
+        }
+
+        D3D12_RESOURCE_TRANSITION_BARRIER& pending = it->Transition;
+        if (pending.pResource != resource)
+            continue;
+        if (pending.Subresource != subresource)
+            break;
+
+        assert(pending.StateAfter == stateBefore && "Transition does not start where the pending one ends");
+        pending.StateAfter = stateAfter;
+        if (pending.StateBefore == pending.StateAfter)
+            m_Pending.erase(std::next(it).base());
+        return;
+    }
+
+    m_Pending.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, stateBefore, stateAfter, subresource));
+}
+
+void ResourceBarrierBatch::Aliasing(ID3D12Resource* resourceBefore, ID3D12Resource* resourceAfter)
+{
+    ++m_Stats.requested;
+    m_Pending.push_back(CD3DX12_RESOURCE_BARRIER::Aliasing(resourceBefore, resourceAfter));
+}
+
+void ResourceBarrierBatch::Flush(ID3D12GraphicsCommandList* commandList)
+{
+    if (m_Pending.empty())
+        return;
+
+    commandList->ResourceBarrier(static_cast<UINT>(m_Pending.size()), m_Pending.data());
+    m_Stats.submitted += m_Pending.size();
+    ++m_Stats.calls;
+
+    // Keeps the capacity, so a steady frame does not allocate
+    m_Pending.clear();
+}
+
+ResourceBarrierBatch::Stats ResourceBarrierBatch::TakeStats()
+{
+    Stats stats = m_Stats;
+    m_Stats = Stats();
+    return stats;
+}
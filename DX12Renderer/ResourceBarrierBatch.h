@@ -0,0 +1,53 @@
+/**
+ * Collects resource transitions and records them with a single ResourceBarrier call.
+ */
+
+#pragma once
+
+#include <d3d12.h>  // For ID3D12Resource and D3D12_RESOURCE_BARRIER
+
+#include <cstddef>  // For size_t
+#include <vector>   // For std::vector
+
+// Transitions wait in the batch until Flush, which belongs right before the draw, dispatch, clear
+// or copy that needs them. A transition that continues the latest pending one of the same
+// (sub)resource is folded into it (A -> B then B -> C records A -> C), and one that takes it back
+// to where the pending one started (A -> B then B -> A) cancels both, so a pass can put its
+// resources back when it ends without paying for the round trip when the next pass wants them the
+// same way.
+class ResourceBarrierBatch
+{
+public:
+    /// <summary>
+    /// Queues a transition. stateBefore has to be the state the resource is in once every pending
+    /// transition has run.
+    /// </summary>
+    void Transition(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter,
+        UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+    /// <summary>
+    /// Queues an aliasing barrier: resourceAfter takes over memory it shares with resourceBefore
+    /// (or, when that is null, with any other placed resource).
+    /// </summary>
+    void Aliasing(ID3D12Resource* resourceBefore, ID3D12Resource* resourceAfter);
+
+    /// <summary>
+    /// Records every pending barrier with one ResourceBarrier call, and nothing when none are left.
+    /// </summary>
+    void Flush(ID3D12GraphicsCommandList* commandList);
+
+    bool IsEmpty() const { return m_Pending.empty(); }
+
+    struct Stats
+    {
+        size_t requested = 0; // Transitions queued
+        size_t submitted = 0; // Barriers that reached a command list, after folding and cancelling
+        size_t calls = 0;     // ResourceBarrier calls
+    };
+    // Since the last call
+    Stats TakeStats();
+
+private:
+    std::vector<D3D12_RESOURCE_BARRIER> m_Pending;
+    Stats m_Stats;
+};
@@ -0,0 +1,204 @@
+#include "ResourceStateTracker.h"
+#include <cassert>
+#include "d3dx12.h"
+
+std::mutex ResourceStateTracker::s_GlobalMutex;
+ResourceStateTracker::ResourceStateMap ResourceStateTracker::s_GlobalResourceState;
+
+void ResourceStateTracker::TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateAfter, UINT subresource)
+{
+    ResourceState& finalState = m_FinalResourceState[resource];
+    D3D12_RESOURCE_STATES stateBefore;
+
+    if (subresource != D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+    {
+        if (finalState.FindSubresourceState(subresource, stateBefore))
+            m_ResourceBarriers.Transition(resource, stateBefore, stateAfter, subresource);
+        else
+            m_PendingResourceBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_COMMON, stateAfter, subresource));
+    }
+    else if (finalState.subresourceStates.empty())
+    {
+        if (finalState.hasState)
+            m_ResourceBarriers.Transition(resource, finalState.state, stateAfter);
+        else
+            m_PendingResourceBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_COMMON, stateAfter));
+    }
+    else
+    {
+        // Subresources the list left in different states, or has only touched some of, go over
+        // one at a time
+        const UINT subresourceCount = GetSubresourceCount(resource);
+        for (UINT i = 0; i < subresourceCount; ++i)
+        {
+            if (finalState.FindSubresourceState(i, stateBefore))
+                m_ResourceBarriers.Transition(resource, stateBefore, stateAfter, i);
+            else
+                m_PendingResourceBarriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, D3D12_RESOURCE_STATE_COMMON, stateAfter, i));
+        }
+    }
+
+    finalState.SetSubresourceState(subresource, stateAfter);
+}
+
+void ResourceStateTracker::TransitionResourceFromState(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore,
+    D3D12_RESOURCE_STATES stateAfter)
+{
+    ResourceState& finalState = m_FinalResourceState[resource];
+    if (finalState.hasState || !finalState.subresourceStates.empty())
+    {
+        // What the list did with it since is what counts
+        TransitionResource(resource, stateAfter);
+        return;
+    }
+
+    m_ResourceBarriers.Transition(resource, stateBefore, stateAfter);
+    finalState.SetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, stateAfter);
+}
+
+void ResourceStateTracker::AliasResources(ID3D12Resource* resourceBefore, ID3D12Resource* resourceAfter)
+{
+    m_ResourceBarriers.Aliasing(resourceBefore, resourceAfter);
+}
+
+void ResourceStateTracker::FlushResourceBarriers(ID3D12GraphicsCommandList* commandList)
+{
+    m_ResourceBarriers.Flush(commandList);
+}
+
+uint32_t ResourceStateTracker::ResolvePendingResourceBarriers()
+{
+    std::vector<D3D12_RESOURCE_BARRIER>& barriers = m_ResolvedResourceBarriers;
+    barriers.clear();
+
+    for (const D3D12_RESOURCE_BARRIER& pending : m_PendingResourceBarriers)
+    {
+        ID3D12Resource* resource = pending.Transition.pResource;
+        const UINT subresource = pending.Transition.Subresource;
+        const D3D12_RESOURCE_STATES stateAfter = pending.Transition.StateAfter;
+
+        auto it = s_GlobalResourceState.find(resource);
+        if (it == s_GlobalResourceState.end())
+        {
+            assert(false && "Resource has no global state; add it when it is created");
+            continue;
+        }
+        const ResourceState& globalState = it->second;
+
+        if (subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES && !globalState.subresourceStates.empty())
+        {
+            const UINT subresourceCount = GetSubresourceCount(resource);
+            for (UINT i = 0; i < subresourceCount; ++i)
+            {
+                D3D12_RESOURCE_STATES stateBefore = globalState.state;
+                globalState.FindSubresourceState(i, stateBefore);
+                if (stateBefore != stateAfter)
+                    barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, stateBefore, stateAfter, i));
+            }
+        }
+        else
+        {
+            D3D12_RESOURCE_STATES stateBefore = globalState.state;
+            globalState.FindSubresourceState(subresource, stateBefore);
+            if (stateBefore != stateAfter)
+                barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(resource, stateBefore, stateAfter, subresource));
+        }
+    }
+
+    m_PendingResourceBarriers.clear();
+    return static_cast<uint32_t>(barriers.size());
+}
+
+void ResourceStateTracker::FlushPendingResourceBarriers(ID3D12GraphicsCommandList* commandList)
+{
+    if (!m_ResolvedResourceBarriers.empty())
+        commandList->ResourceBarrier(static_cast<UINT>(m_ResolvedResourceBarriers.size()), m_ResolvedResourceBarriers.data());
+    m_ResolvedResourceBarriers.clear();
+}
+
+void ResourceStateTracker::CommitFinalResourceStates()
+{
+    for (const auto& [resource, finalState] : m_FinalResourceState)
+    {
+        ResourceState& globalState = s_GlobalResourceState[resource];
+        if (finalState.hasState)
+            globalState.SetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, finalState.state);
+        for (const auto& [subresource, state] : finalState.subresourceStates)
+            globalState.SetSubresourceState(subresource, state);
+    }
+}
+
+void ResourceStateTracker::Reset()
+{
+    assert(m_ResourceBarriers.IsEmpty() && "Transitions were never flushed");
+    m_PendingResourceBarriers.clear();
+    m_ResolvedResourceBarriers.clear();
+    m_FinalResourceState.clear();
+}
+
+void ResourceStateTracker::AddGlobalResourceState(ID3D12Resource* resource, D3D12_RESOURCE_STATES state)
+{
+    if (!resource)
+        return;
+
+    std::lock_guard<std::mutex> lock(s_GlobalMutex);
+    ResourceState& globalState = s_GlobalResourceState[resource];
+    globalState = ResourceState();
+    globalState.SetSubresourceState(D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES, state);
+}
+
+void ResourceStateTracker::RemoveGlobalResourceState(ID3D12Resource* resource)
+{
+    std::lock_guard<std::mutex> lock(s_GlobalMutex);
+    s_GlobalResourceState.erase(resource);
+}
+
+std::unique_lock<std::mutex> ResourceStateTracker::LockGlobalState()
+{
+    return std::unique_lock<std::mutex>(s_GlobalMutex);
+}
+
+UINT ResourceStateTracker::GetSubresourceCount(ID3D12Resource* resource)
+{
+    // Single-plane formats only, which is all this renderer transitions per subresource
+    D3D12_RESOURCE_DESC desc = resource->GetDesc();
+    if (desc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+        return 1;
+
+    const UINT arraySize = desc.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE3D ? 1 : desc.DepthOrArraySize;
+    return desc.MipLevels * arraySize;
+}
+
+void ResourceStateTracker::ResourceState::SetSubresourceState(UINT subresource, D3D12_RESOURCE_STATES subresourceState)
+{
+    if (subresource == D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES)
+    {
+        state = subresourceState;
+        hasState = true;
+        subresourceStates.clear();
+    }
+    else if (hasState && subresourceState == state)
+    {
+        // Back with the rest of the resource
+        subresourceStates.erase(subresource);
+    }
+    else
+    {
+        subresourceStates[subresource] = subresourceState;
+    }
+}
+
+bool ResourceStateTracker::ResourceState::FindSubresourceState(UINT subresource, D3D12_RESOURCE_STATES& subresourceState) const
+{
+    auto it = subresourceStates.find(subresource);
+    if (it != subresourceStates.end())
+    {
+        subresourceState = it->second;
+        return true;
+    }
+    if (!hasState)
+        return false;
+
+    subresourceState = state;
+    return true;
+}
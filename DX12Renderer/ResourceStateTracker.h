@@ -0,0 +1,119 @@
+/**
+ * Tracks the states of resources per command list and across them, so transitions only name the
+ * state they need.
+ */
+
+#pragma once
+
+#include "ResourceBarrierBatch.h"
+
+#include <d3d12.h>  // For ID3D12Resource and D3D12_RESOURCE_BARRIER
+
+#include <cstdint>  // For uint32_t
+#include <map>      // For std::map
+#include <mutex>    // For std::mutex
+#include <unordered_map> // For std::unordered_map
+#include <vector>   // For std::vector
+
+// Every command list of a CommandQueue has one (CommandQueue::GetResourceStateTracker). The
+// tracker knows the states the list has put its resources in so far; the first transition of a
+// resource in the list has no known state before it, so it waits as a pending barrier. When the
+// list is executed the queue resolves the pending barriers against the global states (those the
+// lists executed before it left the resources in), records the ones that change anything on a
+// list of their own that runs first, and commits the list's final states as the new global ones.
+//
+// Resources have to be added to the global states when they are created, in the state they are
+// created in. States are tracked per subresource where transitions name one.
+class ResourceStateTracker
+{
+public:
+    /// <summary>
+    /// Transitions the resource (or one subresource of it) to stateAfter. Nothing is recorded
+    /// until FlushResourceBarriers, and nothing at all if the resource is already there.
+    /// </summary>
+    void TransitionResource(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateAfter,
+        UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+    /// <summary>
+    /// Transitions a resource whose state the caller knows for certain, as the render graph does
+    /// for its transients. Unless the list has used the resource already, stateBefore is taken as
+    /// is instead of waiting as a pending barrier.
+    /// </summary>
+    void TransitionResourceFromState(ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter);
+
+    /// <summary>
+    /// Queues an aliasing barrier with the transitions, for placed resources sharing memory.
+    /// </summary>
+    void AliasResources(ID3D12Resource* resourceBefore, ID3D12Resource* resourceAfter);
+
+    /// <summary>
+    /// Records the transitions since the last flush with one ResourceBarrier call. Belongs right
+    /// before the draws, clears and copies that need them.
+    /// </summary>
+    void FlushResourceBarriers(ID3D12GraphicsCommandList* commandList);
+
+    /// <summary>
+    /// Works out the transitions from the global states to the states the command list expects
+    /// on entry, and returns how many there are. Called by CommandQueue with the global states
+    /// locked, before CommitFinalResourceStates.
+    /// </summary>
+    uint32_t ResolvePendingResourceBarriers();
+
+    /// <summary>
+    /// Records the transitions ResolvePendingResourceBarriers found. The queue only takes a
+    /// command list for them when there are any.
+    /// </summary>
+    void FlushPendingResourceBarriers(ID3D12GraphicsCommandList* commandList);
+
+    /// <summary>
+    /// Makes the states the command list leaves its resources in the global ones.
+    /// </summary>
+    void CommitFinalResourceStates();
+
+    /// <summary>
+    /// Forgets the command list's states, for the next recording.
+    /// </summary>
+    void Reset();
+
+    // Barrier traffic of the command list since the last call
+    ResourceBarrierBatch::Stats TakeStats() { return m_ResourceBarriers.TakeStats(); }
+
+    /// <summary>
+    /// Sets the state a resource is in outside of any command list: the state it is created in,
+    /// or one it was put in without a tracker. Replaces what was known about it.
+    /// </summary>
+    static void AddGlobalResourceState(ID3D12Resource* resource, D3D12_RESOURCE_STATES state);
+    static void RemoveGlobalResourceState(ID3D12Resource* resource);
+
+    // Held from resolving a command list's pending barriers until it has been submitted, so the
+    // global states follow the order the queue runs the lists in
+    static std::unique_lock<std::mutex> LockGlobalState();
+
+private:
+    // Subresources without an entry of their own are in 'state'. In a command list's final
+    // states 'state' only counts once the whole resource has been transitioned (hasState).
+    struct ResourceState
+    {
+        D3D12_RESOURCE_STATES state = D3D12_RESOURCE_STATE_COMMON;
+        bool hasState = false;
+        std::map<UINT, D3D12_RESOURCE_STATES> subresourceStates;
+
+        void SetSubresourceState(UINT subresource, D3D12_RESOURCE_STATES subresourceState);
+        bool FindSubresourceState(UINT subresource, D3D12_RESOURCE_STATES& subresourceState) const;
+    };
+
+    using ResourceStateMap = std::unordered_map<ID3D12Resource*, ResourceState>;
+
+    static UINT GetSubresourceCount(ID3D12Resource* resource);
+
+    // First transitions of resources (or subresources) this list had no state for; StateBefore is
+    // filled in from the global states at execution
+    std::vector<D3D12_RESOURCE_BARRIER> m_PendingResourceBarriers;
+    // The pending barriers that change anything, with StateBefore filled in
+    std::vector<D3D12_RESOURCE_BARRIER> m_ResolvedResourceBarriers;
+    ResourceBarrierBatch m_ResourceBarriers;
+    ResourceStateMap m_FinalResourceState;
+
+    static std::mutex s_GlobalMutex;
+    static ResourceStateMap s_GlobalResourceState;
+};
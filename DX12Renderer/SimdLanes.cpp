@@ -0,0 +1,63 @@
+#include "SimdLanes.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+    Simd::Level DetectLevel()
+    {
+#if defined(_MSC_VER)
+        int info[4] = {};
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        const bool sse41 = (info[2] & (1 << 19)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx)
+        {
+            // The OS must save both XMM and YMM state for AVX to be usable.
+            const unsigned long long xcr0 = _xgetbv(0);
+            if ((xcr0 & 0x6) == 0x6)
+            {
+                __cpuidex(info, 7, 0);
+                avx2 = (info[1] & (1 << 5)) != 0;
+            }
+        }
+#else
+        __builtin_cpu_init();
+        const bool sse41 = __builtin_cpu_supports("sse4.1");
+        const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+        if (avx2)
+            return Simd::Level::AVX2;
+        if (sse41)
+            return Simd::Level::SSE41;
+        return Simd::Level::Scalar;
+    }
+}
+
+Simd::Level Simd::GetSupportedLevel()
+{
+    static const Level level = DetectLevel();
+    return level;
+}
+
+const char* Simd::GetLevelName(Level level)
+{
+    switch (level)
+    {
+    case Level::AVX2:
+        return "AVX2";
+    case Level::SSE41:
+        return "SSE4.1";
+    default:
+        return "Scalar";
+    }
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <immintrin.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+/// <summary>
+/// Thin wrappers over scalar, SSE4.1 and AVX2 registers so a kernel can be written
+/// once as a template and instantiated for 1, 4 or 8 lanes.
+///
+/// Every operation maps onto a single IEEE-754 instruction (no approximations, no
+/// fused multiply-add), so a kernel produces the same bits at every width as long as
+/// the compiler does not contract a*b+c itself. MSVC's default /fp:precise never does.
+/// </summary>
+namespace Simd
+{
+    enum class Level
+    {
+        Scalar,
+        SSE41,
+        AVX2
+    };
+
+    /// <summary>
+    /// Highest instruction set supported by both the CPU and the OS (AVX2 needs the
+    /// OS to save the YMM registers). Detected once and cached.
+    /// </summary>
+    Level GetSupportedLevel();
+
+    const char* GetLevelName(Level level);
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Scalar
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // int32 with wrapping multiply, so hashing matches the SIMD lanes without UB.
+    struct SInt
+    {
+        int32_t v;
+    };
+
+    inline SInt operator+(SInt a, SInt b) { return { int32_t(uint32_t(a.v) + uint32_t(b.v)) }; }
+    inline SInt operator-(SInt a, SInt b) { return { int32_t(uint32_t(a.v) - uint32_t(b.v)) }; }
+    inline SInt operator*(SInt a, SInt b) { return { int32_t(uint32_t(a.v) * uint32_t(b.v)) }; }
+    inline SInt operator^(SInt a, SInt b) { return { a.v ^ b.v }; }
+    inline SInt operator&(SInt a, SInt b) { return { a.v & b.v }; }
+    inline SInt operator|(SInt a, SInt b) { return { a.v | b.v }; }
+    template <int Shift> inline SInt ShiftRightArithmetic(SInt a) { return { a.v >> Shift }; }
+
+    inline float Min(float a, float b) { return a < b ? a : b; }
+    inline float Max(float a, float b) { return a > b ? a : b; }
+    inline float Abs(float a) { return std::fabs(a); }
+    inline float Sqrt(float a) { return std::sqrt(a); }
+    inline float Select(bool mask, float a, float b) { return mask ? a : b; }
+    inline SInt Select(bool mask, SInt a, SInt b) { return mask ? a : b; }
+    inline float Round(float a) { return std::nearbyint(a); }
+    inline SInt TruncateToInt(float a) { return { int32_t(a) }; }
+    inline SInt RoundToInt(float a) { return { int32_t(std::nearbyint(a)) }; }
+    inline float ToFloat(SInt a) { return float(a.v); }
+    inline float BitsToFloat(SInt a) { float f; std::memcpy(&f, &a.v, sizeof(f)); return f; }
+    inline float Gather(const float* table, SInt index) { return table[index.v]; }
+    inline bool AnyTrue(bool mask) { return mask; }
+
+    // FastNoiseLite::FastFloor: (int)f, minus one for negative input (including negative integers).
+    inline SInt FastFloor(float a) { return { a >= 0 ? int32_t(a) : int32_t(a) - 1 }; }
+
+    struct ScalarLanes
+    {
+        static constexpr int Width = 1;
+        using F = float;
+        using I = SInt;
+        using M = bool;
+
+        static F Set(float v) { return v; }
+        static I SetI(int32_t v) { return { v }; }
+        static F Load(const float* p) { return *p; }
+        static void Store(float* p, F v) { *p = v; }
+        static void StoreI(int32_t* p, I v) { *p = v.v; }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // SSE4.1 (4 lanes)
+    ////////////////////////////////////////////////////////////////////////////////
+
+    struct F4 { __m128 v; };
+    struct I4 { __m128i v; };
+    struct M4 { __m128 v; };
+
+    inline F4 operator+(F4 a, F4 b) { return { _mm_add_ps(a.v, b.v) }; }
+    inline F4 operator-(F4 a, F4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+    inline F4 operator*(F4 a, F4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+    inline F4 operator/(F4 a, F4 b) { return { _mm_div_ps(a.v, b.v) }; }
+    inline F4 operator-(F4 a) { return { _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)) }; }
+    inline F4& operator+=(F4& a, F4 b) { a = a + b; return a; }
+    inline F4& operator*=(F4& a, F4 b) { a = a * b; return a; }
+
+    inline M4 operator<(F4 a, F4 b) { return { _mm_cmplt_ps(a.v, b.v) }; }
+    inline M4 operator<=(F4 a, F4 b) { return { _mm_cmple_ps(a.v, b.v) }; }
+    inline M4 operator>(F4 a, F4 b) { return { _mm_cmpgt_ps(a.v, b.v) }; }
+    inline M4 operator>=(F4 a, F4 b) { return { _mm_cmpge_ps(a.v, b.v) }; }
+    inline M4 operator==(F4 a, F4 b) { return { _mm_cmpeq_ps(a.v, b.v) }; }
+    inline M4 operator&(M4 a, M4 b) { return { _mm_and_ps(a.v, b.v) }; }
+    inline M4 operator|(M4 a, M4 b) { return { _mm_or_ps(a.v, b.v) }; }
+
+    inline I4 operator+(I4 a, I4 b) { return { _mm_add_epi32(a.v, b.v) }; }
+    inline I4 operator-(I4 a, I4 b) { return { _mm_sub_epi32(a.v, b.v) }; }
+    inline I4 operator*(I4 a, I4 b) { return { _mm_mullo_epi32(a.v, b.v) }; }
+    inline I4 operator^(I4 a, I4 b) { return { _mm_xor_si128(a.v, b.v) }; }
+    inline I4 operator&(I4 a, I4 b) { return { _mm_and_si128(a.v, b.v) }; }
+    inline I4 operator|(I4 a, I4 b) { return { _mm_or_si128(a.v, b.v) }; }
+    template <int Shift> inline I4 ShiftRightArithmetic(I4 a) { return { _mm_srai_epi32(a.v, Shift) }; }
+
+    inline F4 Min(F4 a, F4 b) { return { _mm_min_ps(a.v, b.v) }; }
+    inline F4 Max(F4 a, F4 b) { return { _mm_max_ps(a.v, b.v) }; }
+    inline F4 Abs(F4 a) { return { _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v) }; }
+    inline F4 Sqrt(F4 a) { return { _mm_sqrt_ps(a.v) }; }
+    inline F4 Select(M4 mask, F4 a, F4 b) { return { _mm_blendv_ps(b.v, a.v, mask.v) }; }
+    inline I4 Select(M4 mask, I4 a, I4 b) { return { _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(b.v), _mm_castsi128_ps(a.v), mask.v)) }; }
+    inline F4 Round(F4 a) { return { _mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+    inline I4 TruncateToInt(F4 a) { return { _mm_cvttps_epi32(a.v) }; }
+    inline I4 RoundToInt(F4 a) { return { _mm_cvtps_epi32(a.v) }; }
+    inline F4 ToFloat(I4 a) { return { _mm_cvtepi32_ps(a.v) }; }
+    inline F4 BitsToFloat(I4 a) { return { _mm_castsi128_ps(a.v) }; }
+    inline bool AnyTrue(M4 mask) { return _mm_movemask_ps(mask.v) != 0; }
+
+    inline F4 Gather(const float* table, I4 index)
+    {
+        alignas(16) int32_t idx[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(idx), index.v);
+        return { _mm_setr_ps(table[idx[0]], table[idx[1]], table[idx[2]], table[idx[3]]) };
+    }
+
+    inline I4 FastFloor(F4 a)
+    {
+        // The compare mask is all ones (-1) in negative lanes.
+        __m128i truncated = _mm_cvttps_epi32(a.v);
+        __m128i negative = _mm_castps_si128(_mm_cmplt_ps(a.v, _mm_setzero_ps()));
+        return { _mm_add_epi32(truncated, negative) };
+    }
+
+    struct SSE41Lanes
+    {
+        static constexpr int Width = 4;
+        using F = F4;
+        using I = I4;
+        using M = M4;
+
+        static F Set(float v) { return { _mm_set1_ps(v) }; }
+        static I SetI(int32_t v) { return { _mm_set1_epi32(v) }; }
+        static F Load(const float* p) { return { _mm_loadu_ps(p) }; }
+        static void Store(float* p, F v) { _mm_storeu_ps(p, v.v); }
+        static void StoreI(int32_t* p, I v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v.v); }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // AVX2 (8 lanes)
+    ////////////////////////////////////////////////////////////////////////////////
+
+    struct F8 { __m256 v; };
+    struct I8 { __m256i v; };
+    struct M8 { __m256 v; };
+
+    inline F8 operator+(F8 a, F8 b) { return { _mm256_add_ps(a.v, b.v) }; }
+    inline F8 operator-(F8 a, F8 b) { return { _mm256_sub_ps(a.v, b.v) }; }
+    inline F8 operator*(F8 a, F8 b) { return { _mm256_mul_ps(a.v, b.v) }; }
+    inline F8 operator/(F8 a, F8 b) { return { _mm256_div_ps(a.v, b.v) }; }
+    inline F8 operator-(F8 a) { return { _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)) }; }
+    inline F8& operator+=(F8& a, F8 b) { a = a + b; return a; }
+    inline F8& operator*=(F8& a, F8 b) { a = a * b; return a; }
+
+    inline M8 operator<(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; }
+    inline M8 operator<=(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ) }; }
+    inline M8 operator>(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+    inline M8 operator>=(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ) }; }
+    inline M8 operator==(F8 a, F8 b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ) }; }
+    inline M8 operator&(M8 a, M8 b) { return { _mm256_and_ps(a.v, b.v) }; }
+    inline M8 operator|(M8 a, M8 b) { return { _mm256_or_ps(a.v, b.v) }; }
+
+    inline I8 operator+(I8 a, I8 b) { return { _mm256_add_epi32(a.v, b.v) }; }
+    inline I8 operator-(I8 a, I8 b) { return { _mm256_sub_epi32(a.v, b.v) }; }
+    inline I8 operator*(I8 a, I8 b) { return { _mm256_mullo_epi32(a.v, b.v) }; }
+    inline I8 operator^(I8 a, I8 b) { return { _mm256_xor_si256(a.v, b.v) }; }
+    inline I8 operator&(I8 a, I8 b) { return { _mm256_and_si256(a.v, b.v) }; }
+    inline I8 operator|(I8 a, I8 b) { return { _mm256_or_si256(a.v, b.v) }; }
+    template <int Shift> inline I8 ShiftRightArithmetic(I8 a) { return { _mm256_srai_epi32(a.v, Shift) }; }
+
+    inline F8 Min(F8 a, F8 b) { return { _mm256_min_ps(a.v, b.v) }; }
+    inline F8 Max(F8 a, F8 b) { return { _mm256_max_ps(a.v, b.v) }; }
+    inline F8 Abs(F8 a) { return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v) }; }
+    inline F8 Sqrt(F8 a) { return { _mm256_sqrt_ps(a.v) }; }
+    inline F8 Select(M8 mask, F8 a, F8 b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+    inline I8 Select(M8 mask, I8 a, I8 b) { return { _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b.v), _mm256_castsi256_ps(a.v), mask.v)) }; }
+    inline F8 Round(F8 a) { return { _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC) }; }
+    inline I8 TruncateToInt(F8 a) { return { _mm256_cvttps_epi32(a.v) }; }
+    inline I8 RoundToInt(F8 a) { return { _mm256_cvtps_epi32(a.v) }; }
+    inline F8 ToFloat(I8 a) { return { _mm256_cvtepi32_ps(a.v) }; }
+    inline F8 BitsToFloat(I8 a) { return { _mm256_castsi256_ps(a.v) }; }
+    inline bool AnyTrue(M8 mask) { return _mm256_movemask_ps(mask.v) != 0; }
+    inline F8 Gather(const float* table, I8 index) { return { _mm256_i32gather_ps(table, index.v, 4) }; }
+
+    inline I8 FastFloor(F8 a)
+    {
+        __m256i truncated = _mm256_cvttps_epi32(a.v);
+        __m256i negative = _mm256_castps_si256(_mm256_cmp_ps(a.v, _mm256_setzero_ps(), _CMP_LT_OQ));
+        return { _mm256_add_epi32(truncated, negative) };
+    }
+
+    struct AVX2Lanes
+    {
+        static constexpr int Width = 8;
+        using F = F8;
+        using I = I8;
+        using M = M8;
+
+        static F Set(float v) { return { _mm256_set1_ps(v) }; }
+        static I SetI(int32_t v) { return { _mm256_set1_epi32(v) }; }
+        static F Load(const float* p) { return { _mm256_loadu_ps(p) }; }
+        static void Store(float* p, F v) { _mm256_storeu_ps(p, v.v); }
+        static void StoreI(int32_t* p, I v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v.v); }
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Shared helpers
+    ////////////////////////////////////////////////////////////////////////////////
+
+    /// <summary>
+    /// std::lerp (P0811R3), lane-wise. Bit-identical to the MSVC/libstdc++ std::lerp for
+    /// finite input, so kernels can replace scalar code that used std::lerp.
+    /// </summary>
+    template <class L>
+    inline typename L::F LerpExact(typename L::F a, typename L::F b, float t)
+    {
+        using F = typename L::F;
+        const F zero = L::Set(0.0f);
+        const F vt = L::Set(t);
+
+        // a and b on opposite sides of zero: exact, t*b + (1-t)*a.
+        auto straddles = ((a <= zero) & (b >= zero)) | ((a >= zero) & (b <= zero));
+        F straddle = vt * b + (L::Set(1.0f) - vt) * a;
+        if (t == 1.0f)
+        {
+            return Select(straddles, straddle, b);
+        }
+
+        // Otherwise a + t*(b-a), clamped against b so the result stays monotonic near t == 1.
+        F candidate = a + vt * (b - a);
+        F monotonic = (t > 1.0f) ? Select(b > a, Max(b, candidate), Min(b, candidate))
+                                 : Select(b > a, Min(b, candidate), Max(b, candidate));
+        return Select(straddles, straddle, monotonic);
+    }
+
+    /// <summary>
+    /// Cephes-style expf, lane-wise. Max relative error is about 2 ulp against std::exp;
+    /// it is used at every width (including scalar) so widths stay bit-identical.
+    /// </summary>
+    template <class L>
+    inline typename L::F Exp(typename L::F x)
+    {
+        using F = typename L::F;
+        // Clamp so 2^n stays a normal float.
+        x = Min(x, L::Set(88.0f));
+        x = Max(x, L::Set(-87.0f));
+
+        // exp(x) = 2^n * exp(r), r = x - n*ln2
+        F n = Round(x * L::Set(1.44269504088896341f));
+        F r = x - n * L::Set(0.693359375f);
+        r = r - n * L::Set(-2.12194440e-4f);
+
+        F p = L::Set(1.9875691500E-4f);
+        p = p * r + L::Set(1.3981999507E-3f);
+        p = p * r + L::Set(8.3334519073E-3f);
+        p = p * r + L::Set(4.1665795894E-2f);
+        p = p * r + L::Set(1.6666665459E-1f);
+        p = p * r + L::Set(5.0000001201E-1f);
+        p = p * (r * r) + r + L::Set(1.0f);
+
+        // Build 2^n directly in the exponent bits.
+        auto bits = (RoundToInt(n) + L::SetI(127)) * L::SetI(1 << 23);
+        return p * BitsToFloat(bits);
+    }
+}
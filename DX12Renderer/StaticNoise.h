@@ -0,0 +1,322 @@
+#pragma once
+
+#include "FastNoiseLite.h"
+#include "NoiseGradient.h"
+
+#include <chrono>
+#include <vector>
+
+/// <summary>
+/// Compile-time counterpart of FastNoiseLite::GetNoise for 2D noise. FastNoiseLite switches on
+/// the noise type, fractal type and octave count inside every call; here they are template
+/// parameters, so each configuration compiles to one straight-line kernel with the octave loop
+/// unrolled and no per-sample branches (corner falloffs and the simplex triangle pick are selects).
+///
+/// Kernels are templated on the Simd lane types like NoiseGradient, and the batch functions run
+/// 8 (AVX2) or 4 (SSE4.1) samples per step with a scalar tail. Every width gives the same bits as
+/// FastNoiseLite::GetNoise with the matching settings under /fp:precise.
+///
+/// Supported: NoiseType_Perlin and NoiseType_OpenSimplex2, with FractalType_None or FractalType_FBm
+/// (the configurations TerrainChunk and Tutorial2::GenerateHeightmap use).
+/// </summary>
+namespace StaticNoise
+{
+    /// <summary>
+    /// Runtime settings that do not change the shape of the kernel. Defaults match FastNoiseLite.
+    /// </summary>
+    struct Settings
+    {
+        int seed = 1337;
+        float frequency = 0.01f;
+        float lacunarity = 2.0f;
+        float gain = 0.5f;
+        float weightedStrength = 0.0f;
+    };
+
+    namespace Detail
+    {
+        // FastNoiseLite::GradCoord
+        template <class L>
+        inline typename L::F GradCoord(typename L::I seed, typename L::I xPrimed, typename L::I yPrimed,
+            typename L::F xd, typename L::F yd)
+        {
+            auto index = NoiseGradient::Detail::GradIndex<L>(seed, xPrimed, yPrimed);
+            auto xg = Simd::Gather(NoiseGradient::Gradients2D, index);
+            auto yg = Simd::Gather(NoiseGradient::Gradients2D, index | L::SetI(1));
+            return xd * xg + yd * yg;
+        }
+
+        // FastNoiseLite::SingleOpenSimplex2 (2D) on skewed coordinates.
+        template <class L>
+        inline typename L::F OpenSimplex2(int seed, typename L::F x, typename L::F y)
+        {
+            using F = typename L::F;
+
+            const float SQRT3 = 1.7320508075688772935274463415059f;
+            const float G2 = (3 - SQRT3) / 6;
+            const F zero = L::Set(0.0f);
+
+            auto i = Simd::FastFloor(x);
+            auto j = Simd::FastFloor(y);
+            F xi = x - Simd::ToFloat(i);
+            F yi = y - Simd::ToFloat(j);
+
+            F t = (xi + yi) * L::Set(G2);
+            F x0 = xi - t;
+            F y0 = yi - t;
+
+            i = i * L::SetI(NoiseGradient::PrimeX);
+            j = j * L::SetI(NoiseGradient::PrimeY);
+            const auto vseed = L::SetI(seed);
+
+            F a = L::Set(0.5f) - x0 * x0 - y0 * y0;
+            F n0 = Simd::Select(a <= zero, zero, (a * a) * (a * a) * GradCoord<L>(vseed, i, j, x0, y0));
+
+            F c = L::Set((float)(2 * (1 - 2 * G2) * (1 / G2 - 2))) * t + (L::Set((float)(-2 * (1 - 2 * G2) * (1 - 2 * G2))) + a);
+            F x2 = x0 + L::Set(2 * (float)G2 - 1);
+            F y2 = y0 + L::Set(2 * (float)G2 - 1);
+            F n2 = Simd::Select(c <= zero, zero, (c * c) * (c * c) *
+                GradCoord<L>(vseed, i + L::SetI(NoiseGradient::PrimeX), j + L::SetI(NoiseGradient::PrimeY), x2, y2));
+
+            // Middle corner: (0,1) above the diagonal, (1,0) below it.
+            auto upper = y0 > x0;
+            F x1 = x0 + Simd::Select(upper, L::Set((float)G2), L::Set((float)G2 - 1));
+            F y1 = y0 + Simd::Select(upper, L::Set((float)G2 - 1), L::Set((float)G2));
+            auto i1 = i + Simd::Select(upper, L::SetI(0), L::SetI(NoiseGradient::PrimeX));
+            auto j1 = j + Simd::Select(upper, L::SetI(NoiseGradient::PrimeY), L::SetI(0));
+            F b = L::Set(0.5f) - x1 * x1 - y1 * y1;
+            F n1 = Simd::Select(b <= zero, zero, (b * b) * (b * b) * GradCoord<L>(vseed, i1, j1, x1, y1));
+
+            return (n0 + n1 + n2) * L::Set(99.83685446303647f);
+        }
+
+        // FastNoiseLite::GenNoiseSingle on transformed coordinates.
+        template <FastNoiseLite::NoiseType Noise, class L>
+        inline typename L::F Single(int seed, typename L::F x, typename L::F y)
+        {
+            if constexpr (Noise == FastNoiseLite::NoiseType_Perlin)
+            {
+                // Frequency is already applied; multiplying by 1 leaves the coordinates untouched.
+                return NoiseGradient::Perlin<L>(seed, 1.0f, x, y);
+            }
+            else
+            {
+                return OpenSimplex2<L>(seed, x, y);
+            }
+        }
+
+        // FastNoiseLite::CalculateFractalBounding
+        inline float FractalBounding(int octaves, float gain)
+        {
+            float g = gain < 0 ? -gain : gain;
+            float amp = g;
+            float ampFractal = 1.0f;
+            for (int i = 1; i < octaves; i++)
+            {
+                ampFractal += amp;
+                amp *= g;
+            }
+            return 1 / ampFractal;
+        }
+    }
+
+    template <FastNoiseLite::NoiseType Noise, FastNoiseLite::FractalType Fractal, int Octaves = 1>
+    class Generator
+    {
+        static_assert(Noise == FastNoiseLite::NoiseType_Perlin || Noise == FastNoiseLite::NoiseType_OpenSimplex2,
+            "StaticNoise supports Perlin and OpenSimplex2");
+        static_assert(Fractal == FastNoiseLite::FractalType_None || Fractal == FastNoiseLite::FractalType_FBm,
+            "StaticNoise supports FractalType_None and FractalType_FBm");
+        static_assert(Octaves >= 1, "at least one octave");
+
+    public:
+        explicit Generator(const Settings& settings = Settings())
+            : m_settings(settings)
+            , m_fractalBounding(Detail::FractalBounding(Octaves, settings.gain))
+        {
+        }
+
+        const Settings& GetSettings() const { return m_settings; }
+
+        /// <summary>
+        /// Configures a FastNoiseLite instance to produce the same noise, for comparisons.
+        /// </summary>
+        void Configure(FastNoiseLite& noise) const
+        {
+            noise.SetSeed(m_settings.seed);
+            noise.SetFrequency(m_settings.frequency);
+            noise.SetNoiseType(Noise);
+            noise.SetFractalType(Fractal);
+            noise.SetFractalOctaves(Octaves);
+            noise.SetFractalLacunarity(m_settings.lacunarity);
+            noise.SetFractalGain(m_settings.gain);
+            noise.SetFractalWeightedStrength(m_settings.weightedStrength);
+        }
+
+        /// <summary>
+        /// FastNoiseLite::GetNoise(x, y), one sample per lane.
+        /// </summary>
+        template <class L>
+        typename L::F Evaluate(typename L::F x, typename L::F y) const
+        {
+            using F = typename L::F;
+
+            // FastNoiseLite::TransformNoiseCoordinate
+            x = x * L::Set(m_settings.frequency);
+            y = y * L::Set(m_settings.frequency);
+            if constexpr (Noise == FastNoiseLite::NoiseType_OpenSimplex2)
+            {
+                const float SQRT3 = (float)1.7320508075688772935274463415059;
+                const float F2 = 0.5f * (SQRT3 - 1);
+                F t = (x + y) * L::Set(F2);
+                x = x + t;
+                y = y + t;
+            }
+
+            if constexpr (Fractal == FastNoiseLite::FractalType_None)
+            {
+                return Detail::Single<Noise, L>(m_settings.seed, x, y);
+            }
+            else
+            {
+                // FastNoiseLite::GenFractalFBm
+                const F one = L::Set(1.0f);
+                F sum = L::Set(0.0f);
+                F amp = L::Set(m_fractalBounding);
+                for (int i = 0; i < Octaves; i++)
+                {
+                    F noise = Detail::Single<Noise, L>(m_settings.seed + i, x, y);
+                    sum = sum + noise * amp;
+                    F weight = Simd::Min(noise + one, L::Set(2.0f)) * L::Set(0.5f);
+                    amp = amp * (one + L::Set(m_settings.weightedStrength) * (weight - one));
+
+                    x = x * L::Set(m_settings.lacunarity);
+                    y = y * L::Set(m_settings.lacunarity);
+                    amp = amp * L::Set(m_settings.gain);
+                }
+                return sum;
+            }
+        }
+
+        float GetNoise(float x, float y) const
+        {
+            return Evaluate<Simd::ScalarLanes>(x, y);
+        }
+
+        /// <summary>
+        /// out[i] = GetNoise(x[i], y[i]).
+        /// </summary>
+        void GetNoise(const float* x, const float* y, float* out, int count) const
+        {
+            Run(count, [&](auto lanes, int i) {
+                using L = decltype(lanes);
+                return Evaluate<L>(L::Load(x + i), L::Load(y + i));
+            }, out);
+        }
+
+        /// <summary>
+        /// out[i] = GetNoise(x[i], y), for filling a heightmap row by row.
+        /// </summary>
+        void GetNoiseRow(const float* x, float y, float* out, int count) const
+        {
+            Run(count, [&](auto lanes, int i) {
+                using L = decltype(lanes);
+                return Evaluate<L>(L::Load(x + i), L::Set(y));
+            }, out);
+        }
+
+    private:
+        template <class L, class Kernel>
+        static int RunBlocks(int first, int count, const Kernel& kernel, float* out)
+        {
+            int i = first;
+            for (; i + L::Width <= count; i += L::Width)
+                L::Store(out + i, kernel(L(), i));
+            return i;
+        }
+
+        template <class Kernel>
+        static void Run(int count, const Kernel& kernel, float* out)
+        {
+            int i = 0;
+            switch (Simd::GetSupportedLevel())
+            {
+            case Simd::Level::AVX2:
+                i = RunBlocks<Simd::AVX2Lanes>(i, count, kernel, out);
+                break;
+            case Simd::Level::SSE41:
+                i = RunBlocks<Simd::SSE41Lanes>(i, count, kernel, out);
+                break;
+            default:
+                break;
+            }
+            RunBlocks<Simd::ScalarLanes>(i, count, kernel, out);
+        }
+
+        Settings m_settings;
+        float m_fractalBounding;
+    };
+
+    /// <summary>
+    /// Timing of FastNoiseLite::GetNoise against Generator on the same grid.
+    /// </summary>
+    struct BenchmarkResult
+    {
+        double dynamicMs = 0.0;   // FastNoiseLite::GetNoise, one call per sample
+        double scalarMs = 0.0;    // Generator::GetNoise(x, y), one call per sample
+        double batchMs = 0.0;     // Generator::GetNoiseRow
+        int mismatches = 0;       // Samples where either Generator path differs from FastNoiseLite
+    };
+
+    /// <summary>
+    /// Fills a width x height grid at (x * scale / width, y * scale / height), the sampling
+    /// Tutorial2::GenerateHeightmap uses, with each path and compares the results bit for bit.
+    /// </summary>
+    template <FastNoiseLite::NoiseType Noise, FastNoiseLite::FractalType Fractal, int Octaves>
+    BenchmarkResult Benchmark(const Generator<Noise, Fractal, Octaves>& generator, int width, int height, float scale)
+    {
+        using Clock = std::chrono::steady_clock;
+        using Ms = std::chrono::duration<double, std::milli>;
+
+        FastNoiseLite reference;
+        generator.Configure(reference);
+
+        std::vector<float> xs(width);
+        for (int x = 0; x < width; ++x)
+            xs[x] = (float)x / (float)width * scale;
+
+        const size_t size = (size_t)width * height;
+        std::vector<float> dynamicOut(size), scalarOut(size), batchOut(size);
+        BenchmarkResult result;
+
+        auto start = Clock::now();
+        for (int y = 0; y < height; ++y)
+        {
+            const float fy = (float)y / (float)height * scale;
+            for (int x = 0; x < width; ++x)
+                dynamicOut[(size_t)y * width + x] = reference.GetNoise(xs[x], fy);
+        }
+        result.dynamicMs = Ms(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int y = 0; y < height; ++y)
+        {
+            const float fy = (float)y / (float)height * scale;
+            for (int x = 0; x < width; ++x)
+                scalarOut[(size_t)y * width + x] = generator.GetNoise(xs[x], fy);
+        }
+        result.scalarMs = Ms(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int y = 0; y < height; ++y)
+            generator.GetNoiseRow(xs.data(), (float)y / (float)height * scale, &batchOut[(size_t)y * width], width);
+        result.batchMs = Ms(Clock::now() - start).count();
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (scalarOut[i] != dynamicOut[i] || batchOut[i] != dynamicOut[i])
+                ++result.mismatches;
+        }
+        return result;
+    }
+}
@@ -1,153 +1,201 @@
-#include "Texture.h"
-#include "d3dx12.h"
-#include "Helpers.h"
-#include "DXAccess.h"
-#include "DescriptorHeap.h"
-#include "CommandQueue.h"
-#include "Application.h"
-
-
-struct Texture::TexData
-{
-	ComPtr<ID3D12Resource> m_texture;
-};
-
-Texture::Texture(std::string path, std::vector<uint8_t> data, XMFLOAT2 imageSize)
-{
-	m_data = new TexData();
-	m_imageSize = imageSize;
-	m_path = path;
-
-	ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
-	std::shared_ptr<DescriptorHeap> SRVHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE::D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-	std::shared_ptr<CommandQueue> commands = Application::Get().GetCommandQueue();
-
-	D3D12_HEAP_PROPERTIES properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, imageSize.x, imageSize.y);
-
-	ThrowIfFailed(device->CreateCommittedResource(
-		&properties,
-		D3D12_HEAP_FLAG_NONE,
-		&desc,
-		D3D12_RESOURCE_STATE_COMMON,
-		nullptr,
-		IID_PPV_ARGS(&m_data->m_texture)));
-
-	D3D12_SUBRESOURCE_DATA subresource;
-	subresource.pData = data.data();
-	subresource.RowPitch = imageSize.x * sizeof(uint32_t);
-	subresource.SlicePitch = imageSize.x * imageSize.y * sizeof(uint32_t);
-
-	commands->UploadData(m_data->m_texture, subresource);
-
-	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-	srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-	srvDesc.Texture2D.MipLevels = 1; // for now...
-
-	m_descriptorIndex = SRVHeap->GetNextIndex();
-	device->CreateShaderResourceView(m_data->m_texture.Get(), &srvDesc, SRVHeap->GetCPUHandleAt(m_descriptorIndex));
-	m_data->m_texture.Get()->SetName(L"Texture Resource Heap");
-}
-
-Texture::Texture(const std::vector<uint8_t>& data, XMFLOAT2 imageSize)
-{
-    m_data = new TexData();
-    m_imageSize = imageSize;
-
-    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
-    auto SRVHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
-
-    // Describe the texture resource
-    D3D12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-    D3D12_RESOURCE_DESC textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(
-        DXGI_FORMAT_R8G8B8A8_UNORM,
-        static_cast<UINT>(imageSize.x),
-        static_cast<UINT>(imageSize.y)
-    );
-
-    ThrowIfFailed(device->CreateCommittedResource(
-        &heapProps,
-        D3D12_HEAP_FLAG_NONE,
-        &textureDesc,
-        D3D12_RESOURCE_STATE_COMMON,
-        nullptr,
-        IID_PPV_ARGS(&m_data->m_texture)));
-
-    // Fill in subresource
-    D3D12_SUBRESOURCE_DATA subresource = {};
-    subresource.pData = data.data();
-    //subresource.RowPitch = static_cast<LONG_PTR>(imageSize.x) * sizeof(uint32_t);
-    //subresource.SlicePitch = static_cast<LONG_PTR>(imageSize.x) * imageSize.y * sizeof(uint32_t);
-    UINT rowPitch = static_cast<UINT>(imageSize.x) * sizeof(uint32_t);
-    UINT slicePitch = rowPitch * static_cast<UINT>(imageSize.y);
-
-    subresource.RowPitch = rowPitch;
-    subresource.SlicePitch = slicePitch;
-
-    // Upload to GPU
-    commands->UploadData(m_data->m_texture, subresource);
-
-    // SRV descriptor
-    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-    srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-    srvDesc.Texture2D.MipLevels = 1;
-
-    m_descriptorIndex = SRVHeap->GetNextIndex();
-    device->CreateShaderResourceView(m_data->m_texture.Get(), &srvDesc, SRVHeap->GetCPUHandleAt(m_descriptorIndex));
-
-    m_data->m_texture->SetName(L"Procedural Texture Resource");
-}
-
-void Texture::Shutdown()
-{
-    // 1) Wait for GPU to finish any work that might reference this texture.
-    //    Caller should ideally do this; but you can do it here if you have access:
-    Application::Get().FlushA();
-
-    // 2) Free SRV descriptor from heap:
-    if (m_descriptorIndex != UINT32_MAX)
-    {
-        auto srvHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-        // Ensure DescriptorHeap has a FreeIndex or equivalent method:
-        srvHeap->FreeIndex(m_descriptorIndex);
-        m_descriptorIndex = UINT32_MAX;
-    }
-
-    // 3) Release the GPU resource:
-    if (m_data)
-    {
-        m_data->m_texture.Reset(); // release ID3D12Resource
-        delete m_data;
-        m_data = nullptr;
-    }
-
-    // 4) Clear other fields if needed:
-    m_path.clear();
-    m_imageSize = { 0,0 };
-}
-
-Texture::~Texture()
-{
-	//delete m_data;
-	//m_data = nullptr;
-}
-
-void* Texture::GetTexture() const
-{
-	return (void*)m_data->m_texture.Get();
-}
-
-std::string Texture::GetPath() const
-{
-	return m_path;
-}
-
-XMFLOAT2 Texture::GetSize() const
-{
-	return m_imageSize;
+#include "Texture.h"
+#include "d3dx12.h"
+#include "Helpers.h"
+#include "DXAccess.h"
+#include "DescriptorHeap.h"
+#include "CommandQueue.h"
+#include "Application.h"
+#include "ResourceStateTracker.h"
+
+#include <cassert>
+
+
+struct Texture::TexData
+{
+	ComPtr<ID3D12Resource> m_texture;
+};
+
+namespace
+{
+    UINT BytesPerPixel(DXGI_FORMAT format)
+    {
+        switch (format)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_R32_FLOAT:
+            return 4;
+        case DXGI_FORMAT_R16_UNORM:
+        case DXGI_FORMAT_R16_FLOAT:
+        case DXGI_FORMAT_R8G8_UNORM:
+            return 2;
+        default:
+            assert(false && "Unsupported procedural texture format");
+            return 4;
+        }
+    }
+}
+
+Texture::Texture(std::string path, std::vector<uint8_t> data, XMFLOAT2 imageSize)
+{
+	m_data = new TexData();
+	m_imageSize = imageSize;
+	m_path = path;
+
+	ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+	std::shared_ptr<DescriptorHeap> SRVHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE::D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	std::shared_ptr<CommandQueue> commands = Application::Get().GetCommandQueue();
+
+	D3D12_HEAP_PROPERTIES properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+	D3D12_RESOURCE_DESC desc = CD3DX12_RESOURCE_DESC::Tex2D(DXGI_FORMAT_R8G8B8A8_UNORM, imageSize.x, imageSize.y);
+
+	ThrowIfFailed(device->CreateCommittedResource(
+		&properties,
+		D3D12_HEAP_FLAG_NONE,
+		&desc,
+		D3D12_RESOURCE_STATE_COMMON,
+		nullptr,
+		IID_PPV_ARGS(&m_data->m_texture)));
+	ResourceStateTracker::AddGlobalResourceState(m_data->m_texture.Get(), D3D12_RESOURCE_STATE_COMMON);
+
+	D3D12_SUBRESOURCE_DATA subresource;
+	subresource.pData = data.data();
+	subresource.RowPitch = imageSize.x * sizeof(uint32_t);
+	subresource.SlicePitch = imageSize.x * imageSize.y * sizeof(uint32_t);
+
+	commands->UploadData(m_data->m_texture, subresource);
+
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+	srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Texture2D.MipLevels = 1; // for now...
+
+	m_descriptorIndex = SRVHeap->GetNextIndex();
+	device->CreateShaderResourceView(m_data->m_texture.Get(), &srvDesc, SRVHeap->GetCPUHandleAt(m_descriptorIndex));
+	m_data->m_texture.Get()->SetName(L"Texture Resource Heap");
+}
+
+Texture::Texture(const std::vector<uint8_t>& data, XMFLOAT2 imageSize, DXGI_FORMAT format)
+{
+    m_data = new TexData();
+    m_imageSize = imageSize;
+    m_format = format;
+
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+    auto SRVHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    // Describe the texture resource
+    D3D12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    D3D12_RESOURCE_DESC textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(
+        format,
+        static_cast<UINT>(imageSize.x),
+        static_cast<UINT>(imageSize.y)
+    );
+
+    ThrowIfFailed(device->CreateCommittedResource(
+        &heapProps,
+        D3D12_HEAP_FLAG_NONE,
+        &textureDesc,
+        D3D12_RESOURCE_STATE_COMMON,
+        nullptr,
+        IID_PPV_ARGS(&m_data->m_texture)));
+    ResourceStateTracker::AddGlobalResourceState(m_data->m_texture.Get(), D3D12_RESOURCE_STATE_COMMON);
+
+    // Fill in subresource
+    D3D12_SUBRESOURCE_DATA subresource = {};
+    subresource.pData = data.data();
+    //subresource.RowPitch = static_cast<LONG_PTR>(imageSize.x) * sizeof(uint32_t);
+    //subresource.SlicePitch = static_cast<LONG_PTR>(imageSize.x) * imageSize.y * sizeof(uint32_t);
+    UINT rowPitch = static_cast<UINT>(imageSize.x) * BytesPerPixel(format);
+    assert(data.size() >= size_t(rowPitch) * static_cast<UINT>(imageSize.y));
+    UINT slicePitch = rowPitch * static_cast<UINT>(imageSize.y);
+
+    subresource.RowPitch = rowPitch;
+    subresource.SlicePitch = slicePitch;
+
+    // Upload to GPU
+    commands->UploadData(m_data->m_texture, subresource);
+
+    // SRV descriptor
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = format;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels = 1;
+
+    m_descriptorIndex = SRVHeap->GetNextIndex();
+    device->CreateShaderResourceView(m_data->m_texture.Get(), &srvDesc, SRVHeap->GetCPUHandleAt(m_descriptorIndex));
+
+    m_data->m_texture->SetName(L"Procedural Texture Resource");
+}
+
+uint64_t Texture::Update(const void* data, size_t size, ID3D12Resource* uploadBuffer, UINT64 uploadOffset)
+{
+    assert(m_data && m_data->m_texture);
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    UINT rowPitch = static_cast<UINT>(m_imageSize.x) * BytesPerPixel(m_format);
+    assert(size >= size_t(rowPitch) * static_cast<UINT>(m_imageSize.y));
+
+    D3D12_SUBRESOURCE_DATA subresource = {};
+    subresource.pData = data;
+    subresource.RowPitch = rowPitch;
+    subresource.SlicePitch = rowPitch * static_cast<UINT>(m_imageSize.y);
+
+    return commands->UploadData(m_data->m_texture.Get(), uploadBuffer, uploadOffset, subresource);
+}
+
+void Texture::Shutdown()
+{
+    // The GPU may still be reading this texture from frames in flight, so the descriptor slot
+    // and the resource are retired on the queue and released once its fence passes.
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    // 1) Free SRV descriptor from heap:
+    if (m_descriptorIndex != UINT32_MAX)
+    {
+        auto srvHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+        commands->FreeDescriptorDeferred(srvHeap, m_descriptorIndex);
+        m_descriptorIndex = UINT32_MAX;
+    }
+
+    // 2) Release the GPU resource:
+    if (m_data)
+    {
+        ResourceStateTracker::RemoveGlobalResourceState(m_data->m_texture.Get());
+        commands->ReleaseDeferred(std::move(m_data->m_texture));
+        delete m_data;
+        m_data = nullptr;
+    }
+
+    // 3) Clear other fields if needed:
+    m_path.clear();
+    m_imageSize = { 0,0 };
+}
+
+Texture::~Texture()
+{
+	//delete m_data;
+	//m_data = nullptr;
+}
+
+void* Texture::GetTexture() const
+{
+	return (void*)m_data->m_texture.Get();
+}
+
+std::string Texture::GetPath() const
+{
+	return m_path;
+}
+
+XMFLOAT2 Texture::GetSize() const
+{
+	return m_imageSize;
+}
+
+DXGI_FORMAT Texture::GetFormat() const
+{
+	return m_format;
 }
\ No newline at end of file
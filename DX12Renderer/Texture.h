@@ -1,31 +1,38 @@
-#pragma once
-#include <string>
-#include <vector>
-#include <DirectXMath.h>
-#include <d3d12.h>
-#include <wrl.h>
-
-using namespace DirectX;
-using namespace Microsoft::WRL;
-
-class Texture
-{
-public:
-	Texture() = default;
-	Texture(std::string path, std::vector<uint8_t> data, XMFLOAT2 imageSize);
-	Texture(const std::vector<uint8_t>& data, XMFLOAT2 imageSize);
-	// Explicitly release GPU resources and descriptor
-	void Shutdown();
-	~Texture();
-	void* GetTexture() const;
-	std::string GetPath() const;
-	XMFLOAT2 GetSize() const;
-
-	uint32_t m_descriptorIndex;
-private:
-	struct TexData;
-	ComPtr<ID3D12Resource> m_texture;
-	std::string m_path;
-	XMFLOAT2 m_imageSize;
-	TexData* m_data;
+#pragma once
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+#include <d3d12.h>
+#include <wrl.h>
+
+using namespace DirectX;
+using namespace Microsoft::WRL;
+
+class Texture
+{
+public:
+	Texture() = default;
+	Texture(std::string path, std::vector<uint8_t> data, XMFLOAT2 imageSize);
+	// Procedural texture from tightly packed texels in the given format (RGBA8, RG8, R16_UNORM, R16_FLOAT, R32_FLOAT)
+	Texture(const std::vector<uint8_t>& data, XMFLOAT2 imageSize, DXGI_FORMAT format = DXGI_FORMAT_R8G8B8A8_UNORM);
+	// Rewrites a procedural texture's texels in place (same size and format, descriptor unchanged),
+	// copying size bytes of data straight into uploadBuffer at uploadOffset. Returns the fence value
+	// after which that part of the upload buffer is free again. See CommandQueue::UploadData.
+	uint64_t Update(const void* data, size_t size, ID3D12Resource* uploadBuffer, UINT64 uploadOffset);
+	// Explicitly release GPU resources and descriptor
+	void Shutdown();
+	~Texture();
+	void* GetTexture() const;
+	std::string GetPath() const;
+	XMFLOAT2 GetSize() const;
+	DXGI_FORMAT GetFormat() const;
+
+	uint32_t m_descriptorIndex;
+private:
+	struct TexData;
+	ComPtr<ID3D12Resource> m_texture;
+	std::string m_path;
+	XMFLOAT2 m_imageSize;
+	DXGI_FORMAT m_format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	TexData* m_data;
 };
\ No newline at end of file
@@ -0,0 +1,119 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned threadCount)
+    : m_Stop(false)
+{
+    if (threadCount == 0)
+    {
+        unsigned hardwareThreads = std::thread::hardware_concurrency();
+        threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_Threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        m_Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Condition.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+ThreadPool& ThreadPool::Get()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+unsigned ThreadPool::GetThreadCount() const
+{
+    return static_cast<unsigned>(m_Threads.size());
+}
+
+void ThreadPool::Submit(std::function<void()> job)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Jobs.push_back(std::move(job));
+    }
+    m_Condition.notify_one();
+}
+
+void ThreadPool::ParallelFor(int count, int grain, const std::function<void(int, int)>& func)
+{
+    if (count <= 0)
+        return;
+
+    grain = std::max(grain, 1);
+    const int rangeCount = (count + grain - 1) / grain;
+
+    // Shared with the helper jobs, which may only start after this call has returned.
+    struct State
+    {
+        std::atomic<int> next{ 0 };
+        std::atomic<int> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<State>();
+
+    // 'func' is only touched after claiming a range, and every range is claimed before
+    // this call returns, so late helpers never see a dangling reference.
+    auto runRanges = [state, count, grain, rangeCount, &func]()
+    {
+        for (int range = state->next.fetch_add(1); range < rangeCount; range = state->next.fetch_add(1))
+        {
+            const int begin = range * grain;
+            func(begin, std::min(begin + grain, count));
+
+            if (state->done.fetch_add(1) + 1 == rangeCount)
+            {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    const int helpers = std::min<int>(rangeCount - 1, static_cast<int>(m_Threads.size()));
+    for (int i = 0; i < helpers; ++i)
+    {
+        Submit(runRanges);
+    }
+
+    runRanges();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state, rangeCount]() { return state->done.load() == rangeCount; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+    for (;;)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Condition.wait(lock, [this]() { return m_Stop || !m_Jobs.empty(); });
+            if (m_Stop && m_Jobs.empty())
+                return;
+
+            job = std::move(m_Jobs.front());
+            m_Jobs.pop_front();
+        }
+        job();
+    }
+}
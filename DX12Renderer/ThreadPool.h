@@ -0,0 +1,50 @@
+/**
+ * Fixed set of worker threads for CPU jobs (terrain generation, streaming, recording).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    // threadCount == 0 uses one worker per hardware thread, minus the calling thread.
+    explicit ThreadPool(unsigned threadCount = 0);
+    virtual ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Shared pool used by the engine. Created on first use.
+    static ThreadPool& Get();
+
+    unsigned GetThreadCount() const;
+
+    /// <summary>
+    /// Queue a job for the workers. Jobs run in submission order, but may finish in any order.
+    /// </summary>
+    void Submit(std::function<void()> job);
+
+    /// <summary>
+    /// Split [0, count) into ranges of at most 'grain' items and call func(begin, end) for each,
+    /// on the workers and the calling thread. Returns once every range has run.
+    /// The calling thread keeps claiming ranges itself, so this is safe to call from a job.
+    /// </summary>
+    void ParallelFor(int count, int grain, const std::function<void(int, int)>& func);
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread>            m_Threads;
+    std::deque<std::function<void()>>   m_Jobs;
+    std::mutex                          m_Mutex;
+    std::condition_variable             m_Condition;
+    bool                                m_Stop;
+};
@@ -1,246 +1,353 @@
-#pragma once
-
-#include "Game.h"
-#include "Window.h"
-#include "Mesh.h"
-#include "PipelineState.h"
-#include "../PSOSkybox.h"
-#include "../PSOShadowMap.h"
-#include "../Light.h"
-
-#include <DirectXMath.h>
-#include "../Camera.h"
-
-#include "../UploadBuffer.h"
-#include "../ShadowMap.h"
-#include "../PSOTerrain.h"
-#include "../PSOTerrainShadowMap.h"
-#include "../TerrainChunkManager.h"
-
-#include "FastNoiseLite.h"
-
-class Mesh;
-
-struct LightProperties
-{
-    uint32_t NumPointLights;
-    uint32_t NumSpotLights;
-    uint32_t NumDirectionalLights;
-};
-
-// An enum for root signature parameters.
-// I'm not using scoped enums to avoid the explicit cast that would be required
-// to use these as root indices in the root signature.
-enum RootParameters
-{
-    MatricesCB,         // ConstantBuffer<Mat> MatCB : register(b0);
-    MaterialCB,         // ConstantBuffer<Material> MaterialCB : register( b0, space1 );
-    LightPropertiesCB,  // ConstantBuffer<LightProperties> LightPropertiesCB : register( b1 );
-    PointLights,        // StructuredBuffer<PointLight> PointLights : register( t0 );
-    SpotLights,         // StructuredBuffer<SpotLight> SpotLights : register( t1 );
-    Textures,           // Texture2D DiffuseTexture : register( t2 );
-    NumRootParameters
-};
-
-class Tutorial2 : public Game
-{
-public:
-    using super = Game;
-
-    Tutorial2(const std::wstring& name, int width, int height, bool vSync = false);
-    /**
-     *  Load content required for the demo.
-     */
-    virtual bool LoadContent() override;
-
-    /**
-     *  Unload demo specific content that was loaded in LoadContent.
-     */
-    virtual void UnloadContent() override;
-
-    struct MeshData
-    {
-        std::vector<VertexPosColor> Vertices;
-        std::vector<UINT> Indices32;
-
-        std::vector<UINT>& GetIndices16()
-        {
-            if (mIndices16.empty())
-            {
-                mIndices16.resize(Indices32.size());
-                for (size_t i = 0; i < Indices32.size(); ++i)
-                    mIndices16[i] = static_cast<UINT>(Indices32[i]);
-            }
-
-            return mIndices16;
-        }
-
-    private:
-        std::vector<UINT> mIndices16;
-    };
-
-    MeshData CreateBox(float width, float height, float depth, UINT numSubdivisions);
-
-    void Subdivide(MeshData& meshData);
-    VertexPosColor MidPoint(const VertexPosColor& v0, const VertexPosColor& v1);
-
-    std::vector<float> Tutorial2::GenerateHeightmap(FastNoiseLite::NoiseType noiseType, int width, int height);
-
-    void Tutorial2::BuildFrustumPlanes(const XMMATRIX& view, const XMMATRIX& proj, std::array<XMFLOAT4, 6>& outPlanes);
-
-    bool Tutorial2::IsBoxInsideFrustum(float minX, float minY, float minZ, float maxX, float maxY, float maxZ, const std::array<XMFLOAT4, 6>& planes);
-
-    //Descriptor Heap for textures
-    std::shared_ptr<ID3D12DescriptorHeap> m_SRVHeap;
-
-protected:
-    /**
-     *  Update the game logic.
-     */
-    virtual void OnUpdate(UpdateEventArgs& e) override;
-
-    /**
-     *  Render stuff.
-     */
-    virtual void OnRender(RenderEventArgs& e) override;
-
-    /**
-     * Invoked by the registered window when a key is pressed
-     * while the window has focus.
-     */
-    virtual void OnKeyPressed(KeyEventArgs& e) override;
-
-    virtual void OnKeyReleased(KeyEventArgs& e) override;
-
-    virtual void OnMouseMoved(MouseMotionEventArgs& e) override;
-
-    /**
-     * Invoked when the mouse wheel is scrolled while the registered window has focus.
-     */
-    virtual void OnMouseWheel(MouseWheelEventArgs& e) override;
-
-
-    virtual void OnResize(ResizeEventArgs& e) override;
-
-private:
-    // Helper functions
-    // Transition a resource
-    void TransitionResource(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
-        Microsoft::WRL::ComPtr<ID3D12Resource> resource,
-        D3D12_RESOURCE_STATES beforeState, D3D12_RESOURCE_STATES afterState);
-
-    // Clear a render target view.
-    void ClearRTV(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
-        D3D12_CPU_DESCRIPTOR_HANDLE rtv, FLOAT* clearColor);
-
-    // Clear the depth of a depth-stencil view.
-    void ClearDepth(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
-        D3D12_CPU_DESCRIPTOR_HANDLE dsv, FLOAT depth = 1.0f);
-
-    // Create a GPU buffer.
-    void UpdateBufferResource(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
-        ID3D12Resource** pDestinationResource, ID3D12Resource** pIntermediateResource,
-        size_t numElements, size_t elementSize, const void* bufferData,
-        D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE);
-
-    // Resize the depth buffer to match the size of the client area.
-    void ResizeDepthBuffer(int width, int height);
-
-    void ComputeLightSpaceMatrix();
-
-    uint64_t m_FenceValues[Window::BufferCount] = {};
-
-    // Heightmap / Terrain
-    std::vector<Mesh> m_Terrain;
-    TerrainChunkManager m_TerrainChunkManager;
-    std::vector<float> m_HeightmapData;
-    std::shared_ptr<PSOTerrain> m_TerrainPipelineState;
-    const Texture* m_TerrainGrassTexture;
-    const Texture* m_TerrainBlendTexture;
-    const Texture* m_TerrainRockTexture;
-
-    // Terrain Shadow Map
-    std::unique_ptr<ShadowMap> m_TerrainShadowMap;
-    uint32_t m_TerrainShadowMapCPUSRVDescriptorIndex;
-    uint32_t m_TerrainShadowMapGPUSRVDescriptorIndex;
-    uint32_t m_TerrainShadowMapCPUDSVDescriptorIndex;
-    std::shared_ptr<PSOTerrainShadowMap> m_TerrainShadowMapPipelineState;
-
-    // Terrain Noise Heihtmap
-    FastNoiseLite m_Noise;
-
-    // Skybox
-    Mesh m_SkyBoxMesh;
-    ComPtr<ID3D12Resource> m_SkyTexture;
-    ID3D12Resource* m_SkyTexture2;
-    uint32_t m_SkyDescriptorIndex;
-
-    std::shared_ptr<PSOSkybox> m_SkyboxPipelineState;
-
-    //Shadow Map
-    std::unique_ptr<ShadowMap> m_ShadowMap;
-    uint32_t m_ShadowMapCPUSRVDescriptorIndex;
-    uint32_t m_ShadowMapGPUSRVDescriptorIndex;
-    uint32_t m_ShadowMapCPUDSVDescriptorIndex;
-    std::shared_ptr<PSOShadowMap> m_ShadowMapPipelineState;
-
-    // Depth buffer.
-    Microsoft::WRL::ComPtr<ID3D12Resource> m_DepthBuffer;
-    // Descriptor heap for depth buffer.
-    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_DSVHeap;
-
-    // Root signature
-    Microsoft::WRL::ComPtr<ID3D12RootSignature> m_RootSignature;
-
-    // Pipeline state object.
-    //Microsoft::WRL::ComPtr<ID3D12PipelineState> m_PipelineState;
-    //Microsoft::WRL::ComPtr<PipelineState> m_PipelineState;
-    std::shared_ptr<PipelineState> m_PipelineState;
-
-    D3D12_VIEWPORT m_Viewport;
-    D3D12_RECT m_ScissorRect;
-
-    Camera m_Camera;
-    struct alignas(16) CameraData
-    {
-        DirectX::XMVECTOR m_InitialCamPos;
-        DirectX::XMVECTOR m_InitialCamRot;
-    };
-    CameraData* m_pAlignedCameraData;
-
-    float m_FoV;
-
-    int  m_Width;
-    int  m_Height;
-
-    // Camera controller
-    float m_Forward;
-    float m_Backward;
-    float m_Left;
-    float m_Right;
-    float m_Up;
-    float m_Down;
-
-    float m_Pitch;
-    float m_Yaw;
-    int m_PreviousMouseX;
-    int m_PreviousMouseY;
-
-    bool m_Shift;
-    bool g_AllowFullscreenToggle;
-    bool m_VSync;
-
-    DirectX::XMMATRIX m_ModelMatrix;
-    DirectX::XMMATRIX m_ViewMatrix;
-    DirectX::XMMATRIX m_ProjectionMatrix;
-
-    DirectX::XMMATRIX m_LightViewProj;
-
-    // Define some lights.
-    std::vector<PointLight> m_PointLights;
-    std::vector<SpotLight>  m_SpotLights;
-    std::vector<DirectionalLight>  m_DirectionalLights;
-    std::unique_ptr<UploadBuffer> m_UploadBuffer;
-
-    bool m_ContentLoaded;
+#pragma once
+
+#include "Game.h"
+#include "Window.h"
+#include "Mesh.h"
+#include "PipelineState.h"
+#include "../PSOSkybox.h"
+#include "../PSOShadowMap.h"
+#include "../Light.h"
+
+#include <DirectXMath.h>
+#include "../Camera.h"
+
+#include "../UploadBuffer.h"
+#include "../ShadowMap.h"
+#include "../PSOTerrain.h"
+#include "../PSOTerrainShadowMap.h"
+#include "../TerrainChunkManager.h"
+#include "../PSOTerrainClipmap.h"
+#include "../TerrainClipmapRenderer.h"
+
+#include "StaticNoise.h"
+#include "ResourceStateTracker.h"
+#include "RenderGraph.h"
+#include "WorkerGroup.h"
+
+class Mesh;
+
+struct LightProperties
+{
+    uint32_t NumPointLights;
+    uint32_t NumSpotLights;
+    uint32_t NumDirectionalLights;
+};
+
+// An enum for root signature parameters.
+// I'm not using scoped enums to avoid the explicit cast that would be required
+// to use these as root indices in the root signature.
+enum RootParameters
+{
+    MatricesCB,         // ConstantBuffer<Mat> MatCB : register(b0);
+    MaterialCB,         // ConstantBuffer<Material> MaterialCB : register( b0, space1 );
+    LightPropertiesCB,  // ConstantBuffer<LightProperties> LightPropertiesCB : register( b1 );
+    PointLights,        // StructuredBuffer<PointLight> PointLights : register( t0 );
+    SpotLights,         // StructuredBuffer<SpotLight> SpotLights : register( t1 );
+    Textures,           // Texture2D DiffuseTexture : register( t2 );
+    NumRootParameters
+};
+
+class Tutorial2 : public Game
+{
+public:
+    using super = Game;
+
+    Tutorial2(const std::wstring& name, int width, int height, bool vSync = false);
+
+    /**
+     *  Lets key B run the heightmap noise benchmark (main.cpp enables it for -benchmark).
+     */
+    void SetNoiseBenchmarkEnabled(bool enabled) { m_NoiseBenchmarkEnabled = enabled; }
+
+    /**
+     *  Barrier traffic of the last frame submitted, summed over all of its command lists.
+     */
+    const ResourceBarrierBatch::Stats& GetFrameBarrierStats() const { return m_FrameBarrierStats; }
+    /**
+     *  Load content required for the demo.
+     */
+    virtual bool LoadContent() override;
+
+    /**
+     *  Unload demo specific content that was loaded in LoadContent.
+     */
+    virtual void UnloadContent() override;
+
+    struct MeshData
+    {
+        std::vector<VertexPosColor> Vertices;
+        std::vector<UINT> Indices32;
+
+        std::vector<UINT>& GetIndices16()
+        {
+            if (mIndices16.empty())
+            {
+                mIndices16.resize(Indices32.size());
+                for (size_t i = 0; i < Indices32.size(); ++i)
+                    mIndices16[i] = static_cast<UINT>(Indices32[i]);
+            }
+
+            return mIndices16;
+        }
+
+    private:
+        std::vector<UINT> mIndices16;
+    };
+
+    MeshData CreateBox(float width, float height, float depth, UINT numSubdivisions);
+
+    void Subdivide(MeshData& meshData);
+    VertexPosColor MidPoint(const VertexPosColor& v0, const VertexPosColor& v1);
+
+    // Noise behind GenerateHeightmap, fixed at compile time (see StaticNoise.h)
+    using HeightmapNoise = StaticNoise::Generator<FastNoiseLite::NoiseType_OpenSimplex2, FastNoiseLite::FractalType_FBm, 4>;
+
+    std::vector<float> Tutorial2::GenerateHeightmap(int width, int height);
+
+    // Times GenerateHeightmap's noise through FastNoiseLite and HeightmapNoise and writes the result to the
+    // debugger output (key B, when enabled).
+    void BenchmarkHeightmapNoise();
+
+    void Tutorial2::BuildFrustumPlanes(const XMMATRIX& view, const XMMATRIX& proj, std::array<XMFLOAT4, 6>& outPlanes);
+
+    bool Tutorial2::IsBoxInsideFrustum(float minX, float minY, float minZ, float maxX, float maxY, float maxZ, const std::array<XMFLOAT4, 6>& planes);
+
+    //Descriptor Heap for textures
+    std::shared_ptr<ID3D12DescriptorHeap> m_SRVHeap;
+
+protected:
+    /**
+     *  Update the game logic.
+     */
+    virtual void OnUpdate(UpdateEventArgs& e) override;
+
+    /**
+     *  Render stuff.
+     */
+    virtual void OnRender(RenderEventArgs& e) override;
+
+    /**
+     * Invoked by the registered window when a key is pressed
+     * while the window has focus.
+     */
+    virtual void OnKeyPressed(KeyEventArgs& e) override;
+
+    virtual void OnKeyReleased(KeyEventArgs& e) override;
+
+    virtual void OnMouseMoved(MouseMotionEventArgs& e) override;
+
+    /**
+     * Invoked when the mouse wheel is scrolled while the registered window has focus.
+     */
+    virtual void OnMouseWheel(MouseWheelEventArgs& e) override;
+
+
+    virtual void OnResize(ResizeEventArgs& e) override;
+
+private:
+    // Helper functions
+
+    // Clear a render target view.
+    void ClearRTV(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
+        D3D12_CPU_DESCRIPTOR_HANDLE rtv, FLOAT* clearColor);
+
+    // Clear the depth of a depth-stencil view.
+    void ClearDepth(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
+        D3D12_CPU_DESCRIPTOR_HANDLE dsv, FLOAT depth = 1.0f);
+
+    // Create a GPU buffer.
+    void UpdateBufferResource(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList,
+        ID3D12Resource** pDestinationResource, ID3D12Resource** pIntermediateResource,
+        size_t numElements, size_t elementSize, const void* bufferData,
+        D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE);
+
+    // Resize the depth buffer to match the size of the client area.
+    void ResizeDepthBuffer(int width, int height);
+
+    // Declare the frame's passes and resources, and create the transients (depth buffer, terrain
+    // shadow map) for a client area of the given size
+    void BuildRenderGraph(int width, int height);
+
+    // Passes of the render graph, recording what m_Frame describes. The terrain passes record
+    // their chunks on worker threads and leave commandList as a new list to go on with.
+    void RecordSkyPass(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList);
+    void RecordTerrainShadowPass(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList);
+    void RecordTerrainPass(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList);
+
+    // Everything a terrain pass sets on a list before its chunks, for every list it records on
+    void SetupTerrainShadowList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList);
+    void SetupTerrainList(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList);
+
+    // Records one chunk on a worker thread (or nothing when it is culled)
+    struct ChunkRecorder;
+    void RecordTerrainShadowChunk(ChunkRecorder& recorder, const TerrainChunk& chunk);
+    void RecordTerrainChunk(ChunkRecorder& recorder, const TerrainChunk& chunk);
+
+    /// <summary>
+    /// Splits the chunks into one contiguous range per recorder and records each range on a worker
+    /// thread, into a list of its own set up by setupList. commandList and the recorders' lists
+    /// are added to m_FrameCommandLists in draw order, and commandList is replaced by a new list,
+    /// set up the same way, for what the pass records after the chunks.
+    /// </summary>
+    void RecordChunksInParallel(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>& commandList,
+        const std::vector<std::shared_ptr<TerrainChunk>>& chunks,
+        const std::function<void(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>)>& setupList,
+        const std::function<void(ChunkRecorder&, const TerrainChunk&)>& recordChunk);
+
+    void ComputeLightSpaceMatrix();
+
+    // Far plane of the camera: the clipmap's outermost level reaches past the chunk grid
+    float GetFarPlane() const;
+
+    // Clipmap terrain passes, drawn instead of the chunks in clipmap mode
+    void DrawClipmapShadow(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, const std::array<XMFLOAT4, 6>& frustumPlanes);
+    void DrawClipmap(Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList, const std::array<XMFLOAT4, 6>& frustumPlanes,
+        const LightProperties& lightProps, FXMVECTOR cameraPos);
+
+    uint64_t m_FenceValues[Window::BufferCount] = {};
+
+    // Sky, terrain shadow map and terrain passes. Built again when the client area is resized.
+    RenderGraph m_RenderGraph;
+    RenderGraph::ResourceHandle m_BackBufferResource;
+    RenderGraph::ResourceHandle m_DepthBufferResource;
+    RenderGraph::ResourceHandle m_ShadowMapResource;
+    RenderGraph::ResourceHandle m_SkyTextureResource;
+    RenderGraph::ResourceHandle m_HeightmapArrayResource;
+    RenderGraph::ResourceHandle m_NormalMapArrayResource;
+    std::vector<RenderGraph::ResourceHandle> m_ClipmapHeightmapResources;
+
+    // What OnRender works out for the passes it executes
+    struct FrameContext
+    {
+        DirectX::XMMATRIX viewMatrix;
+        DirectX::XMMATRIX projectionMatrix;
+        DirectX::XMVECTOR cameraPos;
+        std::array<XMFLOAT4, 6> frustumPlanes;
+        // Of the light's orthographic volume, for the shadow casters: terrain outside the view
+        // still casts shadows into it
+        std::array<XMFLOAT4, 6> lightFrustumPlanes;
+        LightProperties lightProps;
+        D3D12_CPU_DESCRIPTOR_HANDLE rtv;
+        // Empty in clipmap mode
+        const std::vector<std::shared_ptr<TerrainChunk>>* terrainChunks;
+        bool drawClipmap;
+    };
+    FrameContext m_Frame;
+
+    // What one thread records a range of chunks with. The upload buffer is its own because
+    // UploadBuffer is not thread-safe.
+    struct ChunkRecorder
+    {
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList;
+        std::unique_ptr<UploadBuffer> uploadBuffer;
+        // Visible patch ranges of the chunk being recorded; reserved once so culling does not allocate
+        std::vector<IndexRange> drawRanges;
+    };
+    // Threads recording the chunks of a pass, the calling one included. More only pays off with
+    // far more chunks than the grid streams in.
+    static constexpr unsigned MaxChunkRecorders = 4;
+    std::vector<ChunkRecorder> m_ChunkRecorders;
+    // The recording threads besides the calling one; their own, so streaming jobs never hold them up
+    std::unique_ptr<WorkerGroup> m_RecordingWorkers;
+
+    // The lists this frame is recorded on so far, submitted together in this order
+    std::vector<Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>> m_FrameCommandLists;
+    ResourceBarrierBatch::Stats m_FrameBarrierStats;
+
+    // Heightmap / Terrain
+    std::vector<Mesh> m_Terrain;
+    TerrainChunkManager m_TerrainChunkManager;
+    std::vector<float> m_HeightmapData;
+    std::shared_ptr<PSOTerrain> m_TerrainPipelineState;
+    const Texture* m_TerrainGrassTexture;
+    const Texture* m_TerrainBlendTexture;
+    const Texture* m_TerrainRockTexture;
+
+    // Terrain Shadow Map
+    std::unique_ptr<ShadowMap> m_TerrainShadowMap;
+    uint32_t m_TerrainShadowMapCPUSRVDescriptorIndex;
+    uint32_t m_TerrainShadowMapGPUSRVDescriptorIndex;
+    uint32_t m_TerrainShadowMapCPUDSVDescriptorIndex;
+    std::shared_ptr<PSOTerrainShadowMap> m_TerrainShadowMapPipelineState;
+
+    // Clipmap terrain, drawn instead of the chunks while m_UseClipmap is set (C toggles)
+    std::unique_ptr<TerrainClipmapRenderer> m_TerrainClipmap;
+    std::shared_ptr<PSOTerrainClipmap> m_TerrainClipmapPipelineState;
+    std::shared_ptr<PSOTerrainClipmap> m_TerrainClipmapShadowPipelineState;
+    bool m_UseClipmap;
+
+    bool m_NoiseBenchmarkEnabled = false;
+
+    // Skybox
+    Mesh m_SkyBoxMesh;
+    ComPtr<ID3D12Resource> m_SkyTexture;
+    ID3D12Resource* m_SkyTexture2;
+    uint32_t m_SkyDescriptorIndex;
+
+    std::shared_ptr<PSOSkybox> m_SkyboxPipelineState;
+
+    //Shadow Map
+    std::unique_ptr<ShadowMap> m_ShadowMap;
+    uint32_t m_ShadowMapCPUSRVDescriptorIndex;
+    uint32_t m_ShadowMapGPUSRVDescriptorIndex;
+    uint32_t m_ShadowMapCPUDSVDescriptorIndex;
+    std::shared_ptr<PSOShadowMap> m_ShadowMapPipelineState;
+
+    // Descriptor heap for depth buffer.
+    Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> m_DSVHeap;
+
+    // Root signature
+    Microsoft::WRL::ComPtr<ID3D12RootSignature> m_RootSignature;
+
+    // Pipeline state object.
+    //Microsoft::WRL::ComPtr<ID3D12PipelineState> m_PipelineState;
+    //Microsoft::WRL::ComPtr<PipelineState> m_PipelineState;
+    std::shared_ptr<PipelineState> m_PipelineState;
+
+    D3D12_VIEWPORT m_Viewport;
+    D3D12_RECT m_ScissorRect;
+
+    Camera m_Camera;
+    struct alignas(16) CameraData
+    {
+        DirectX::XMVECTOR m_InitialCamPos;
+        DirectX::XMVECTOR m_InitialCamRot;
+    };
+    CameraData* m_pAlignedCameraData;
+
+    float m_FoV;
+
+    int  m_Width;
+    int  m_Height;
+
+    // Camera controller
+    float m_Forward;
+    float m_Backward;
+    float m_Left;
+    float m_Right;
+    float m_Up;
+    float m_Down;
+
+    float m_Pitch;
+    float m_Yaw;
+    int m_PreviousMouseX;
+    int m_PreviousMouseY;
+
+    bool m_Shift;
+    bool g_AllowFullscreenToggle;
+    bool m_VSync;
+
+    DirectX::XMMATRIX m_ModelMatrix;
+    DirectX::XMMATRIX m_ViewMatrix;
+    DirectX::XMMATRIX m_ProjectionMatrix;
+
+    DirectX::XMMATRIX m_LightViewProj;
+
+    // Define some lights.
+    std::vector<PointLight> m_PointLights;
+    std::vector<SpotLight>  m_SpotLights;
+    std::vector<DirectionalLight>  m_DirectionalLights;
+    std::unique_ptr<UploadBuffer> m_UploadBuffer;
+
+    bool m_ContentLoaded;
 };
\ No newline at end of file
@@ -0,0 +1,96 @@
+struct Mat
+{
+    matrix ModelMatrix;
+    matrix ModelViewMatrix;
+    matrix InverseTransposeModelViewMatrix;
+    matrix ModelViewProjectionMatrix;
+};
+
+cbuffer MatCB : register(b0)
+{
+    Mat Matrices;
+}
+
+// TerrainClipmapConstants, one clipmap level
+cbuffer ClipmapLevel : register(b1)
+{
+    int2 gridOrigin;   // Grid coordinates of the level's first vertex
+    float spacing;     // World units per quad
+    float heightScale;
+    uint gridSize;     // Quads per side
+    uint textureMask;  // Texture size - 1
+    float morph;       // 1 when the border blends into the next coarser level
+    float uvScale;
+}
+
+// Toroidal: grid sample (x, z) lives in texel (x, z) & textureMask
+Texture2D<float> levelHeights : register(t8);
+Texture2D<float> coarserHeights : register(t9);
+
+struct VertexOutput
+{
+    float4 PosH : SV_POSITION;
+    float4 WorldPos : POSITION1;
+    float4 ShadowPos : POSITION2;
+    float4 Normal : NORMAL;
+    float2 UV : TEXCOORD;
+    float3 FragPos : COLOR0;
+};
+
+float LoadHeight(Texture2D<float> heights, int2 grid)
+{
+    return heights.Load(int3(asuint(grid) & textureMask, 0));
+}
+
+// Central differences of a level's samples; noise in [-1, 1] maps to (n + 1) / 2 * heightScale
+float3 LevelNormal(Texture2D<float> heights, int2 grid, float levelSpacing)
+{
+    float left = LoadHeight(heights, grid + int2(-1, 0));
+    float right = LoadHeight(heights, grid + int2(1, 0));
+    float down = LoadHeight(heights, grid + int2(0, -1));
+    float up = LoadHeight(heights, grid + int2(0, 1));
+    return normalize(float3((left - right) * 0.5f * heightScale, 2.0f * levelSpacing, (down - up) * 0.5f * heightScale));
+}
+
+VertexOutput main(float3 input : POSITION)
+{
+    VertexOutput output;
+
+    // The mesh holds vertex indices; the level places them
+    int2 local = int2(input.xz);
+    int2 grid = gridOrigin + local;
+
+    float height = LoadHeight(levelHeights, grid);
+    float3 normal = LevelNormal(levelHeights, grid, spacing);
+
+    // Over the outer tenth of the grid the level blends into the coarser one, reaching the
+    // coarser surface exactly on its border, so the two meet without cracks. A vertex between
+    // coarser vertices takes the coarser triangle's height there: the midpoint of the diagonal
+    // from (x + 1, z) to (x, z + 1), or of the edge it lies on.
+    float2 fromCentre = abs(float2(local) - gridSize * 0.5f);
+    float transition = gridSize * 0.1f;
+    float alpha = morph * saturate((max(fromCentre.x, fromCentre.y) - (gridSize * 0.5f - transition)) / transition);
+
+    if (alpha > 0.0f)
+    {
+        int2 coarse = grid >> 1;
+        int2 odd = grid & 1;
+        float coarseHeight = 0.5f * (LoadHeight(coarserHeights, coarse + int2(odd.x, 0)) + LoadHeight(coarserHeights, coarse + int2(0, odd.y)));
+        height = lerp(height, coarseHeight, alpha);
+        normal = normalize(lerp(normal, LevelNormal(coarserHeights, coarse, 2.0f * spacing), alpha));
+    }
+
+    float4 worldPos = float4(grid.x * spacing, (height + 1.0f) * 0.5f * heightScale, grid.y * spacing, 1.0f);
+
+    output.WorldPos = worldPos;
+    output.PosH = mul(Matrices.ModelViewProjectionMatrix, worldPos);
+
+    float4 shadowPos = mul(worldPos, Matrices.ModelMatrix);
+    output.ShadowPos = float4(shadowPos.xyz, 1);
+
+    output.FragPos = mul(Matrices.ModelViewMatrix, worldPos).xyz;
+    output.Normal = float4(normal, 1.0f);
+    output.UV = worldPos.xz / uvScale;
+
+    return output;
+}
@@ -0,0 +1,91 @@
+#include "WorkerGroup.h"
+
+WorkerGroup::WorkerGroup(unsigned threadCount)
+    : m_Stop(false)
+    , m_Generation(0)
+    , m_Context(nullptr)
+    , m_Function(nullptr)
+    , m_TaskCount(0)
+    , m_NextTask(0)
+    , m_RunningThreads(0)
+{
+    m_Threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        m_Threads.emplace_back(&WorkerGroup::WorkerLoop, this);
+    }
+}
+
+WorkerGroup::~WorkerGroup()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Start.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+unsigned WorkerGroup::GetThreadCount() const
+{
+    return static_cast<unsigned>(m_Threads.size());
+}
+
+void WorkerGroup::Dispatch(int taskCount, void* context, TaskFunction function)
+{
+    if (taskCount <= 0)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Context = context;
+        m_Function = function;
+        m_TaskCount = taskCount;
+        m_NextTask.store(0);
+        m_RunningThreads = static_cast<unsigned>(m_Threads.size());
+        ++m_Generation;
+    }
+    m_Start.notify_all();
+
+    RunTasks();
+
+    // Every thread has to be done with this generation, not just the tasks: the task lives on the
+    // caller's stack
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Finished.wait(lock, [this]() { return m_RunningThreads == 0; });
+}
+
+void WorkerGroup::RunTasks()
+{
+    for (int index = m_NextTask.fetch_add(1); index < m_TaskCount; index = m_NextTask.fetch_add(1))
+    {
+        m_Function(m_Context, index);
+    }
+}
+
+void WorkerGroup::WorkerLoop()
+{
+    uint64_t generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Start.wait(lock, [this, generation]() { return m_Stop || m_Generation != generation; });
+            if (m_Stop)
+                return;
+            generation = m_Generation;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (--m_RunningThreads == 0)
+                m_Finished.notify_one();
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/**
+ * Fixed set of threads that run one fork/join task set at a time (per-frame work such as recording).
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Unlike ThreadPool there is no job queue: Run hands the same task to every thread, which claim
+// indices until none are left. Nothing is allocated per Run, and the threads are not shared with
+// background jobs (chunk streaming), so per-frame work never waits behind them.
+class WorkerGroup
+{
+public:
+    explicit WorkerGroup(unsigned threadCount);
+    virtual ~WorkerGroup();
+
+    WorkerGroup(const WorkerGroup&) = delete;
+    WorkerGroup& operator=(const WorkerGroup&) = delete;
+
+    unsigned GetThreadCount() const;
+
+    /// <summary>
+    /// Calls task(i) for every i in [0, taskCount) on the group's threads and the calling thread.
+    /// Returns once every call has returned. One Run at a time; it must not be called from a task.
+    /// </summary>
+    template <typename Task>
+    void Run(int taskCount, Task& task)
+    {
+        Dispatch(taskCount, &task, [](void* context, int index) { (*static_cast<Task*>(context))(index); });
+    }
+
+private:
+    using TaskFunction = void (*)(void* context, int index);
+
+    void Dispatch(int taskCount, void* context, TaskFunction function);
+    void RunTasks();
+    void WorkerLoop();
+
+    std::vector<std::thread>    m_Threads;
+    std::mutex                  m_Mutex;
+    std::condition_variable     m_Start;
+    std::condition_variable     m_Finished;
+    bool                        m_Stop;
+
+    // The task set of the current Run, set under m_Mutex before m_Generation moves on
+    uint64_t                    m_Generation;
+    void*                       m_Context;
+    TaskFunction                m_Function;
+    int                         m_TaskCount;
+    std::atomic<int>            m_NextTask;
+    unsigned                    m_RunningThreads; // Still claiming tasks of this generation
+};
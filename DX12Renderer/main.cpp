@@ -1,42 +1,55 @@
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <Shlwapi.h>
-
-#include "Application.h"
-#include "Tutorial2.h"
-
-#include <dxgidebug.h>
-
-void ReportLiveObjects()
-{
-    IDXGIDebug1* dxgiDebug;
-    DXGIGetDebugInterface1(0, IID_PPV_ARGS(&dxgiDebug));
-
-    dxgiDebug->ReportLiveObjects(DXGI_DEBUG_ALL, DXGI_DEBUG_RLO_IGNORE_INTERNAL);
-    dxgiDebug->Release();
-}
-
-int CALLBACK wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR lpCmdLine, int nCmdShow)
-{
-    int retCode = 0;
-
-    // Set the working directory to the path of the executable.
-    WCHAR path[MAX_PATH];
-    HMODULE hModule = GetModuleHandleW(NULL);
-    if (GetModuleFileNameW(hModule, path, MAX_PATH) > 0)
-    {
-        PathRemoveFileSpecW(path);
-        SetCurrentDirectoryW(path);
-    }
-
-    Application::Create(hInstance);
-    {
-        std::shared_ptr<Tutorial2> demo = std::make_shared<Tutorial2>(L"Learning DirectX 12", 1920, 1080);
-        retCode = Application::Get().Run(demo);
-    }
-    Application::Destroy();
-
-    atexit(&ReportLiveObjects);
-
-    return retCode;
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <Shlwapi.h>
+#include <shellapi.h>
+
+#include "Application.h"
+#include "Tutorial2.h"
+
+#include <dxgidebug.h>
+
+void ReportLiveObjects()
+{
+    IDXGIDebug1* dxgiDebug;
+    DXGIGetDebugInterface1(0, IID_PPV_ARGS(&dxgiDebug));
+
+    dxgiDebug->ReportLiveObjects(DXGI_DEBUG_ALL, DXGI_DEBUG_RLO_IGNORE_INTERNAL);
+    dxgiDebug->Release();
+}
+
+int CALLBACK wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, PWSTR lpCmdLine, int nCmdShow)
+{
+    int retCode = 0;
+
+    // Set the working directory to the path of the executable.
+    WCHAR path[MAX_PATH];
+    HMODULE hModule = GetModuleHandleW(NULL);
+    if (GetModuleFileNameW(hModule, path, MAX_PATH) > 0)
+    {
+        PathRemoveFileSpecW(path);
+        SetCurrentDirectoryW(path);
+    }
+
+    // -benchmark lets key B time the heightmap noise
+    bool noiseBenchmark = false;
+    int argc;
+    wchar_t** argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+    for (int i = 0; i < argc; ++i)
+    {
+        if (wcscmp(argv[i], L"-benchmark") == 0)
+            noiseBenchmark = true;
+    }
+    LocalFree(argv);
+
+    Application::Create(hInstance);
+    {
+        std::shared_ptr<Tutorial2> demo = std::make_shared<Tutorial2>(L"Learning DirectX 12", 1920, 1080);
+        demo->SetNoiseBenchmarkEnabled(noiseBenchmark);
+        retCode = Application::Get().Run(demo);
+    }
+    Application::Destroy();
+
+    atexit(&ReportLiveObjects);
+
+    return retCode;
 }
\ No newline at end of file
@@ -1 +1 @@
-#include "Light.h"
+#include "Light.h"
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <wrl.h>
+using namespace Microsoft::WRL;
+
+// DirectX 12 Specific headers
+#include <d3d12.h>
+
+/// <summary>
+/// Root signature and pipeline state of the clipmap terrain (VSTerrainClipmap), without
+/// tessellation. With a pixel shader it draws with PSTerrain's lighting; without one it
+/// writes depth only, with the terrain shadow map's depth bias.
+/// </summary>
+class PSOTerrainClipmap
+{
+public:
+	/// <summary>
+	/// An empty pixelName creates the depth only shadow map pipeline
+	/// </summary>
+	PSOTerrainClipmap(std::wstring vertexName, std::wstring pixelName);
+
+	/// <summary>
+	/// Returns a pointer to the pipeline state object
+	/// </summary>
+	/// <returns></returns>
+	ComPtr<ID3D12PipelineState> GetPipelineState();
+
+	/// <summary>
+	/// Returns a pointer to the root signature object
+	/// </summary>
+	/// <returns></returns>
+	ComPtr<ID3D12RootSignature> GetRootSignature();
+
+private:
+	void CreateRootSignature();
+	void CreatePipelineState();
+
+	ComPtr<ID3D12RootSignature> m_rootSignature;
+	ComPtr<ID3D12PipelineState> m_pipelineState;
+
+	ComPtr<ID3DBlob> m_vertexShader;
+	ComPtr<ID3DBlob> m_pixelShader;
+};
@@ -1,57 +1,65 @@
-//***************************************************************************************
-// ShadowMap.h by Frank Luna (C) 2011 All Rights Reserved.
-//***************************************************************************************
-// I do not own this code it is from "Introduction to 3D game programming with DirectX 12"
-
-#pragma once
-#include <d3d12.h>
-#include "DX12Renderer/d3dx12.h"
-
-class ShadowMap
-{
-public:
-	ShadowMap(ID3D12Device* device,
-		UINT width, UINT height);
-
-	ShadowMap(const ShadowMap& rhs) = delete;
-	ShadowMap& operator=(const ShadowMap& rhs) = delete;
-	~ShadowMap() = default;
-
-	UINT Width()const;
-	UINT Height()const;
-	ID3D12Resource* Resource();
-	CD3DX12_GPU_DESCRIPTOR_HANDLE Srv()const;
-	CD3DX12_CPU_DESCRIPTOR_HANDLE Dsv()const;
-
-	D3D12_VIEWPORT Viewport()const;
-	D3D12_RECT ScissorRect()const;
-
-	void BuildDescriptors(
-		CD3DX12_CPU_DESCRIPTOR_HANDLE hCpuSrv,
-		CD3DX12_GPU_DESCRIPTOR_HANDLE hGpuSrv,
-		CD3DX12_CPU_DESCRIPTOR_HANDLE hCpuDsv);
-
-	void OnResize(UINT newWidth, UINT newHeight);
-
-private:
-	void BuildDescriptors();
-	void BuildResource();
-
-private:
-
-	ID3D12Device* md3dDevice = nullptr;
-
-	D3D12_VIEWPORT mViewport;
-	D3D12_RECT mScissorRect;
-
-	UINT mWidth = 0;
-	UINT mHeight = 0;
-	DXGI_FORMAT mFormat = DXGI_FORMAT_R24G8_TYPELESS;
-
-	CD3DX12_CPU_DESCRIPTOR_HANDLE mhCpuSrv;
-	CD3DX12_GPU_DESCRIPTOR_HANDLE mhGpuSrv;
-	CD3DX12_CPU_DESCRIPTOR_HANDLE mhCpuDsv;
-
-	Microsoft::WRL::ComPtr<ID3D12Resource> mShadowMap = nullptr;
-};
-
+//***************************************************************************************
+// ShadowMap.h by Frank Luna (C) 2011 All Rights Reserved.
+//***************************************************************************************
+// I do not own this code it is from "Introduction to 3D game programming with DirectX 12"
+
+#pragma once
+#include <d3d12.h>
+#include "DX12Renderer/d3dx12.h"
+
+class ShadowMap
+{
+public:
+	// Without createResource the texture comes from SetResource (the render graph places it)
+	ShadowMap(ID3D12Device* device,
+		UINT width, UINT height, bool createResource = true);
+
+	ShadowMap(const ShadowMap& rhs) = delete;
+	ShadowMap& operator=(const ShadowMap& rhs) = delete;
+	~ShadowMap() = default;
+
+	UINT Width()const;
+	UINT Height()const;
+	ID3D12Resource* Resource();
+	CD3DX12_GPU_DESCRIPTOR_HANDLE Srv()const;
+	CD3DX12_CPU_DESCRIPTOR_HANDLE Dsv()const;
+
+	D3D12_VIEWPORT Viewport()const;
+	D3D12_RECT ScissorRect()const;
+
+	void BuildDescriptors(
+		CD3DX12_CPU_DESCRIPTOR_HANDLE hCpuSrv,
+		CD3DX12_GPU_DESCRIPTOR_HANDLE hGpuSrv,
+		CD3DX12_CPU_DESCRIPTOR_HANDLE hCpuDsv);
+
+	void OnResize(UINT newWidth, UINT newHeight);
+
+	// What the texture is created with, for creating it elsewhere
+	D3D12_RESOURCE_DESC ResourceDesc()const;
+	D3D12_CLEAR_VALUE ClearValue()const;
+
+	// Uses a texture created elsewhere from ResourceDesc, and points the descriptors at it
+	void SetResource(ID3D12Resource* resource);
+
+private:
+	void BuildDescriptors();
+	void BuildResource();
+
+private:
+
+	ID3D12Device* md3dDevice = nullptr;
+
+	D3D12_VIEWPORT mViewport;
+	D3D12_RECT mScissorRect;
+
+	UINT mWidth = 0;
+	UINT mHeight = 0;
+	DXGI_FORMAT mFormat = DXGI_FORMAT_R24G8_TYPELESS;
+
+	CD3DX12_CPU_DESCRIPTOR_HANDLE mhCpuSrv;
+	CD3DX12_GPU_DESCRIPTOR_HANDLE mhGpuSrv;
+	CD3DX12_CPU_DESCRIPTOR_HANDLE mhCpuDsv;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> mShadowMap = nullptr;
+};
+
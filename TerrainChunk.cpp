@@ -1,330 +1,465 @@
-﻿#define NOMINMAX
-
-#include "TerrainChunk.h"
-#include <algorithm>
-#include "DX12Renderer/Texture.h"
-
-TerrainChunk::TerrainChunk(int chunkX, int chunkZ, int size, float heightScale)
-    : m_chunkX(chunkX), m_chunkZ(chunkZ), m_size(size), m_heightScale(heightScale), m_position(XMFLOAT3(0,0,0)) {}
-
-void TerrainChunk::Initialize(const std::vector<float>& /*unused global heightmap*/, int /*heightmapWidth*/, std::unordered_map<std::string, Texture*>& textures) {
-    int tessFactor = 4;
-    int vertsPerSide = m_size / tessFactor; // 256
-    int patchesPerSide = vertsPerSide - 1;  // 255
-    int visibleSize = patchesPerSide * tessFactor; // 1020
-    int arrSize = vertsPerSide * vertsPerSide; // 256*256
-
-    // Generate local noise-based heightmap
-    std::vector<float> heightmapLocal = GenerateChunkHeightmap(
-        FastNoiseLite::NoiseType_Perlin,
-        m_chunkX, m_chunkZ,
-        vertsPerSide, vertsPerSide,  // width=vertsPerSide
-        0.075f
-    );
-
-    // (Optional) upload heightmapLocal into a texture of size 256x256 if needed.
-    // Fill RGBA imageData as before, but dimensions = vertsPerSide x vertsPerSide:
-    std::vector<uint8_t> imageData(vertsPerSide * vertsPerSide * 4);
-    for (int i = 0; i < vertsPerSide * vertsPerSide; ++i) {
-        float normalized = (heightmapLocal[i] + 1.0f) * 0.5f;
-        uint8_t h = static_cast<uint8_t>(std::clamp(normalized * 255.0f, 0.0f, 255.0f));
-        imageData[i * 4 + 0] = h;
-        imageData[i * 4 + 1] = h;
-        imageData[i * 4 + 2] = h;
-        imageData[i * 4 + 3] = 255;
-    }
-    m_heightmapTexture = std::make_unique<Texture>(imageData, XMFLOAT2((float)vertsPerSide, (float)vertsPerSide));
-
-    // Prepare vertex array
-    std::vector <VertexPosition> m_vertices = std::vector<VertexPosition>();
-    m_vertices.clear();
-    m_vertices.resize(arrSize);
-
-    int chunkWorldX = m_chunkX * visibleSize;
-    int chunkWorldZ = m_chunkZ * visibleSize;
-
-    for (int z = 0; z < vertsPerSide; ++z) {
-        for (int x = 0; x < vertsPerSide; ++x) {
-            int idx = z * vertsPerSide + x;
-            float worldX = float(chunkWorldX + x * tessFactor);
-            float worldZ = float(chunkWorldZ + z * tessFactor);
-            float h = (heightmapLocal[idx] + 1.0f) * 0.5f * m_heightScale;
-            m_vertices[idx].Position = XMFLOAT3(worldX, h, worldZ);
-        }
-    }
-
-    // Build index list for tessellated patches: patchesPerSide x patchesPerSide, each patch uses 4 control points:
-    std::vector<UINT> m_indices = std::vector<UINT>();
-    m_indices.clear();
-    for (int z = 0; z < patchesPerSide; ++z) {
-        for (int x = 0; x < patchesPerSide; ++x) {
-            UINT v0 = x + z * vertsPerSide;
-            UINT v1 = (x + 1) + z * vertsPerSide;
-            UINT v2 = x + (z + 1) * vertsPerSide;
-            UINT v3 = (x + 1) + (z + 1) * vertsPerSide;
-            m_indices.push_back(v0);
-            m_indices.push_back(v1);
-            m_indices.push_back(v2);
-            m_indices.push_back(v3);
-        }
-    }
-
-    // Set texture and buffers as before
-    textures.erase("Heightmap");
-    textures.emplace("Heightmap", const_cast<Texture*>(m_heightmapTexture.get()));
-    m_mesh.AddVertexData(m_vertices);
-    m_mesh.AddIndexData(m_indices);
-    m_mesh.AddTextureData(textures);
-    m_mesh.CreateBuffers();
-}
-
-void TerrainChunk::SetActive(bool active) {
-    m_active = active;
-}
-
-bool TerrainChunk::IsActive() const {
-    return m_active;
-}
-
-Mesh TerrainChunk::GetMesh() {
-    return m_mesh;
-}
-
-XMFLOAT3 TerrainChunk::GetWorldPosition() const {
-    // Compute number of quads (patches) in the chunk
-    int patchCount = (m_size - 1) / 4; // -1 because we count edges between vertices
-    int chunkWorldSize = patchCount * 4; // This gives you how much space the chunk spans in world units
-
-    return XMFLOAT3(
-        static_cast<float>(m_chunkX * chunkWorldSize),
-        0.0f,
-        static_cast<float>(m_chunkZ * chunkWorldSize)
-    );
-
-    //return XMFLOAT3((float)(m_chunkX * (m_size / 4 - 1)), 0.0f, (float)(m_chunkZ * (m_size / 4 - 1)));
-}
-
-std::vector<float> TerrainChunk::GenerateChunkHeightmap(
-    FastNoiseLite::NoiseType noiseType,
-    int chunkX, int chunkZ,
-    int vertsPerSide,    // = m_size / tessFactor = 256
-    int UNUSED_height,   // same as width
-    float noiseScale)
-{
-    m_Noise.SetNoiseType(noiseType);
-    m_Noise.SetFrequency(noiseScale);
-    m_Noise.SetFractalType(FastNoiseLite::FractalType_None);
-    //m_Noise.SetFractalType(FastNoiseLite::FractalType_FBm);
-    //m_Noise.SetFractalOctaves(8);
-    //m_Noise.SetFractalLacunarity(1.8f);
-    //m_Noise.SetFractalGain(0.5f);
-
-    int tessFactor = 4;
-    int patchesPerSide = vertsPerSide - 1; // 255
-    int visibleSize = patchesPerSide * tessFactor; // 1020
-
-    std::vector<float> heightmapLocal(vertsPerSide * vertsPerSide);
-
-    // Sample from world position based on chunk offset, stepping by tessFactor
-    for (int z = 0; z < vertsPerSide; ++z) {
-        for (int x = 0; x < vertsPerSide; ++x) {
-            float worldX = float(chunkX * visibleSize + x * tessFactor);
-            float worldZ = float(chunkZ * visibleSize + z * tessFactor);
-            float nx = worldX * noiseScale;
-            float nz = worldZ * noiseScale;
-
-            //float base = 1 - std::abs(FbmNoiseWithFD2(nx, nz, 8, 1.8f, 0.5f, 1e-3f, /*kAtten*/ 0.5f));
-            //float base = 1 - std::abs(m_Noise.GetNoise(nx, nz));
-
-            //XMFLOAT2 q = XMFLOAT2(FbmNoiseWithFD(nx + 0, nz + 0, 8, 1.8f, 0.5f, 1e-3f, /*kAtten*/ 0.5f),
-            //                      FbmNoiseWithFD(nx + 5.2f, nz + 1.3f, 8, 1.8f, 0.5f, 1e-3f, /*kAtten*/ 0.5f));            
-            //
-            //XMFLOAT2 r = XMFLOAT2(FbmNoiseWithFD(nx + 1.7f + 4*q.x, nz + 9.2f + 4*q.y, 8, 1.8f, 0.5f, 1e-3f, /*kAtten*/ 0.5f),
-            //                      FbmNoiseWithFD(nx + 8.3f + 4*q.x, nz + 2.8f + 4 * q.y, 8, 1.8f, 0.5f, 1e-3f, /*kAtten*/ 0.5f));
-
-            //float base = FbmNoiseWithFD(nx + 4 * r.x, nz + 4 * r.y, 8, 1.8f, 0.5f, 1e-3f, /*kAtten*/ 0.5f);
-
-            float base = UberNoise(/*x*/ nx, /*y*/ nz, /*octaves*/ 8, /*perturbance*/ 0.15f, /*sharpness*/ 0.25f, /*amplification*/ 0.2f, 
-                                   /*altErode*/ 0.75f, /*RidgeErode*/ 0.75f, /*SlopeErode*/ 0.001f,  /*lacunarity*/ 1.8f, /*gain*/ 0.5f, 
-                                   /*frequency*/ noiseScale, /*epsilon*/ 1e-3f, /*kAtten*/ 0.5f );
-
-            heightmapLocal[z * vertsPerSide + x] = base;
-        }
-    }
-    return heightmapLocal;
-}
-
-float TerrainChunk::FbmNoiseWithFD(
-    float x0, float z0,
-    int octaves,
-    float lac,
-    float gain,
-    float eps,
-    float kAtten) 
-{
-    // 1. Theoretical amplitude sum (no attenuation) for normalization
-    float sumAmp = 0.0f;
-    {
-        float ampTmp = 1.0f;
-        for (int i = 0; i < octaves; i++) {
-            sumAmp += ampTmp;
-            ampTmp *= gain;
-        }
-    }
-
-    float sum = 0.5f;
-    float amplitude = 1.0f;
-    float freq = 1.0f;
-
-    XMFLOAT2 dsum = XMFLOAT2(0, 0);
-
-    // Running derivative of height so far (in base coordinate space)
-    float derivX = 0.0f;
-    float derivZ = 0.0f;
-
-    for (int i = 0; i < octaves; i++) {
-        float x = x0 * freq;
-        float z = z0 * freq;
-
-        // Sample noise
-        float n = m_Noise.GetNoise(x, z); // [-1,1]
-
-        // Compute derivative of this octave’s noise (in base coords)
-        float dx_n = 0.0f, dz_n = 0.0f;
-        if (kAtten > 0.0f) {
-            float nx = m_Noise.GetNoise(x + eps, z);
-            float nz = m_Noise.GetNoise(x, z + eps);
-            dx_n = (nx - n) / eps * freq;
-            dz_n = (nz - n) / eps * freq;
-        }
-
-        // Accumulate height using current amplitude
-        //sum += n * amplitude;
-        dsum = XMFLOAT2(dsum.x + dx_n, dsum.y + dz_n);
-        float dot = dsum.x * dsum.x + dsum.y * dsum.y;
-
-        sum += amplitude * n / (1 + dot);
-
-
-        // Update running derivative sum
-        if (kAtten > 0.0f) {
-            derivX += dx_n * amplitude;
-            derivZ += dz_n * amplitude;
-            // Compute slope of accumulated height so far
-            float slopeAccum = std::sqrt(derivX * derivX + derivZ * derivZ);
-            // Attenuate next octave’s amplitude
-            float attenuation = std::exp(-kAtten * slopeAccum);
-            amplitude *= gain * attenuation;
-        }
-        else {
-            // No attenuation
-            amplitude *= gain;
-        }
-
-        freq *= lac;
-    }
-
-    // Normalize to [-1,1]
-    float hNorm = sum / sumAmp;
-    return hNorm;
-    //return 0.5f * (hNorm + 1.0f);
-    //return sum;
-}
-
-float TerrainChunk::UberNoise(
-    float x0, float z0,
-    int   octaves,
-    float perturbAmt,
-    float sharpness,
-    float amplify,
-    float altitudeErode,
-    float ridgeErode,
-    float slopeErode,
-    float lacunarity,
-    float gain,
-    float baseFreq,
-    float eps,
-    float kAtten)       // FDG’s slope attenuation 
-{
-    // 1. Theoretical amplitude sum (no attenuation) for normalization
-    float sumAmp = 0.0f;
-    {
-        float ampTmp = 1.0f;
-        for (int i = 0; i < octaves; i++) {
-            sumAmp += ampTmp;
-            ampTmp *= gain;
-        }
-    }
-
-    float x = x0;
-    float z = z0;
-
-    float sum = 0.5f;
-    float amplitude = 1.0f;
-    float freq = 1.0f;
-    float dampedAmplitude = 0.0f;
-    float currentGain = gain;
-
-    XMFLOAT2 slopeErosionDerSum = XMFLOAT2(0, 0);
-    XMFLOAT2 ridgeErosionDerSum = XMFLOAT2(0, 0);
-    XMFLOAT2 perturbDerSum = XMFLOAT2(0, 0);
-
-    // Running derivative of height so far (in base coordinate space)
-    float derivX = 0.0f;
-    float derivZ = 0.0f;
-
-    for (int i = 0; i < octaves; i++) {
-
-        // Sample noise
-        float n = m_Noise.GetNoise(x, z); // [-1,1]
-
-        float ridgedNoise = 1.0 - abs(n);
-        float billowNoise = n * n;
-
-        n = std::lerp(n, billowNoise, std::max(0.0f, sharpness));
-        n = std::lerp(n, ridgedNoise, std::abs(std::min(0.0f, sharpness)));
-
-
-        // Compute derivative of this octave’s noise (in base coords)
-        float dx_n = 0.0f, dz_n = 0.0f;
-        if (kAtten > 0.0f) {
-            float nx = m_Noise.GetNoise(x + eps, z);
-            float nz = m_Noise.GetNoise(x, z + eps);
-            dx_n = (nx - n) / eps * freq;
-            dz_n = (nz - n) / eps * freq;
-        }
-
-        slopeErosionDerSum = XMFLOAT2((slopeErosionDerSum.x + dx_n) * slopeErode, (slopeErosionDerSum.y + dz_n) * slopeErode);
-        float dot = slopeErosionDerSum.x * slopeErosionDerSum.x + slopeErosionDerSum.y * slopeErosionDerSum.y;
-
-        sum += amplitude * n * (1.0f / (1.0f + dot));
-
-        sum += dampedAmplitude * n * (1.0f / (1.0f + dot));
-
-        amplitude *= std::lerp(currentGain, currentGain * smoothstep(0.0f, 1.0f, sum), altitudeErode);
-
-        ridgeErosionDerSum = XMFLOAT2((ridgeErosionDerSum.x + dx_n) * ridgeErode, (ridgeErosionDerSum.y + dz_n) * ridgeErode);
-        float dotRidge = ridgeErosionDerSum.x * ridgeErosionDerSum.x + ridgeErosionDerSum.y * ridgeErosionDerSum.y;
-        dampedAmplitude = amplitude * (1.0f - (ridgeErode / (1.0f + dotRidge)));
-
-        x = (x0 * freq) + perturbDerSum.x;
-        z = (z0 * freq) + perturbDerSum.y;
-        perturbDerSum = XMFLOAT2((perturbDerSum.x + dx_n) * perturbAmt, (perturbDerSum.y + dz_n) * perturbAmt);
-
-        currentGain = gain + amplify;
-        freq *= lacunarity;
-    }
-
-    // Normalize to [-1,1]
-    float hNorm = sum / sumAmp;
-    return hNorm;
-    //return 0.5f * (hNorm + 1.0f);
-    //return sum;
-}
-
-float TerrainChunk::smoothstep(float edge0, float edge1, float x) {
-    // Scale, bias and saturate x to 0..1 range
-    x = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
-    // Evaluate polynomial
-    return x * x * (3 - 2 * x);
-}
\ No newline at end of file
+﻿#define NOMINMAX
+
+#include "TerrainChunk.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cassert>
+#include <cstring>
+#include <unordered_map>
+#include "DX12Renderer/Texture.h"
+#include "DX12Renderer/PixelConversion.h"
+#include "TerrainNoise.h"
+#include "TerrainChunkHeightmap.h"
+#include "TerrainPatchTree.h"
+#include "TerrainChunkCache.h"
+#include "TerrainChunkPool.h"
+#include "TerrainHeightmapLru.h"
+#include "DX12Renderer/ThreadPool.h"
+#include "DX12Renderer/Application.h"
+#include "DX12Renderer/Helpers.h"
+#include "DX12Renderer/d3dx12.h"
+
+namespace {
+    constexpr bool LodTiersNest() {
+        int maxRatio = 1;
+        for (size_t t = 0; t < TerrainChunk::LodTiers.size(); ++t) {
+            if (255 % TerrainChunk::LodTiers[t].stride != 0)
+                return false;
+            if (t > 0) {
+                const TerrainLodTier& finer = TerrainChunk::LodTiers[t - 1];
+                const TerrainLodTier& coarser = TerrainChunk::LodTiers[t];
+                if (coarser.stride % finer.stride != 0 || coarser.firstRing <= finer.firstRing)
+                    return false;
+                maxRatio = std::max(maxRatio, coarser.stride / finer.stride);
+            }
+        }
+        return maxRatio == TerrainChunk::MaxStitchRatio;
+    }
+    static_assert(LodTiersNest(), "LOD tier strides have to divide 255 and each other (and MaxStitchRatio match)");
+
+    // Bytes of every patch index buffer built so far (main thread only)
+    size_t s_patchIndexBufferBytes = 0;
+
+    // Nearest multiple of an odd ratio
+    int SnapToRatio(int v, int ratio) {
+        return (v + ratio / 2) / ratio * ratio;
+    }
+}
+
+TerrainChunk::TerrainChunk(int chunkX, int chunkZ, int size, float heightScale)
+    : m_chunkX(chunkX), m_chunkZ(chunkZ), m_size(size), m_heightScale(heightScale), m_position(XMFLOAT3(0,0,0)) {}
+
+void TerrainChunk::Initialize(const std::vector<float>& /*unused global heightmap*/, int /*heightmapWidth*/, std::unordered_map<std::string, Texture*>& textures) {
+    GenerateCPUData();
+    CreateGPUResources(textures);
+}
+
+void TerrainChunk::SetLod(int tier, uint32_t coarserSides) {
+    assert(tier >= 0 && tier < int(LodTiers.size()));
+    m_lodTier = tier;
+    // The coarsest tier has nothing coarser to stitch to
+    m_lodSides = tier + 1 < int(LodTiers.size()) ? (coarserSides & TerrainSideAll) : 0;
+}
+
+int TerrainChunk::GetStitchRatio() const {
+    if (m_lodTier + 1 >= int(LodTiers.size()))
+        return 1;
+    return LodTiers[m_lodTier + 1].stride / LodTiers[m_lodTier].stride;
+}
+
+void TerrainChunk::GenerateCPUData() {
+    int vertsPerSide = GetVertsPerSide();   // 256 at the finest tier
+    int patchSize = GetPatchSize();         // 4 at the finest tier
+    int visibleSize = GetVisibleSize();     // 1020
+    int arrSize = vertsPerSide * vertsPerSide;
+
+    const FastNoiseLite::NoiseType noiseType = HeightNoiseType;
+    const float noiseScale = HeightNoiseScale;
+
+    // Take the heightmap of a recent visit, or load it from the on-disk cache, or generate it from
+    // noise and cache it
+    TerrainNoise::PerlinSettings perlin = m_Perlin;
+    perlin.frequency = noiseScale;
+    const uint64_t paramHash = TerrainChunkCache::HashParams(noiseType, perlin, m_noiseParams, vertsPerSide);
+    m_paramHash = paramHash;
+
+    // The disk cache holds full-resolution heightmaps only
+    const bool useCache = m_cache && m_lodTier == 0;
+
+    std::vector<float> heightmapLocal;
+    const bool recent = m_heightmapLru && m_heightmapLru->Load(m_chunkX, m_chunkZ, paramHash, heightmapLocal);
+    if (!recent && (!useCache || !m_cache->Load(m_chunkX, m_chunkZ, paramHash, heightmapLocal))) {
+        // Generate local noise-based heightmap
+        heightmapLocal = GenerateChunkHeightmap(
+            noiseType,
+            m_chunkX, m_chunkZ,
+            vertsPerSide, vertsPerSide,  // width=vertsPerSide
+            noiseScale
+        );
+
+        if (useCache)
+            m_cache->Store(m_chunkX, m_chunkZ, paramHash, heightmapLocal);
+    }
+
+    // Pack the heights into a single-channel R16_UNORM texture stretched over this chunk's own
+    // range; the shaders map it back with heightRange. Half the bytes of the old RGBA8 texture
+    // and at least 256x finer steps.
+    float heightMin, heightMax;
+    PixelConversion::MinMax(heightmapLocal.data(), heightmapLocal.size(), heightMin, heightMax);
+    m_heightRange = XMFLOAT2((heightMin + 1.0f) * 0.5f, (heightMax + 1.0f) * 0.5f);
+
+    m_imageData.resize(size_t(arrSize) * sizeof(uint16_t));
+    PixelConversion::FloatToUnorm16(heightmapLocal.data(), reinterpret_cast<uint16_t*>(m_imageData.data()), arrSize, heightMin, heightMax);
+
+    // Bake the normals of the domain-shader displacement from the same samples, so DSTerrain
+    // fetches one texel instead of reconstructing them from four more height taps.
+    // Noise in [-1,1] maps to (n + 1) / 2 * 255 world units; samples are patchSize apart.
+    m_normalData.resize(size_t(arrSize) * 2);
+    PixelConversion::BakeNormalsOctahedral(heightmapLocal.data(), vertsPerSide, vertsPerSide,
+        0.5f * (DisplacementScale - 1.0f), float(patchSize), m_normalData.data());
+
+    int chunkWorldX = m_chunkX * visibleSize;
+    int chunkWorldZ = m_chunkZ * visibleSize;
+
+    // The vertex heights only matter on seams between tiers, where the domain shaders displace
+    // the chunk edge linearly between them. On the sides facing a coarser tier they are that
+    // tier's heights, evaluated at the same world positions with the same octaves as the coarser
+    // chunk's own samples, so both sides of the seam get the same bits.
+    std::vector<float> vertexHeights = heightmapLocal;
+    if (m_lodSides != 0) {
+        const TerrainLodTier& coarser = LodTiers[m_lodTier + 1];
+        const int coarserOctaves = coarser.octaves > 0 ? coarser.octaves : m_noiseParams.octaves;
+        std::vector<float> sideX(vertsPerSide), sideZ(vertsPerSide), sideHeights(vertsPerSide);
+        for (uint32_t side : { TerrainSideNegX, TerrainSidePosX, TerrainSideNegZ, TerrainSidePosZ }) {
+            if (!(m_lodSides & side))
+                continue;
+
+            const bool alongZ = side == TerrainSideNegX || side == TerrainSidePosX;
+            const int edge = (side == TerrainSidePosX || side == TerrainSidePosZ) ? vertsPerSide - 1 : 0;
+            for (int i = 0; i < vertsPerSide; ++i) {
+                const int x = alongZ ? edge : i;
+                const int z = alongZ ? i : edge;
+                sideX[i] = float(chunkWorldX + x * patchSize) * noiseScale;
+                sideZ[i] = float(chunkWorldZ + z * patchSize) * noiseScale;
+            }
+            TerrainNoise::UberNoiseLowOctaves(perlin, m_noiseParams, coarserOctaves,
+                sideX.data(), sideZ.data(), sideHeights.data(), vertsPerSide);
+
+            for (int i = 0; i < vertsPerSide; ++i)
+                vertexHeights[alongZ ? i * vertsPerSide + edge : edge * vertsPerSide + i] = sideHeights[i];
+        }
+    }
+
+    // Prepare vertex array
+    m_vertices.clear();
+    m_vertices.resize(arrSize);
+
+    for (int z = 0; z < vertsPerSide; ++z) {
+        for (int x = 0; x < vertsPerSide; ++x) {
+            int idx = z * vertsPerSide + x;
+            float worldX = float(chunkWorldX + x * patchSize);
+            float worldZ = float(chunkWorldZ + z * patchSize);
+            float h = (vertexHeights[idx] + 1.0f) * 0.5f * m_heightScale;
+            m_vertices[idx].Position = XMFLOAT3(worldX, h, worldZ);
+        }
+    }
+
+    ComputeBounds(heightmapLocal, vertexHeights, vertsPerSide);
+
+    if (m_heightmapLru)
+        m_heights = std::move(heightmapLocal);
+}
+
+void TerrainChunk::ComputeBounds(const std::vector<float>& heightmapLocal, const std::vector<float>& vertexHeights, int vertsPerSide) {
+    int patchesPerSide = vertsPerSide - 1;
+
+    // The domain shader samples the heightmap with a bilinear, clamped sampler at the texel
+    // centres of the patch corners, which lands up to one texel either side of them. Take the
+    // displacement range over that neighbourhood, padded by one 16-bit step for quantization and
+    // filtering error. On seams the displacement comes from the vertex heights instead.
+    const float quantStep = (m_heightRange.y - m_heightRange.x) / 65535.0f;
+    auto rangeOver = [&](const std::vector<float>& heights, int x0, int z0, int x1, int z1, float& outMin, float& outMax) {
+        x0 = std::max(x0, 0);
+        z0 = std::max(z0, 0);
+        x1 = std::min(x1, vertsPerSide - 1);
+        z1 = std::min(z1, vertsPerSide - 1);
+        for (int z = z0; z <= z1; ++z) {
+            for (int x = x0; x <= x1; ++x) {
+                float h = heights[z * vertsPerSide + x];
+                outMin = std::min(outMin, h);
+                outMax = std::max(outMax, h);
+            }
+        }
+    };
+
+    m_patchHeights.resize(size_t(patchesPerSide) * patchesPerSide);
+
+    float chunkMinY = FLT_MAX;
+    float chunkMaxY = -FLT_MAX;
+    for (int pz = 0; pz < patchesPerSide; ++pz) {
+        for (int px = 0; px < patchesPerSide; ++px) {
+            // A stitching variant stretches border patches up to MaxStitchRatio - 1 patches
+            // along the border, so those take the range of everything they could reach.
+            const bool border = px == 0 || pz == 0 || px == patchesPerSide - 1 || pz == patchesPerSide - 1;
+            const int reach = border ? MaxStitchRatio : 1;
+
+            float dispMin = FLT_MAX;
+            float dispMax = -FLT_MAX;
+            rangeOver(heightmapLocal, px - reach, pz - reach, px + 1 + reach, pz + 1 + reach, dispMin, dispMax);
+            dispMin = (dispMin + 1.0f) * 0.5f - quantStep;
+            dispMax = (dispMax + 1.0f) * 0.5f + quantStep;
+            if (border) {
+                float seamMin = FLT_MAX;
+                float seamMax = -FLT_MAX;
+                rangeOver(vertexHeights, px - reach, pz - reach, px + 1 + reach, pz + 1 + reach, seamMin, seamMax);
+                dispMin = std::min(dispMin, (seamMin + 1.0f) * 0.5f);
+                dispMax = std::max(dispMax, (seamMax + 1.0f) * 0.5f);
+            }
+
+            // The main pass scales displacement by 255 and the shadow pass by 256; take the
+            // smaller scale for the lower bound and the larger for the upper one.
+            float minY = dispMin * (DisplacementScale - 1.0f);
+            float maxY = dispMax * DisplacementScale;
+            m_patchHeights[size_t(pz) * patchesPerSide + px] = XMFLOAT2(minY, maxY);
+
+            chunkMinY = std::min(chunkMinY, minY);
+            chunkMaxY = std::max(chunkMaxY, maxY);
+        }
+    }
+
+    int visibleSize = GetVisibleSize();
+    float chunkWorldX = float(m_chunkX * visibleSize);
+    float chunkWorldZ = float(m_chunkZ * visibleSize);
+    m_bounds.min = XMFLOAT3(chunkWorldX, chunkMinY, chunkWorldZ);
+    m_bounds.max = XMFLOAT3(chunkWorldX + float(visibleSize), chunkMaxY, chunkWorldZ + float(visibleSize));
+
+    m_patchTree.Build(patchesPerSide, m_patchHeights);
+}
+
+void TerrainChunk::CullPatches(const std::array<XMFLOAT4, 6>& planes, std::vector<IndexRange>& outRanges) const {
+    // Stitching patches on a border reach past their own footprint along it
+    const int stitchReach = m_stitchSides != 0 ? MaxStitchRatio - 1 : 0;
+    m_patchTree.Cull(planes, m_bounds.min.x, m_bounds.min.z, GetPatchSize(), stitchReach, outRanges);
+}
+
+TerrainChunkConstants TerrainChunk::GetShaderConstants() const {
+    TerrainChunkConstants constants;
+    constants.chunkOffset = XMFLOAT4(float(m_chunkX), float(m_chunkZ), float(GetVisibleSize()), float(GetVertsPerSide()));
+    constants.heightRange = XMFLOAT4(m_heightRange.x, m_heightRange.y, float(m_seamSides), 0.0f);
+    constants.heightmapSlice = XMFLOAT4(float(m_resources ? m_resources->slice : 0), float(TerrainHeightmapArray::SliceSize), 0.0f, 0.0f);
+    return constants;
+}
+
+TerrainBounds TerrainChunk::GetPatchBounds(int patchX, int patchZ) const {
+    int patchSize = GetPatchSize();
+    int patchesPerSide = GetPatchesPerSide();
+    const XMFLOAT2& heights = m_patchHeights[size_t(patchZ) * patchesPerSide + patchX];
+
+    TerrainBounds bounds;
+    bounds.min = XMFLOAT3(m_bounds.min.x + float(patchX * patchSize), heights.x, m_bounds.min.z + float(patchZ * patchSize));
+    bounds.max = XMFLOAT3(bounds.min.x + float(patchSize), heights.y, bounds.min.z + float(patchSize));
+    return bounds;
+}
+
+void TerrainChunk::SetSeams(uint32_t seamSides, uint32_t coarserSides) {
+    // Only the next tier's grid can be stitched to; anything coarser shows a crack until the
+    // neighbour catches up
+    uint32_t stitchSides = GetStitchRatio() > 1 ? (coarserSides & seamSides) : 0;
+    m_seamSides = seamSides;
+    if (stitchSides == m_stitchSides)
+        return;
+
+    m_stitchSides = stitchSides;
+    int vertsPerSide = GetVertsPerSide();
+    m_mesh.SetSharedIndexBuffer(GetPatchIndexBuffer(vertsPerSide, GetStitchRatio(), m_stitchSides), GetPatchIndexCount(vertsPerSide));
+}
+
+void TerrainChunk::CreateGPUResources(std::unordered_map<std::string, Texture*>& textures) {
+    int vertsPerSide = GetVertsPerSide();
+
+    // A recycled set of another chunk's resources when the pool has one free; the heightmap and
+    // normal map go to a slice of the pool's arrays rather than to textures of the chunk
+    assert(m_pool);
+    m_resources = m_pool->Acquire(vertsPerSide, m_vertices, m_imageData, m_normalData);
+
+    m_mesh.SetSharedVertexBuffer(m_resources->vertexBuffer);
+    m_mesh.SetSharedIndexBuffer(GetPatchIndexBuffer(vertsPerSide, GetStitchRatio(), m_stitchSides), GetPatchIndexCount(vertsPerSide));
+    m_mesh.AddTextureData(textures);
+
+    // Vertices and images live in the GPU resources now
+    std::vector<uint8_t>().swap(m_imageData);
+    std::vector<uint8_t>().swap(m_normalData);
+    m_vertices = {};
+}
+
+size_t TerrainChunk::GetPatchIndexMemory() {
+    return s_patchIndexBufferBytes;
+}
+
+UINT TerrainChunk::GetPatchIndexCount(int vertsPerSide) {
+    int patchesPerSide = vertsPerSide - 1;
+    return UINT(patchesPerSide * patchesPerSide * 4);
+}
+
+std::shared_ptr<BufferData> TerrainChunk::GetPatchIndexBuffer(int vertsPerSide, int stitchRatio, uint32_t stitchSides) {
+    // Every chunk of a tier has the same vertex grid, so one immutable index buffer per tier and
+    // stitching variant serves all of them. Variants are built the first time a seam needs them.
+    static std::unordered_map<uint32_t, std::shared_ptr<BufferData>> s_indexBuffers;
+    if (stitchRatio <= 1)
+        stitchSides = 0;
+    const uint32_t key = (uint32_t(vertsPerSide) << 12) | (uint32_t(stitchRatio) << 4) | stitchSides;
+    std::shared_ptr<BufferData>& cached = s_indexBuffers[key];
+    if (cached)
+        return cached;
+
+    // 256x256 vertices fit in 16 bits
+    assert(vertsPerSide * vertsPerSide <= 65536);
+    const int patchesPerSide = vertsPerSide - 1;
+    assert(stitchRatio % 2 == 1 && patchesPerSide % stitchRatio == 0);
+
+    // A corner on a stitched border moves to the nearest vertex the coarser neighbour also has.
+    // The patches along that border turn into a fan of triangles (two corners on one vertex)
+    // and quads that span a whole coarse edge, which covers the same area without T-junctions.
+    auto corner = [&](int x, int z) {
+        if ((x == 0 && (stitchSides & TerrainSideNegX)) || (x == patchesPerSide && (stitchSides & TerrainSidePosX)))
+            z = SnapToRatio(z, stitchRatio);
+        if ((z == 0 && (stitchSides & TerrainSideNegZ)) || (z == patchesPerSide && (stitchSides & TerrainSidePosZ)))
+            x = SnapToRatio(x, stitchRatio);
+        return uint16_t(x + z * vertsPerSide);
+    };
+
+    // Build index list for tessellated patches: patchesPerSide x patchesPerSide, each patch uses 4 control points.
+    // Patches go in Morton order so CullPatches can draw any quadtree node as one range.
+    std::vector<uint16_t> indices;
+    indices.reserve(GetPatchIndexCount(vertsPerSide));
+    for (const auto& [x, z] : TerrainPatchTree::GetPatchOrder(patchesPerSide)) {
+        indices.push_back(corner(x, z));
+        indices.push_back(corner(x + 1, z));
+        indices.push_back(corner(x, z + 1));
+        indices.push_back(corner(x + 1, z + 1));
+    }
+
+    const UINT bufferSize = UINT(indices.size() * sizeof(uint16_t));
+
+    auto indexBuffer = std::make_shared<BufferData>();
+    D3D12_HEAP_PROPERTIES properties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    D3D12_RESOURCE_DESC resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize, D3D12_RESOURCE_FLAG_NONE);
+
+    ThrowIfFailed(Application::Get().GetDevice()->CreateCommittedResource(
+        &properties,
+        D3D12_HEAP_FLAG_NONE,
+        &resourceDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&indexBuffer->m_bufferResource)));
+
+    UINT8* indexData = nullptr;
+    D3D12_RANGE range{ 0, 0 };
+    ThrowIfFailed(indexBuffer->m_bufferResource->Map(0, &range, reinterpret_cast<void**>(&indexData)));
+    memcpy(indexData, indices.data(), bufferSize);
+    indexBuffer->m_bufferResource->Unmap(0, nullptr);
+
+    indexBuffer->m_indexView.BufferLocation = indexBuffer->m_bufferResource->GetGPUVirtualAddress();
+    indexBuffer->m_indexView.Format = DXGI_FORMAT_R16_UINT;
+    indexBuffer->m_indexView.SizeInBytes = bufferSize;
+
+    cached = indexBuffer;
+    // Reported through GetPatchIndexMemory
+    s_patchIndexBufferBytes += bufferSize;
+
+    return cached;
+}
+
+void TerrainChunk::ReleaseGPUResources() {
+    // The resources hold their own reference to the vertex buffer, so this drops the mesh's only
+    m_mesh.Shutdown();
+
+    if (m_resources) {
+        m_pool->Release(std::move(m_resources));
+        m_resources.reset();
+    }
+}
+
+void TerrainChunk::SetActive(bool active) {
+    m_active = active;
+}
+
+bool TerrainChunk::IsActive() const {
+    return m_active;
+}
+
+Mesh& TerrainChunk::GetMesh() {
+    return m_mesh;
+}
+
+const Mesh& TerrainChunk::GetMesh() const {
+    return m_mesh;
+}
+
+XMFLOAT3 TerrainChunk::GetWorldPosition() const {
+    // Compute number of quads (patches) in the chunk
+    int patchCount = (m_size - 1) / 4; // -1 because we count edges between vertices
+    int chunkWorldSize = patchCount * 4; // This gives you how much space the chunk spans in world units
+
+    return XMFLOAT3(
+        static_cast<float>(m_chunkX * chunkWorldSize),
+        0.0f,
+        static_cast<float>(m_chunkZ * chunkWorldSize)
+    );
+
+    //return XMFLOAT3((float)(m_chunkX * (m_size / 4 - 1)), 0.0f, (float)(m_chunkZ * (m_size / 4 - 1)));
+}
+
+std::vector<float> TerrainChunk::GenerateChunkHeightmap(
+    FastNoiseLite::NoiseType noiseType,
+    int chunkX, int chunkZ,
+    int vertsPerSide,    // = GetVertsPerSide(), 256 at the finest tier
+    int UNUSED_height,   // same as width
+    float noiseScale)
+{
+    // UberNoise takes its slopes from the analytic Perlin gradient, which only exists for Perlin.
+    assert(noiseType == FastNoiseLite::NoiseType_Perlin);
+    assert(vertsPerSide == GetVertsPerSide());
+    m_Perlin.frequency = noiseScale;
+
+    // Coarser tiers drop the octaves their sample spacing cannot resolve
+    const TerrainLodTier& tier = LodTiers[m_lodTier];
+    const int octaves = tier.octaves > 0 ? tier.octaves : m_noiseParams.octaves;
+
+    std::vector<float> heightmapLocal(vertsPerSide * vertsPerSide);
+
+    TerrainChunkHeightmap::Grid grid;
+    grid.chunkX = chunkX;
+    grid.chunkZ = chunkZ;
+    grid.vertsPerSide = vertsPerSide;
+    grid.patchSize = GetPatchSize(); // 4 at the finest tier
+    grid.noiseScale = noiseScale;
+    grid.octaves = octaves;
+    grid.multiRate = m_lodTier == 0;
+    TerrainChunkHeightmap::Generate(m_Perlin, m_noiseParams, grid, heightmapLocal.data(), &ThreadPool::Get());
+
+    return heightmapLocal;
+}
+
+TerrainChunk::NoiseError TerrainChunk::MeasureMultiRateError() {
+    const int vertsPerSide = GetVertsPerSide();
+    std::vector<float> heights = GenerateChunkHeightmap(HeightNoiseType, m_chunkX, m_chunkZ, vertsPerSide, vertsPerSide, HeightNoiseScale);
+
+    const UberNoiseParams params = m_noiseParams;
+    m_noiseParams.coarseOctaves = 0;
+    std::vector<float> reference = GenerateChunkHeightmap(HeightNoiseType, m_chunkX, m_chunkZ, vertsPerSide, vertsPerSide, HeightNoiseScale);
+    m_noiseParams = params;
+
+    // The vertex height and the domain-shader displacement both scale (n + 1) / 2
+    const float worldScale = 0.5f * (m_heightScale + DisplacementScale - 1.0f);
+    NoiseError error;
+    double sumSquares = 0.0;
+    for (size_t i = 0; i < heights.size(); ++i) {
+        float diff = std::abs(heights[i] - reference[i]) * worldScale;
+        error.maxAbs = std::max(error.maxAbs, diff);
+        sumSquares += double(diff) * diff;
+    }
+    error.rms = float(std::sqrt(sumSquares / double(heights.size())));
+    return error;
+}
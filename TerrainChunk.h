@@ -1,65 +1,213 @@
-#pragma once
-
-#include "../DX12Renderer/DX12Renderer/Mesh.h"
-#include <DirectXMath.h>
-#include "DX12Renderer/FastNoiseLite.h"
-#include "DX12Renderer/Texture.h"
-
-using namespace DirectX;
-
-class TerrainChunk {
-public:
-    TerrainChunk(int chunkX, int chunkZ, int size, float heightScale);
-    void Initialize(const std::vector<float>& heightmap, int heightmapWidth, std::unordered_map<std::string, Texture*>& textures);
-
-    std::vector<float> GenerateChunkHeightmap(
-        FastNoiseLite::NoiseType noiseType,
-        int chunkX, int chunkZ,
-        int width, int height,
-        float noiseScale);
-
-    float FbmNoiseWithFD(float x0, float z0, int octaves, float lac, float gain, float eps, float kAtten);
-    float UberNoise(
-        float x0, float z0,
-        int   octaves,
-        float perturbAmt,
-        float sharpness,
-        float amplify,
-        float altitudeErode,
-        float ridgeErode,
-        float slopeErode,
-        float lacunarity,
-        float gain,
-        float baseFreq,
-        float eps,
-        float kAtten);
-
-    float smoothstep(float edge0, float edge1, float x);
-
-    void SetActive(bool active);
-    bool IsActive() const;
-
-    Mesh GetMesh();
-    XMFLOAT3 GetWorldPosition() const;
-
-    inline XMINT2 GetChunk() { return XMINT2(m_chunkX, m_chunkZ); }
-    inline int GetChunkSize() { return m_size; }
-
-    // Optional if you're reusing identity scaling/rotation
-    inline XMMATRIX GetWorldMatrix() const {
-        return XMMatrixTranslation(m_position.x, m_position.y, m_position.z);
-    }
-
-private:
-    int m_chunkX, m_chunkZ;
-    int m_size;
-    float m_heightScale;
-    bool m_active = true;
-
-    FastNoiseLite m_Noise;
-
-    Mesh m_mesh;
-    XMFLOAT3 m_position;
-
-    std::unique_ptr<Texture> m_heightmapTexture;
+#pragma once
+
+#include "../DX12Renderer/DX12Renderer/Mesh.h"
+#include <DirectXMath.h>
+#include <array>
+#include "DX12Renderer/FastNoiseLite.h"
+#include "DX12Renderer/Texture.h"
+#include "TerrainNoise.h"
+#include "TerrainPatchTree.h"
+
+using namespace DirectX;
+
+class TerrainChunkCache;
+class TerrainChunkPool;
+class TerrainHeightmapLru;
+struct TerrainChunkResources;
+
+// World-space axis-aligned box around the displaced terrain surface
+struct TerrainBounds {
+    XMFLOAT3 min;
+    XMFLOAT3 max;
+};
+
+// Per-chunk root constants shared by the terrain vertex and domain shaders
+struct TerrainChunkConstants {
+    XMFLOAT4 chunkOffset; // chunk x, chunk z, visible size, heightmap texels per side
+    XMFLOAT4 heightRange; // x = min, y = max normalized height the R16_UNORM heightmap spans,
+                          // z = seam sides (TerrainSide bits)
+    XMFLOAT4 heightmapSlice; // x = slice of the heightmap and normal map arrays, y = texels per
+                             // slice side
+};
+
+// Sides of a chunk, as bits of its LOD and seam masks
+enum TerrainSide : uint32_t {
+    TerrainSideNegX = 1,
+    TerrainSidePosX = 2,
+    TerrainSideNegZ = 4,
+    TerrainSidePosZ = 8,
+    TerrainSideAll = 15
+};
+
+// Heightmap resolution of a ring of chunks around the camera. Strides divide the 255 patches per
+// side and each divides the next, so a coarser chunk's border vertices are a subset of a finer
+// neighbour's.
+struct TerrainLodTier {
+    int firstRing; // Chunk distance from the camera chunk (max of |dx|, |dz|) where the tier starts
+    int stride;    // Full-resolution samples per sample
+    int octaves;   // UberNoise octaves evaluated, 0 = all; the rest are finer than the samples
+};
+
+class TerrainChunk {
+public:
+    TerrainChunk(int chunkX, int chunkZ, int size, float heightScale);
+    void Initialize(const std::vector<float>& heightmap, int heightmapWidth, std::unordered_map<std::string, Texture*>& textures);
+
+    // Initialize in two halves, for streaming. GenerateCPUData builds the heightmap, vertices and
+    // indices and touches no GPU state, so it can run on a worker thread. CreateGPUResources
+    // uploads them and has to run on the main thread.
+    void GenerateCPUData();
+    void CreateGPUResources(std::unordered_map<std::string, Texture*>& textures);
+
+    // Gives up the vertex buffer, the heightmap and normal map textures and their SRV slots:
+    // back to the pool when the chunk has one, otherwise released. Frames still in flight may
+    // reference them either way, so they are retired on the direct queue rather than freed
+    // immediately.
+    void ReleaseGPUResources();
+
+    std::vector<float> GenerateChunkHeightmap(
+        FastNoiseLite::NoiseType noiseType,
+        int chunkX, int chunkZ,
+        int width, int height,
+        float noiseScale);
+
+    // Optional heightmap cache consulted by GenerateCPUData (shared by all chunks of a manager)
+    void SetCache(std::shared_ptr<TerrainChunkCache> cache) { m_cache = std::move(cache); }
+
+    // Pool CreateGPUResources takes the GPU resources from and ReleaseGPUResources returns them
+    // to (shared by all chunks of a manager); it holds the heightmap arrays the chunk draws from.
+    // Required before CreateGPUResources.
+    void SetPool(std::shared_ptr<TerrainChunkPool> pool) { m_pool = std::move(pool); }
+
+    // Optional in-memory cache of evicted heightmaps, consulted by GenerateCPUData before the disk
+    // cache and the noise. The chunk keeps its own heights until TakeHeightmap hands them over.
+    void SetHeightmapLru(std::shared_ptr<TerrainHeightmapLru> lru) { m_heightmapLru = std::move(lru); }
+    std::vector<float> TakeHeightmap() { return std::move(m_heights); }
+    uint64_t GetParamHash() const { return m_paramHash; } // Key of the heights in both caches
+
+    // Noise parameters GenerateCPUData uses, including the multi-rate settings
+    void SetNoiseParams(const UberNoiseParams& params) { m_noiseParams = params; }
+    const UberNoiseParams& GetNoiseParams() const { return m_noiseParams; }
+
+    // LOD tiers, finest first. Tiers below the first use neither the disk cache nor multi-rate
+    // noise.
+    static constexpr std::array<TerrainLodTier, 3> LodTiers = { {
+        { 0, 1, 0 },  // 256x256, every octave
+        { 2, 3, 5 },  // 86x86
+        { 3, 15, 3 }, // 18x18
+    } };
+
+    // Tier GenerateCPUData builds the chunk at (index into LodTiers), and the sides whose border
+    // vertices carry the next coarser tier's heights instead of their own, for a coarser
+    // neighbour to stitch to. Set before GenerateCPUData.
+    void SetLod(int tier, uint32_t coarserSides);
+    int GetLodTier() const { return m_lodTier; }
+    uint32_t GetLodSides() const { return m_lodSides; }
+
+    // Sides that border a loaded chunk of another tier, and which of those border a coarser one.
+    // Picks the stitching index variant and the edges the domain shaders displace linearly.
+    // Main thread only, after CreateGPUResources.
+    void SetSeams(uint32_t seamSides, uint32_t coarserSides);
+
+    // Difference between this chunk's heights with the current multi-rate settings and with every
+    // octave evaluated per sample, in world units of rendered height (vertex plus displacement).
+    // Generates the heightmap twice, so it is meant for settings changes, not per chunk.
+    struct NoiseError {
+        float maxAbs = 0.0f;
+        float rms = 0.0f;
+    };
+    NoiseError MeasureMultiRateError();
+
+    void SetActive(bool active);
+    bool IsActive() const;
+
+    Mesh& GetMesh();
+    const Mesh& GetMesh() const;
+
+    // Patch control-point indices shared by every chunk (R16_UINT, built once on first use).
+    // A stitching variant snaps the outer vertices of the border patches on stitchSides to every
+    // stitchRatio-th vertex, the grid of the next coarser tier; patch count and order stay the
+    // same, so culling ranges hold for every variant. Main thread only.
+    static std::shared_ptr<BufferData> GetPatchIndexBuffer(int vertsPerSide, int stitchRatio = 1, uint32_t stitchSides = 0);
+    static UINT GetPatchIndexCount(int vertsPerSide);
+    static size_t GetPatchIndexMemory(); // Bytes of all the index buffers built so far
+    XMFLOAT3 GetWorldPosition() const;
+
+    // Bounds of the rendered surface (the domain-shader displacement; VSTerrain drops the vertex
+    // height), computed by GenerateCPUData. Per-patch bounds are indexed row-major.
+    const TerrainBounds& GetBounds() const { return m_bounds; }
+    TerrainBounds GetPatchBounds(int patchX, int patchZ) const;
+    int GetPatchesPerSide() const { return (m_size / 4 - 1) / LodTiers[m_lodTier].stride; }
+    int GetVertsPerSide() const { return GetPatchesPerSide() + 1; }
+    int GetVisibleSize() const { return (m_size / 4 - 1) * 4; }
+    int GetPatchSize() const { return 4 * LodTiers[m_lodTier].stride; } // World units between vertices
+
+    // Patch indices are laid out in Morton (Z) order, so every node of the chunk's min/max
+    // quadtree covers one contiguous run of the index buffer. CullPatches walks that tree and
+    // writes the index ranges of the patches that intersect the frustum, merging neighbours.
+    void CullPatches(const std::array<XMFLOAT4, 6>& planes, std::vector<IndexRange>& outRanges) const;
+    static constexpr int PatchLeafSize = TerrainPatchTree::LeafSize; // Patches per side of a quadtree leaf
+
+    // Largest displacement either terrain domain shader produces
+    // (DSTerrain scales the heightmap by 255, DSTerrainShadowMap by 256).
+    static constexpr float DisplacementScale = 256.0f;
+
+    // Largest stride ratio between neighbouring tiers: how far along a border a stitching patch
+    // can reach, in patches.
+    static constexpr int MaxStitchRatio = 5;
+
+    TerrainChunkConstants GetShaderConstants() const;
+
+    inline XMINT2 GetChunk() { return XMINT2(m_chunkX, m_chunkZ); }
+    inline int GetChunkSize() { return m_size; }
+
+    // Optional if you're reusing identity scaling/rotation
+    inline XMMATRIX GetWorldMatrix() const {
+        return XMMatrixTranslation(m_position.x, m_position.y, m_position.z);
+    }
+
+private:
+    // Stride ratio to the next coarser tier, or 1 for the coarsest
+    int GetStitchRatio() const;
+
+    void ComputeBounds(const std::vector<float>& heightmapLocal, const std::vector<float>& vertexHeights, int vertsPerSide);
+
+    static constexpr FastNoiseLite::NoiseType HeightNoiseType = FastNoiseLite::NoiseType_Perlin;
+    static constexpr float HeightNoiseScale = 0.075f;
+
+    int m_chunkX, m_chunkZ;
+    int m_size;
+    float m_heightScale;
+    bool m_active = true;
+
+    int m_lodTier = 0;
+    uint32_t m_lodSides = 0;
+    uint32_t m_seamSides = 0;
+    uint32_t m_stitchSides = 0;
+
+    TerrainNoise::PerlinSettings m_Perlin;
+    UberNoiseParams m_noiseParams;
+    std::shared_ptr<TerrainChunkCache> m_cache;
+    std::shared_ptr<TerrainChunkPool> m_pool;
+    std::shared_ptr<TerrainHeightmapLru> m_heightmapLru;
+
+    Mesh m_mesh;
+    XMFLOAT3 m_position;
+
+    // Vertex buffer, heightmap and octahedral RG8 normals of the displaced surface
+    std::shared_ptr<TerrainChunkResources> m_resources;
+    XMFLOAT2 m_heightRange = XMFLOAT2(0.0f, 1.0f); // Normalized [min, max] stored in the heightmap
+
+    TerrainBounds m_bounds = {};
+    std::vector<XMFLOAT2> m_patchHeights; // (min, max) world height per patch
+    TerrainPatchTree m_patchTree;
+
+    // Output of GenerateCPUData, released once CreateGPUResources has uploaded it
+    std::vector<uint8_t> m_imageData;
+    std::vector<uint8_t> m_normalData;
+    std::vector<VertexPosition> m_vertices;
+
+    // Noise samples behind the heightmap, kept for the LRU when the chunk is evicted
+    std::vector<float> m_heights;
+    uint64_t m_paramHash = 0;
 };
\ No newline at end of file
@@ -0,0 +1,232 @@
+#define NOMINMAX
+
+#include "TerrainChunkCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t CacheMagic = 0x4B484354; // "TCHK"
+
+    // Bump when the generator changes in a way the parameter hash cannot see
+    // (noise algorithm, sample placement, ...).
+    constexpr uint32_t CacheVersion = 2;
+
+    constexpr uint32_t InitialRecordCapacity = 64;
+
+    // 64-bit FNV-1a
+    constexpr uint64_t FnvOffset = 14695981039346656037ull;
+    constexpr uint64_t FnvPrime = 1099511628211ull;
+
+    template <typename T>
+    void HashValue(uint64_t& hash, const T& value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            hash ^= bytes[i];
+            hash *= FnvPrime;
+        }
+    }
+}
+
+TerrainChunkCache::TerrainChunkCache(const std::wstring& path, int samplesPerChunk)
+    : m_samplesPerChunk(samplesPerChunk)
+    , m_recordSize(sizeof(RecordHeader) + uint64_t(samplesPerChunk) * sizeof(float))
+{
+    m_file = ::CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (m_file == INVALID_HANDLE_VALUE) {
+        // Caching is an optimization; without the file every chunk is generated (IsOpen is false).
+        return;
+    }
+
+    LARGE_INTEGER fileSize = {};
+    ::GetFileSizeEx(m_file, &fileSize);
+
+    if (uint64_t(fileSize.QuadPart) >= sizeof(FileHeader) && Map(uint64_t(fileSize.QuadPart))) {
+        const FileHeader& header = *Header();
+        const uint64_t capacity = (m_mappedSize - sizeof(FileHeader)) / m_recordSize;
+        if (header.magic == CacheMagic && header.version == CacheVersion &&
+            header.samplesPerChunk == uint32_t(samplesPerChunk) && header.recordCount <= capacity) {
+            for (uint32_t i = 0; i < header.recordCount; ++i) {
+                const RecordHeader* record = reinterpret_cast<const RecordHeader*>(Record(i));
+                m_index[PackCoords(record->chunkX, record->chunkZ)] = i;
+            }
+            return;
+        }
+    }
+
+    // Missing, foreign or outdated file
+    Reset(0);
+}
+
+TerrainChunkCache::~TerrainChunkCache()
+{
+    Close();
+}
+
+uint64_t TerrainChunkCache::HashParams(int noiseType, const TerrainNoise::PerlinSettings& perlin,
+    const UberNoiseParams& params, int samplesPerSide)
+{
+    uint64_t hash = FnvOffset;
+    HashValue(hash, CacheVersion);
+    HashValue(hash, noiseType);
+    HashValue(hash, perlin.seed);
+    HashValue(hash, perlin.frequency);
+    HashValue(hash, params.octaves);
+    HashValue(hash, params.perturbAmt);
+    HashValue(hash, params.sharpness);
+    HashValue(hash, params.amplify);
+    HashValue(hash, params.altitudeErode);
+    HashValue(hash, params.ridgeErode);
+    HashValue(hash, params.slopeErode);
+    HashValue(hash, params.lacunarity);
+    HashValue(hash, params.gain);
+    HashValue(hash, params.kAtten);
+    if (params.coarseOctaves > 0) {
+        HashValue(hash, params.coarseOctaves);
+        HashValue(hash, params.coarseStride);
+    }
+    HashValue(hash, samplesPerSide);
+    return hash;
+}
+
+uint64_t TerrainChunkCache::HashKey(int chunkX, int chunkZ, uint64_t paramHash)
+{
+    uint64_t hash = FnvOffset;
+    HashValue(hash, paramHash);
+    HashValue(hash, chunkX);
+    HashValue(hash, chunkZ);
+    return hash;
+}
+
+uint64_t TerrainChunkCache::PackCoords(int chunkX, int chunkZ)
+{
+    return (uint64_t(uint32_t(chunkX)) << 32) | uint32_t(chunkZ);
+}
+
+bool TerrainChunkCache::Load(int chunkX, int chunkZ, uint64_t paramHash, std::vector<float>& heights)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_view || Header()->paramHash != paramHash)
+        return false;
+
+    auto it = m_index.find(PackCoords(chunkX, chunkZ));
+    if (it == m_index.end())
+        return false;
+
+    const uint8_t* record = Record(it->second);
+    if (reinterpret_cast<const RecordHeader*>(record)->keyHash != HashKey(chunkX, chunkZ, paramHash))
+        return false;
+
+    heights.resize(m_samplesPerChunk);
+    std::memcpy(heights.data(), record + sizeof(RecordHeader), m_samplesPerChunk * sizeof(float));
+    return true;
+}
+
+void TerrainChunkCache::Store(int chunkX, int chunkZ, uint64_t paramHash, const std::vector<float>& heights)
+{
+    if (heights.size() != size_t(m_samplesPerChunk))
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_view)
+        return;
+
+    // Different parameters: everything in the file is stale
+    if (Header()->paramHash != paramHash)
+        Reset(paramHash);
+    if (!m_view)
+        return;
+
+    uint32_t index;
+    auto it = m_index.find(PackCoords(chunkX, chunkZ));
+    if (it != m_index.end()) {
+        index = it->second;
+    }
+    else {
+        index = Header()->recordCount;
+        const uint64_t required = sizeof(FileHeader) + uint64_t(index + 1) * m_recordSize;
+        if (required > m_mappedSize) {
+            // Grow geometrically; the view moves, but no pointer into it outlives the lock.
+            Unmap();
+            if (!Map(std::max(required, m_mappedSize * 2)))
+                return;
+        }
+    }
+
+    uint8_t* record = Record(index);
+    RecordHeader recordHeader = { chunkX, chunkZ, HashKey(chunkX, chunkZ, paramHash) };
+    std::memcpy(record, &recordHeader, sizeof(recordHeader));
+    std::memcpy(record + sizeof(RecordHeader), heights.data(), heights.size() * sizeof(float));
+
+    // Publish the record only once its data is written
+    if (index == Header()->recordCount) {
+        Header()->recordCount = index + 1;
+        m_index[PackCoords(chunkX, chunkZ)] = index;
+    }
+}
+
+bool TerrainChunkCache::Map(uint64_t size)
+{
+    // Mapping past the end of the file grows it to 'size'.
+    m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READWRITE,
+        DWORD(size >> 32), DWORD(size & 0xFFFFFFFF), nullptr);
+    if (!m_mapping) {
+        Close();
+        return false;
+    }
+
+    m_view = static_cast<uint8_t*>(::MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (!m_view) {
+        Close();
+        return false;
+    }
+
+    m_mappedSize = size;
+    return true;
+}
+
+void TerrainChunkCache::Unmap()
+{
+    if (m_view) {
+        ::UnmapViewOfFile(m_view);
+        m_view = nullptr;
+    }
+    if (m_mapping) {
+        ::CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+    m_mappedSize = 0;
+}
+
+void TerrainChunkCache::Reset(uint64_t paramHash)
+{
+    Unmap();
+    m_index.clear();
+
+    // Truncate, then map a fresh file with room for a first batch of chunks
+    LARGE_INTEGER zero = {};
+    ::SetFilePointerEx(m_file, zero, nullptr, FILE_BEGIN);
+    ::SetEndOfFile(m_file);
+
+    if (!Map(sizeof(FileHeader) + InitialRecordCapacity * m_recordSize))
+        return;
+
+    FileHeader& header = *Header();
+    header.magic = CacheMagic;
+    header.version = CacheVersion;
+    header.paramHash = paramHash;
+    header.samplesPerChunk = uint32_t(m_samplesPerChunk);
+    header.recordCount = 0;
+}
+
+void TerrainChunkCache::Close()
+{
+    Unmap();
+    if (m_file != INVALID_HANDLE_VALUE) {
+        ::CloseHandle(m_file);
+        m_file = INVALID_HANDLE_VALUE;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "DX12Renderer/Helpers.h"
+#include "TerrainNoise.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Persistent cache of generated chunk heightmaps, kept in one memory-mapped file.
+//
+// A heightmap is a pure function of (chunkX, chunkZ, noise type, noise parameters), so it is
+// stored under a hash of exactly those inputs. The file header records the parameter hash it
+// was written with; storing a chunk under a different one resets the file, so changing any
+// noise parameter invalidates the cache without any manual step. Parameter sets that are switched
+// between at runtime (the TerrainQuality presets) therefore each get a file of their own.
+//
+// Thread-safe: chunks are generated on the worker pool.
+class TerrainChunkCache {
+public:
+    TerrainChunkCache(const std::wstring& path, int samplesPerChunk);
+    ~TerrainChunkCache();
+
+    TerrainChunkCache(const TerrainChunkCache&) = delete;
+    TerrainChunkCache& operator=(const TerrainChunkCache&) = delete;
+
+    // Hash of every input that affects a chunk's heights, apart from its coordinates.
+    static uint64_t HashParams(int noiseType, const TerrainNoise::PerlinSettings& perlin,
+        const UberNoiseParams& params, int samplesPerSide);
+
+    // Copies the cached heights into 'heights'. Returns false on a miss.
+    bool Load(int chunkX, int chunkZ, uint64_t paramHash, std::vector<float>& heights);
+    void Store(int chunkX, int chunkZ, uint64_t paramHash, const std::vector<float>& heights);
+
+    bool IsOpen() const { return m_file != INVALID_HANDLE_VALUE; }
+
+private:
+    struct FileHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t paramHash;
+        uint32_t samplesPerChunk;
+        uint32_t recordCount;
+    };
+
+    struct RecordHeader {
+        int32_t chunkX;
+        int32_t chunkZ;
+        uint64_t keyHash;
+    };
+
+    static uint64_t HashKey(int chunkX, int chunkZ, uint64_t paramHash);
+    static uint64_t PackCoords(int chunkX, int chunkZ);
+
+    bool Map(uint64_t size);
+    void Unmap();
+    void Reset(uint64_t paramHash);
+    void Close();
+
+    FileHeader* Header() const { return reinterpret_cast<FileHeader*>(m_view); }
+    uint8_t* Record(uint32_t index) const { return m_view + sizeof(FileHeader) + uint64_t(index) * m_recordSize; }
+
+    HANDLE m_file = INVALID_HANDLE_VALUE;
+    HANDLE m_mapping = nullptr;
+    uint8_t* m_view = nullptr;
+    uint64_t m_mappedSize = 0;
+
+    int m_samplesPerChunk;
+    uint64_t m_recordSize;
+
+    // Packed (chunkX, chunkZ) -> record index
+    std::unordered_map<uint64_t, uint32_t> m_index;
+    std::mutex m_mutex;
+};
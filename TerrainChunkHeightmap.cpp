@@ -0,0 +1,167 @@
+#include "TerrainChunkHeightmap.h"
+#include "DX12Renderer/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace {
+    // Catmull-Rom weights of the four coarse samples around a point t in [0, 1) of the way
+    // from the second to the third
+    std::array<float, 4> CatmullRomWeights(float t) {
+        float t2 = t * t;
+        float t3 = t2 * t;
+        return { 0.5f * (-t3 + 2.0f * t2 - t),
+                 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f),
+                 0.5f * (-3.0f * t3 + 4.0f * t2 + t),
+                 0.5f * (t3 - t2) };
+    }
+
+    // Scratch rows of the generation jobs, one set per thread. A thread runs one row job at a
+    // time, so the buffers only grow to the widest row it has seen and are not allocated per job.
+    struct RowScratch {
+        std::vector<float> rowZ;
+        std::vector<float> state;
+    };
+
+    RowScratch& ThreadRowScratch() {
+        thread_local RowScratch scratch;
+        return scratch;
+    }
+
+    // First 'size' floats of a scratch buffer, grown if it is shorter
+    float* ScratchRow(std::vector<float>& buffer, size_t size) {
+        if (buffer.size() < size)
+            buffer.resize(size);
+        return buffer.data();
+    }
+
+    // Runs func over [0, count) rows on the pool, or on this thread alone
+    void ForRows(ThreadPool* pool, int count, const std::function<void(int, int)>& func) {
+        if (pool)
+            pool->ParallelFor(count, 8, func);
+        else
+            func(0, count);
+    }
+
+    // Low octaves on a coarse grid aligned to world space, upsampled bicubically, then the
+    // remaining octaves per sample (see UberNoiseParams::coarseOctaves)
+    void GenerateMultiRate(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params,
+        const TerrainChunkHeightmap::Grid& grid, const std::vector<float>& rowX, float* out, ThreadPool* pool) {
+        const int chunkX = grid.chunkX;
+        const int chunkZ = grid.chunkZ;
+        const int vertsPerSide = grid.vertsPerSide;
+        const float noiseScale = grid.noiseScale;
+        const int patchSize = grid.patchSize;
+        const int patchesPerSide = vertsPerSide - 1;
+        const int visibleSize = patchesPerSide * patchSize;
+        const int stride = params.coarseStride;
+        const int coarseOctaves = std::min(params.coarseOctaves, params.octaves);
+        const int fields = TerrainNoise::UberNoiseStateFields;
+
+        // Coarse nodes sit on every 'stride'-th sample of the world-wide sample grid, not of this
+        // chunk, so neighbouring chunks upsample their shared edge from the same nodes and get the
+        // same heights there. offset is how far this chunk's first sample is past a node.
+        auto floorMod = [](int a, int b) { return ((a % b) + b) % b; };
+        const int offsetX = floorMod(chunkX * patchesPerSide, stride);
+        const int offsetZ = floorMod(chunkZ * patchesPerSide, stride);
+
+        // Node 0 is one node before the one at or below sample 0 (the cubic needs one on each side).
+        // Sample i lies between nodes (i + offset) / stride + 1 and the one after it.
+        auto nodeCount = [&](int offset) { return (patchesPerSide + offset) / stride + 4; };
+        const int coarseSide = std::max(nodeCount(offsetX), nodeCount(offsetZ));
+        // Rows are padded to whole SIMD blocks so none of the coarse samples take the scalar path
+        const int coarseWidth = (coarseSide + 7) & ~7;
+
+        std::vector<float> coarseX(coarseWidth);
+        for (int c = 0; c < coarseWidth; ++c)
+            coarseX[c] = float(chunkX * visibleSize + ((c - 1) * stride - offsetX) * patchSize) * noiseScale;
+
+        std::vector<std::array<float, 4>> weights(stride);
+        for (int k = 0; k < stride; ++k)
+            weights[k] = CatmullRomWeights(float(k) / float(stride));
+
+        // 1) Low octaves on the coarse grid, each row upsampled along x right away.
+        //    rows[(f * coarseSide + row) * vertsPerSide + x]
+        std::vector<float> rows(size_t(fields) * coarseSide * vertsPerSide);
+        ForRows(pool, coarseSide, [&](int rowBegin, int rowEnd) {
+            RowScratch& scratch = ThreadRowScratch();
+            float* coarseZ = ScratchRow(scratch.rowZ, coarseWidth);
+            float* state = ScratchRow(scratch.state, size_t(fields) * coarseWidth);
+            for (int row = rowBegin; row < rowEnd; ++row) {
+                float worldZ = float(chunkZ * visibleSize + ((row - 1) * stride - offsetZ) * patchSize);
+                std::fill(coarseZ, coarseZ + coarseWidth, worldZ * noiseScale);
+                TerrainNoise::UberNoiseBegin(perlin, params, coarseOctaves,
+                    coarseX.data(), coarseZ, state, coarseWidth, coarseWidth);
+
+                for (int f = 0; f < fields; ++f) {
+                    const float* src = &state[size_t(f) * coarseWidth];
+                    float* dst = &rows[(size_t(f) * coarseSide + row) * vertsPerSide];
+                    for (int x = 0, c = 0, k = offsetX; x < vertsPerSide; ++x) {
+                        const std::array<float, 4>& w = weights[k];
+                        dst[x] = w[0] * src[c] + w[1] * src[c + 1] + w[2] * src[c + 2] + w[3] * src[c + 3];
+                        if (++k == stride) {
+                            k = 0;
+                            ++c;
+                        }
+                    }
+                }
+            }
+        });
+
+        // 2) Upsample along z per output row and finish the high octaves at full resolution
+        ForRows(pool, vertsPerSide, [&](int zBegin, int zEnd) {
+            RowScratch& scratch = ThreadRowScratch();
+            float* rowZ = ScratchRow(scratch.rowZ, vertsPerSide);
+            float* state = ScratchRow(scratch.state, size_t(fields) * vertsPerSide);
+            for (int z = zBegin; z < zEnd; ++z) {
+                const int c = (z + offsetZ) / stride;
+                const std::array<float, 4>& w = weights[(z + offsetZ) % stride];
+                for (int f = 0; f < fields; ++f) {
+                    const float* r0 = &rows[(size_t(f) * coarseSide + c) * vertsPerSide];
+                    TerrainNoise::BlendRows(r0, r0 + vertsPerSide, r0 + 2 * vertsPerSide, r0 + 3 * vertsPerSide,
+                        w.data(), &state[size_t(f) * vertsPerSide], vertsPerSide);
+                }
+
+                float worldZ = float(chunkZ * visibleSize + z * patchSize);
+                std::fill(rowZ, rowZ + vertsPerSide, worldZ * noiseScale);
+                TerrainNoise::UberNoiseFinish(perlin, params, coarseOctaves,
+                    rowX.data(), rowZ, state, vertsPerSide, &out[z * vertsPerSide], vertsPerSide);
+            }
+        });
+    }
+}
+
+void TerrainChunkHeightmap::Generate(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params,
+    const Grid& grid, float* out, ThreadPool* pool) {
+    const int vertsPerSide = grid.vertsPerSide;
+    const int patchSize = grid.patchSize;
+    const int visibleSize = (vertsPerSide - 1) * patchSize;
+    const float noiseScale = grid.noiseScale;
+
+    // Sample from world position based on chunk offset, stepping by patchSize.
+    // Rows are evaluated in one batch call (8 or 4 samples per step, see TerrainNoise.h).
+    std::vector<float> rowX(vertsPerSide);
+    for (int x = 0; x < vertsPerSide; ++x) {
+        float worldX = float(grid.chunkX * visibleSize + x * patchSize);
+        rowX[x] = worldX * noiseScale;
+    }
+
+    if (grid.multiRate && params.coarseOctaves > 0 && params.coarseStride > 1) {
+        GenerateMultiRate(perlin, params, grid, rowX, out, pool);
+        return;
+    }
+
+    // Each job uses its thread's z buffer and writes only its own rows, and a sample never
+    // depends on its neighbours, so the output is the same however the rows are split.
+    ForRows(pool, vertsPerSide, [&](int zBegin, int zEnd) {
+        float* rowZ = ScratchRow(ThreadRowScratch().rowZ, vertsPerSide);
+        for (int z = zBegin; z < zEnd; ++z) {
+            float worldZ = float(grid.chunkZ * visibleSize + z * patchSize);
+            std::fill(rowZ, rowZ + vertsPerSide, worldZ * noiseScale);
+
+            TerrainNoise::UberNoiseLowOctaves(perlin, params, grid.octaves, rowX.data(), rowZ, &out[z * vertsPerSide], vertsPerSide);
+        }
+    });
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "TerrainNoise.h"
+
+class ThreadPool;
+
+// The noise heights of one terrain chunk's sample grid (TerrainChunk::GenerateChunkHeightmap).
+// CPU only: no GPU state, so the generation can be checked without a device.
+namespace TerrainChunkHeightmap
+{
+    struct Grid
+    {
+        int chunkX = 0;
+        int chunkZ = 0;
+        int vertsPerSide = 256;
+        int patchSize = 4;         // World units between samples
+        float noiseScale = 0.075f; // Multiplies world coordinates
+        int octaves = 8;           // UberNoise octaves evaluated per sample
+        // Evaluates the low octaves on a coarser grid when params.coarseOctaves asks for it (every
+        // octave, regardless of 'octaves')
+        bool multiRate = false;
+    };
+
+    // Writes vertsPerSide^2 heights, row major. With a pool the rows are split into jobs on it,
+    // otherwise they all run on this thread. A sample never depends on which job computed it, so
+    // every pool (of any size) gives the same bits as none.
+    void Generate(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params,
+        const Grid& grid, float* out, ThreadPool* pool);
+}
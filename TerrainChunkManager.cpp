@@ -1,74 +1,750 @@
-#include "TerrainChunkManager.h"
-#include <algorithm>
-#include <unordered_set>
-#include <iostream>
-#include "DX12Renderer/Application.h"
-
-TerrainChunkManager::TerrainChunkManager(int chunkSize, float heightScale)
-    : m_chunkSize(chunkSize), m_heightScale(heightScale) {}
-
-void TerrainChunkManager::UpdateChunks(const XMFLOAT3& cameraPosition, const std::vector<float>& heightmap, int heightmapWidth, std::unordered_map<std::string, Texture*>& textures) {
-    // Compute visible size and camera chunk indices
-    m_visibleSize = (m_chunkSize / m_tessFactor - 1) * m_tessFactor;
-
-    int cameraChunkX = static_cast<int>(std::floor(cameraPosition.x / float(m_visibleSize)));
-    int cameraChunkZ = static_cast<int>(std::floor(cameraPosition.z / float(m_visibleSize)));
-
-    // Prepare new active list
-    m_activeChunks.clear();
-
-    // Track which keys should remain active
-    std::unordered_set<ChunkKey, ChunkKeyHash> keysToKeep;
-    keysToKeep.reserve((2 * m_loadRadius + 1) * (2 * m_loadRadius + 1));
-
-    // Loop over the desired load-radius square
-    for (int z = cameraChunkZ - m_loadRadius; z <= cameraChunkZ + m_loadRadius; ++z) {
-        for (int x = cameraChunkX - m_loadRadius; x <= cameraChunkX + m_loadRadius; ++x) {
-            ChunkKey key = { x, z };
-            keysToKeep.insert(key);
-
-            auto it = m_chunks.find(key);
-            if (it == m_chunks.end()) {
-                // Chunk not present: create & initialize
-                auto chunk = std::make_shared<TerrainChunk>(x, z, m_chunkSize, m_heightScale);
-                chunk->Initialize(heightmap, heightmapWidth, textures);
-                chunk->SetActive(true);
-                m_chunks[key] = chunk;
-                m_activeChunks.push_back(chunk);
-                std::cout << "Activated" << '\n';
-            }
-            else {
-                // Chunk exists: ensure active
-                it->second->SetActive(true);
-                m_activeChunks.push_back(it->second);
-            }
-        }
-    }
-
-    // Unload/deactivate chunks outside the radius
-    // Iterate over m_chunks; remove those whose key is not in keysToKeep.
-    for (auto it = m_chunks.begin(); it != m_chunks.end(); ) {
-        const ChunkKey& key = it->first;
-        if (keysToKeep.find(key) == keysToKeep.end()) {
-            // This chunk is outside the load radius
-
-            // Deactivate
-            it->second->SetActive(false);
-
-            Application::Get().FlushA();
-
-            // To do : check for explicit cleanup
-            m_chunks[it->first]->GetMesh().Shutdown();
-
-            //  Erase from map to free memory
-            it = m_chunks.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
-}
-
-const std::vector<std::shared_ptr<TerrainChunk>>& TerrainChunkManager::GetActiveChunks() const {
-    return m_activeChunks;
-}
\ No newline at end of file
+#include "TerrainChunkManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "DX12Renderer/ThreadPool.h"
+#include "TerrainChunkCache.h"
+#include "TerrainHeightmapLru.h"
+
+namespace {
+    // The chunk across each side
+    struct SideNeighbour {
+        int dx, dz;
+        TerrainSide side;
+    };
+    const SideNeighbour SideNeighbours[] = {
+        { -1, 0, TerrainSideNegX }, { 1, 0, TerrainSidePosX }, { 0, -1, TerrainSideNegZ }, { 0, 1, TerrainSidePosZ } };
+}
+
+TerrainChunkManager::TerrainChunkManager(int chunkSize, float heightScale)
+    : m_chunkSize(chunkSize), m_heightScale(heightScale) {
+    int vertsPerSide = m_chunkSize / m_tessFactor;
+    m_cache = std::make_shared<TerrainChunkCache>(CacheFileName(m_quality), vertsPerSide * vertsPerSide);
+    m_qualityCaches[static_cast<int>(m_quality)] = m_cache;
+    m_heightmapLru = std::make_shared<TerrainHeightmapLru>(DefaultHeightmapLruBytes, false);
+}
+
+void TerrainChunkManager::SetHeightmapLruBudget(size_t bytes) {
+    m_heightmapLru->SetByteBudget(bytes);
+}
+
+void TerrainChunkManager::SetHeightmapLruQuantized(bool quantize) {
+    m_heightmapLru->SetQuantized(quantize);
+}
+
+void TerrainChunkManager::UpdateChunks(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraVelocity, const XMFLOAT3& viewDirection,
+    const std::vector<float>& heightmap, int heightmapWidth, std::unordered_map<std::string, Texture*>& textures) {
+    // Compute visible size and camera chunk indices
+    m_visibleSize = (m_chunkSize / m_tessFactor - 1) * m_tessFactor;
+
+    int cameraChunkX = static_cast<int>(std::floor(cameraPosition.x / float(m_visibleSize)));
+    int cameraChunkZ = static_cast<int>(std::floor(cameraPosition.z / float(m_visibleSize)));
+
+    UpdateCameraMotion(cameraPosition, cameraVelocity, viewDirection);
+
+    // Only a chunk boundary crossing changes which chunks belong to the window
+    if (m_grid.empty() || m_gridSize != 2 * m_unloadRadius + 1 || m_regenerateChunks) {
+        m_regenerateChunks = false;
+        ResetGrid(cameraChunkX, cameraChunkZ);
+        UpdatePendingChunks(cameraChunkX, cameraChunkZ);
+    }
+    else if (cameraChunkX != m_gridCenterX || cameraChunkZ != m_gridCenterZ) {
+        ScrollGrid(cameraChunkX, cameraChunkZ);
+        UpdateLods(cameraChunkX, cameraChunkZ);
+        UpdatePendingChunks(cameraChunkX, cameraChunkZ);
+    }
+
+    // Start on what the window will ask for next, behind everything it asks for now
+    UpdatePrefetch(cameraChunkX, cameraChunkZ);
+
+    // Upload finished chunks, nearest first, within this frame's budget
+    CommitCompletedChunks(textures);
+
+    if (m_activeChunksDirty)
+        RebuildActiveChunks();
+}
+
+std::wstring TerrainChunkManager::CacheFileName(TerrainQuality quality) {
+    // Reference keeps the name it always had, so caches written before the presets stay valid
+    switch (quality) {
+    case TerrainQuality::Balanced: return L"TerrainChunkCache_Balanced.bin";
+    case TerrainQuality::Fast:     return L"TerrainChunkCache_Fast.bin";
+    default:                       return L"TerrainChunkCache.bin";
+    }
+}
+
+void TerrainChunkManager::SetQuality(TerrainQuality quality) {
+    struct Preset {
+        int coarseOctaves;
+        int coarseStride;
+        float maxError; // World units; measured worst cases are about 1.6 (Balanced) and 11 (Fast)
+    };
+    static const Preset presets[] = {
+        { 0, 1, 0.0f },  // Reference
+        { 3, 4, 2.5f },  // Balanced
+        { 5, 4, 16.0f }, // Fast
+    };
+
+    const Preset& preset = presets[static_cast<int>(quality)];
+    UberNoiseParams params = m_noiseParams;
+    params.coarseOctaves = preset.coarseOctaves;
+    params.coarseStride = preset.coarseStride;
+
+    TerrainChunk::NoiseError error;
+    if (params.coarseOctaves > 0) {
+        TerrainChunk probe(m_gridCenterX, m_gridCenterZ, m_chunkSize, m_heightScale);
+        probe.SetNoiseParams(params);
+        error = probe.MeasureMultiRateError();
+
+        if (error.maxAbs > preset.maxError) {
+            quality = TerrainQuality::Reference;
+            params.coarseOctaves = 0;
+            error = {};
+        }
+    }
+
+    if (quality == m_quality)
+        return;
+
+    m_quality = quality;
+    m_noiseParams = params;
+    m_noiseError = error;
+    m_regenerateChunks = true;
+
+    // Chunks still generating keep the cache they were started with, under the old parameters
+    std::shared_ptr<TerrainChunkCache>& cache = m_qualityCaches[static_cast<int>(quality)];
+    if (!cache) {
+        const int vertsPerSide = m_chunkSize / m_tessFactor;
+        cache = std::make_shared<TerrainChunkCache>(CacheFileName(quality), vertsPerSide * vertsPerSide);
+    }
+    m_cache = cache;
+}
+
+const std::vector<std::shared_ptr<TerrainChunk>>& TerrainChunkManager::GetActiveChunks() const {
+    return m_activeChunks;
+}
+
+TerrainChunkManager::ChunkSlot& TerrainChunkManager::GetSlot(int chunkX, int chunkZ) {
+    int x = chunkX % m_gridSize;
+    int z = chunkZ % m_gridSize;
+    if (x < 0) x += m_gridSize;
+    if (z < 0) z += m_gridSize;
+    return m_grid[z * m_gridSize + x];
+}
+
+void TerrainChunkManager::ResetGrid(int cameraChunkX, int cameraChunkZ) {
+    for (ChunkSlot& slot : m_grid)
+        ReleaseSlot(slot);
+
+    // Built for the old window (or the old noise settings)
+    CancelPrefetch();
+
+    m_gridSize = 2 * m_unloadRadius + 1;
+    m_grid.clear();
+    m_grid.resize(m_gridSize * m_gridSize);
+    m_activeChunks.reserve(m_grid.size());
+    m_gridCenterX = cameraChunkX;
+    m_gridCenterZ = cameraChunkZ;
+
+    for (int z = cameraChunkZ - m_loadRadius; z <= cameraChunkZ + m_loadRadius; ++z) {
+        for (int x = cameraChunkX - m_loadRadius; x <= cameraChunkX + m_loadRadius; ++x) {
+            ReplaceSlot(GetSlot(x, z), { x, z }, cameraChunkX, cameraChunkZ);
+        }
+    }
+}
+
+void TerrainChunkManager::ScrollGrid(int cameraChunkX, int cameraChunkZ) {
+    // A jump of a full window or more replaces every slot anyway
+    if (std::abs(cameraChunkX - m_gridCenterX) >= m_gridSize || std::abs(cameraChunkZ - m_gridCenterZ) >= m_gridSize) {
+        ResetGrid(cameraChunkX, cameraChunkZ);
+        return;
+    }
+
+    // Step one chunk at a time. The column leaving the unload radius on one side maps to the
+    // same slots as the column entering it on the other, so each step frees exactly one
+    // column/row. The column that comes into the load radius is requested unless it is still
+    // loaded from an earlier visit.
+    while (m_gridCenterX != cameraChunkX) {
+        int step = cameraChunkX > m_gridCenterX ? 1 : -1;
+        m_gridCenterX += step;
+        int leavingX = m_gridCenterX - step * (m_unloadRadius + 1);
+        for (int z = m_gridCenterZ - m_unloadRadius; z <= m_gridCenterZ + m_unloadRadius; ++z)
+            ReleaseSlot(GetSlot(leavingX, z));
+
+        int enteringX = m_gridCenterX + step * m_loadRadius;
+        for (int z = m_gridCenterZ - m_loadRadius; z <= m_gridCenterZ + m_loadRadius; ++z)
+            EnsureSlot(GetSlot(enteringX, z), { enteringX, z }, cameraChunkX, cameraChunkZ);
+    }
+
+    while (m_gridCenterZ != cameraChunkZ) {
+        int step = cameraChunkZ > m_gridCenterZ ? 1 : -1;
+        m_gridCenterZ += step;
+        int leavingZ = m_gridCenterZ - step * (m_unloadRadius + 1);
+        for (int x = m_gridCenterX - m_unloadRadius; x <= m_gridCenterX + m_unloadRadius; ++x)
+            ReleaseSlot(GetSlot(x, leavingZ));
+
+        int enteringZ = m_gridCenterZ + step * m_loadRadius;
+        for (int x = m_gridCenterX - m_loadRadius; x <= m_gridCenterX + m_loadRadius; ++x)
+            EnsureSlot(GetSlot(x, enteringZ), { x, enteringZ }, cameraChunkX, cameraChunkZ);
+    }
+}
+
+void TerrainChunkManager::EnsureSlot(ChunkSlot& slot, const ChunkKey& key, int cameraChunkX, int cameraChunkZ) {
+    // Kept by the unload radius: UpdateLods brings it to the LOD of its new ring
+    if (slot.key == key && (slot.chunk || slot.request))
+        return;
+
+    ReplaceSlot(slot, key, cameraChunkX, cameraChunkZ);
+}
+
+void TerrainChunkManager::ReplaceSlot(ChunkSlot& slot, const ChunkKey& key, int cameraChunkX, int cameraChunkZ) {
+    ReleaseSlot(slot);
+
+    // Generated in the background; the neighbours that are already loaded keep rendering
+    // until it is committed.
+    RequestChunk(slot, key, cameraChunkX, cameraChunkZ, false);
+}
+
+void TerrainChunkManager::ReleaseSlot(ChunkSlot& slot) {
+    if (slot.chunk) {
+        // Outside the unload radius
+        RetireChunk(*slot.chunk);
+        slot.chunk.reset();
+        --m_loadedChunkCount;
+        m_activeChunksDirty = true;
+    }
+
+    // Left the load radius before it was committed
+    CancelRequest(slot);
+}
+
+void TerrainChunkManager::RetireChunk(TerrainChunk& chunk) {
+    // GPU resources are retired on the queue and released (or recycled) once the frames that
+    // drew the chunk have completed; the heights go to the LRU in case the camera comes back
+    chunk.SetActive(false);
+    chunk.ReleaseGPUResources();
+
+    const XMINT2 key = chunk.GetChunk();
+    m_heightmapLru->Store(key.x, key.y, chunk.GetParamHash(), chunk.TakeHeightmap());
+}
+
+void TerrainChunkManager::CancelRequest(ChunkSlot& slot) {
+    if (slot.request) {
+        // A worker that already started on it finishes, but the result is dropped
+        slot.request->cancelled = true;
+        slot.request.reset();
+        --m_pendingCount;
+    }
+}
+
+void TerrainChunkManager::RebuildActiveChunks() {
+    // At most one entry per slot, and the capacity was reserved when the grid was sized
+    m_activeChunks.clear();
+    for (const ChunkSlot& slot : m_grid) {
+        if (slot.chunk)
+            m_activeChunks.push_back(slot.chunk);
+    }
+    UpdateSeams();
+    m_activeChunksDirty = false;
+}
+
+int TerrainChunkManager::GetLodTier(const ChunkKey& key, int cameraChunkX, int cameraChunkZ) const {
+    int ring = std::max(std::abs(key.first - cameraChunkX), std::abs(key.second - cameraChunkZ));
+    int tier = 0;
+    while (tier + 1 < int(TerrainChunk::LodTiers.size()) && ring >= TerrainChunk::LodTiers[tier + 1].firstRing)
+        ++tier;
+    return tier;
+}
+
+uint32_t TerrainChunkManager::GetLodSides(const ChunkKey& key, int cameraChunkX, int cameraChunkZ) const {
+    const int tier = GetLodTier(key, cameraChunkX, cameraChunkZ);
+    if (tier + 1 >= int(TerrainChunk::LodTiers.size()) || m_loadRadius < TerrainChunk::LodTiers[tier + 1].firstRing)
+        return 0;
+
+    // The finest tier never borders a finer one, so it takes the next tier's heights on every
+    // side and never has to be regenerated because its neighbours changed
+    if (tier == 0)
+        return TerrainSideAll;
+
+    // Rings are squares, so a chunk never borders a finer and a coarser tier on two sides that
+    // share a corner
+    uint32_t sides = 0;
+    for (const SideNeighbour& n : SideNeighbours) {
+        ChunkKey neighbour(key.first + n.dx, key.second + n.dz);
+        int ring = std::max(std::abs(neighbour.first - cameraChunkX), std::abs(neighbour.second - cameraChunkZ));
+        if (ring <= m_loadRadius && GetLodTier(neighbour, cameraChunkX, cameraChunkZ) > tier)
+            sides |= n.side;
+    }
+    return sides;
+}
+
+void TerrainChunkManager::UpdateLods(int cameraChunkX, int cameraChunkZ) {
+    for (ChunkSlot& slot : m_grid) {
+        const int tier = GetLodTier(slot.key, cameraChunkX, cameraChunkZ);
+        const uint32_t sides = GetLodSides(slot.key, cameraChunkX, cameraChunkZ);
+        auto matches = [&](const TerrainChunk& chunk) { return chunk.GetLodTier() == tier && chunk.GetLodSides() == sides; };
+
+        const TerrainChunk* latest = slot.request ? slot.request->chunk.get() : slot.chunk.get();
+        if (!latest || matches(*latest))
+            continue;
+
+        // The camera came back before a LOD change finished, or moved on again
+        CancelRequest(slot);
+        if (slot.chunk && matches(*slot.chunk))
+            continue;
+
+        // Upgraded (or downgraded) in place: the committed chunk keeps drawing meanwhile
+        RequestChunk(slot, slot.key, cameraChunkX, cameraChunkZ, slot.chunk != nullptr);
+    }
+}
+
+void TerrainChunkManager::UpdateSeams() {
+    for (ChunkSlot& slot : m_grid) {
+        if (!slot.chunk)
+            continue;
+
+        const int tier = slot.chunk->GetLodTier();
+        uint32_t seamSides = 0;
+        uint32_t coarserSides = 0;
+        for (const SideNeighbour& n : SideNeighbours) {
+            const int x = slot.key.first + n.dx;
+            const int z = slot.key.second + n.dz;
+            const ChunkSlot& neighbour = GetSlot(x, z);
+            if (!neighbour.chunk || neighbour.key != ChunkKey(x, z))
+                continue;
+
+            const int neighbourTier = neighbour.chunk->GetLodTier();
+            if (neighbourTier != tier)
+                seamSides |= n.side;
+            if (neighbourTier > tier)
+                coarserSides |= n.side;
+        }
+        slot.chunk->SetSeams(seamSides, coarserSides);
+    }
+}
+
+float TerrainChunkManager::GetPriority(const ChunkKey& key, int cameraChunkX, int cameraChunkZ, bool lodChange) const {
+    const float dx = float(key.first - cameraChunkX);
+    const float dz = float(key.second - cameraChunkZ);
+    float priority = dx * dx + dz * dz;
+
+    // The camera is moving away from (or looking away from) what is behind it
+    const float distance = std::sqrt(priority);
+    if (distance > 0.0f) {
+        const float cosine = (dx * m_heading.x + dz * m_heading.y) / distance;
+        priority *= 1.0f + BehindWeight * std::max(0.0f, -cosine);
+    }
+
+    // A hole in the terrain is worse than a chunk at the wrong resolution
+    const float holePriorityBound = (1.0f + BehindWeight) * float(m_gridSize * m_gridSize);
+    return priority + (lodChange ? holePriorityBound : 0.0f);
+}
+
+void TerrainChunkManager::RequestChunk(ChunkSlot& slot, const ChunkKey& key, int cameraChunkX, int cameraChunkZ, bool lodChange) {
+    const int tier = GetLodTier(key, cameraChunkX, cameraChunkZ);
+    const uint32_t lodSides = GetLodSides(key, cameraChunkX, cameraChunkZ);
+    const float priority = GetPriority(key, cameraChunkX, cameraChunkZ, lodChange);
+
+    std::shared_ptr<ChunkRequest> request = TakePrefetched(key, tier, lodSides);
+    if (request) {
+        std::lock_guard<std::mutex> lock(m_streamingQueue->mutex);
+        request->priority = priority;
+        // Finished while it waited for the window: commit it like any other result
+        if (request->parked) {
+            request->parked = false;
+            m_streamingQueue->completed.push_back(request);
+        }
+    }
+    else {
+        request = CreateRequest(key, tier, lodSides, priority);
+    }
+
+    request->lodChange = lodChange;
+    slot.key = key;
+    slot.request = request;
+    ++m_pendingCount;
+}
+
+std::shared_ptr<TerrainChunkManager::ChunkRequest> TerrainChunkManager::CreateRequest(const ChunkKey& key, int tier, uint32_t lodSides, float priority) {
+    auto request = std::make_shared<ChunkRequest>();
+    request->key = key;
+    request->priority = priority;
+    request->chunk = std::make_shared<TerrainChunk>(key.first, key.second, m_chunkSize, m_heightScale);
+    request->chunk->SetCache(m_cache);
+    request->chunk->SetPool(m_pool);
+    request->chunk->SetHeightmapLru(m_heightmapLru);
+    request->chunk->SetNoiseParams(m_noiseParams);
+    request->chunk->SetLod(tier, lodSides);
+
+    {
+        std::lock_guard<std::mutex> lock(m_streamingQueue->mutex);
+        m_streamingQueue->waiting.push_back(request);
+    }
+
+    // One job per request; each job takes whichever waiting request is nearest when it starts,
+    // so the pool's FIFO order does not decide the load order.
+    std::shared_ptr<StreamingQueue> queue = m_streamingQueue;
+    ThreadPool::Get().Submit([queue]() { GenerateNextChunk(queue); });
+    return request;
+}
+
+void TerrainChunkManager::UpdateCameraMotion(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraVelocity, const XMFLOAT3& viewDirection) {
+    m_cameraPosition = XMFLOAT2(cameraPosition.x, cameraPosition.z);
+    m_cameraVelocity = XMFLOAT2(cameraVelocity.x, cameraVelocity.z);
+
+    // Below walking pace the view direction says more about what is needed next
+    const float MinHeadingSpeed = 1.0f;
+    XMFLOAT2 heading = m_cameraVelocity;
+    if (std::hypot(heading.x, heading.y) < MinHeadingSpeed)
+        heading = XMFLOAT2(viewDirection.x, viewDirection.z);
+
+    // Looking straight down (or standing still with no view direction) favours no side
+    const float length = std::hypot(heading.x, heading.y);
+    m_heading = length > 1e-3f ? XMFLOAT2(heading.x / length, heading.y / length) : XMFLOAT2(0.0f, 0.0f);
+}
+
+void TerrainChunkManager::UpdatePrefetch(int cameraChunkX, int cameraChunkZ) {
+    const XMFLOAT2 travel(m_cameraVelocity.x * m_predictionHorizon, m_cameraVelocity.y * m_predictionHorizon);
+    // Quarter-chunk steps do not skip a chunk the path only clips
+    const int steps = m_predictionHorizon > 0.0f ? int(std::ceil(std::hypot(travel.x, travel.y) / (0.25f * float(m_visibleSize)))) : 0;
+    auto chunkAt = [&](int step) {
+        const float t = float(step) / float(steps);
+        return ChunkKey(
+            int(std::floor((m_cameraPosition.x + travel.x * t) / float(m_visibleSize))),
+            int(std::floor((m_cameraPosition.y + travel.y * t) / float(m_visibleSize))));
+    };
+
+    // The plan only changes when the camera or the predicted end of its path changes chunk. A
+    // straight path never comes back to a chunk it left, so its end is the chunk of the last step.
+    const ChunkKey from(cameraChunkX, cameraChunkZ);
+    const ChunkKey to = steps > 0 ? chunkAt(steps) : from;
+    if (from == m_prefetchFrom && to == m_prefetchTo)
+        return;
+    m_prefetchFrom = from;
+    m_prefetchTo = to;
+
+    // Predicted camera chunks after the current one, in the order the camera reaches them
+    std::vector<ChunkKey>& path = m_prefetchPath;
+    path.clear();
+    ChunkKey previous = from;
+    for (int i = 1; i <= steps; ++i) {
+        const ChunkKey chunk = chunkAt(i);
+        if (chunk != previous)
+            path.push_back(chunk);
+        previous = chunk;
+    }
+
+    // What each predicted window would request that the current one does not already hold
+    // (or have in flight) at that LOD. A chunk goes in at the first step that needs it.
+    std::vector<Prefetch>& plan = m_prefetchPlan;
+    plan.clear();
+    const float holePriorityBound = (1.0f + BehindWeight) * float(m_gridSize * m_gridSize);
+    for (size_t step = 0; step < path.size() && plan.size() < MaxPrefetchedChunks; ++step) {
+        const ChunkKey& camera = path[step];
+        std::vector<Prefetch>& stepPlan = m_prefetchStepPlan;
+        stepPlan.clear();
+        for (int z = camera.second - m_loadRadius; z <= camera.second + m_loadRadius; ++z) {
+            for (int x = camera.first - m_loadRadius; x <= camera.first + m_loadRadius; ++x) {
+                const ChunkKey key(x, z);
+                const int tier = GetLodTier(key, camera.first, camera.second);
+                const uint32_t lodSides = GetLodSides(key, camera.first, camera.second);
+                auto planned = [&](const Prefetch& p) { return p.key == key; };
+                if (std::any_of(plan.begin(), plan.end(), planned))
+                    continue;
+
+                if (std::max(std::abs(x - cameraChunkX), std::abs(z - cameraChunkZ)) <= m_unloadRadius) {
+                    const ChunkSlot& slot = GetSlot(x, z);
+                    const TerrainChunk* latest = slot.request ? slot.request->chunk.get() : slot.chunk.get();
+                    if (slot.key == key && latest && latest->GetLodTier() == tier && latest->GetLodSides() == lodSides)
+                        continue;
+                }
+
+                // Behind every request of the current window, earlier steps first
+                const float priority = (2.0f + float(step)) * holePriorityBound + GetPriority(key, camera.first, camera.second, false);
+                stepPlan.push_back({ key, tier, lodSides, priority });
+            }
+        }
+
+        std::sort(stepPlan.begin(), stepPlan.end(), [](const Prefetch& a, const Prefetch& b) { return a.priority < b.priority; });
+        stepPlan.resize(std::min(stepPlan.size(), MaxPrefetchedChunks - plan.size()));
+        plan.insert(plan.end(), stepPlan.begin(), stepPlan.end());
+    }
+
+    // Keep what is still in the plan, drop the rest and start the new entries
+    std::vector<std::shared_ptr<ChunkRequest>>& kept = m_prefetchKept;
+    kept.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_streamingQueue->mutex);
+        for (const auto& request : m_prefetched) {
+            auto match = std::find_if(plan.begin(), plan.end(), [&](const Prefetch& p) {
+                return p.key == request->key && p.tier == request->chunk->GetLodTier() && p.lodSides == request->chunk->GetLodSides();
+            });
+            if (match == plan.end()) {
+                request->cancelled = true;
+                continue;
+            }
+            request->priority = match->priority;
+            kept.push_back(request);
+            *match = plan.back();
+            plan.pop_back();
+        }
+    }
+    m_prefetched.swap(kept);
+    kept.clear();
+
+    for (const Prefetch& p : plan) {
+        auto request = CreateRequest(p.key, p.tier, p.lodSides, p.priority);
+        request->prefetched = true;
+        m_prefetched.push_back(request);
+    }
+
+    // The heading may have turned since the pending requests were last ranked
+    UpdatePendingChunks(cameraChunkX, cameraChunkZ);
+}
+
+std::shared_ptr<TerrainChunkManager::ChunkRequest> TerrainChunkManager::TakePrefetched(const ChunkKey& key, int tier, uint32_t lodSides) {
+    auto it = std::find_if(m_prefetched.begin(), m_prefetched.end(), [&](const auto& request) { return request->key == key; });
+    if (it == m_prefetched.end())
+        return nullptr;
+
+    std::shared_ptr<ChunkRequest> request = *it;
+    *it = m_prefetched.back();
+    m_prefetched.pop_back();
+
+    // The camera took another way there, so the chunk's LOD would be off
+    if (request->chunk->GetLodTier() != tier || request->chunk->GetLodSides() != lodSides) {
+        request->cancelled = true;
+        return nullptr;
+    }
+
+    request->prefetched = false;
+    return request;
+}
+
+void TerrainChunkManager::CancelPrefetch() {
+    for (const auto& request : m_prefetched)
+        request->cancelled = true;
+    m_prefetched.clear();
+    m_prefetchFrom = m_prefetchTo = { INT_MIN, INT_MIN };
+}
+
+void TerrainChunkManager::UpdatePendingChunks(int cameraChunkX, int cameraChunkZ) {
+    std::lock_guard<std::mutex> lock(m_streamingQueue->mutex);
+
+    // Requests that left the window were cancelled when their slot was replaced
+    for (ChunkSlot& slot : m_grid) {
+        if (!slot.request)
+            continue;
+
+        slot.request->priority = GetPriority(slot.key, cameraChunkX, cameraChunkZ, slot.request->lodChange);
+    }
+
+    auto isCancelled = [](const std::shared_ptr<ChunkRequest>& request) { return request->cancelled.load(); };
+    auto& waiting = m_streamingQueue->waiting;
+    waiting.erase(std::remove_if(waiting.begin(), waiting.end(), isCancelled), waiting.end());
+    auto& completed = m_streamingQueue->completed;
+    completed.erase(std::remove_if(completed.begin(), completed.end(), isCancelled), completed.end());
+}
+
+void TerrainChunkManager::CommitCompletedChunks(std::unordered_map<std::string, Texture*>& textures) {
+    // The buffers trade places with the queue's, so neither reallocates once it has grown
+    std::vector<std::shared_ptr<ChunkRequest>>& ready = m_readyRequests;
+    {
+        std::lock_guard<std::mutex> lock(m_streamingQueue->mutex);
+        ready.swap(m_streamingQueue->completed);
+    }
+    if (ready.empty())
+        return;
+
+    // Prefetched chunks wait for the window to reach them (see RequestChunk)
+    for (const auto& request : ready) {
+        if (request->prefetched && !request->cancelled)
+            request->parked = true;
+    }
+
+    auto isStale = [&](const std::shared_ptr<ChunkRequest>& request) {
+        return request->cancelled || request->prefetched || GetSlot(request->key.first, request->key.second).request != request;
+    };
+    ready.erase(std::remove_if(ready.begin(), ready.end(), isStale), ready.end());
+    if (ready.empty())
+        return;
+    std::sort(ready.begin(), ready.end(), [](const auto& a, const auto& b) { return a->priority < b->priority; });
+
+    // LOD changes swap chunks that are already visible. The stitching variants bridge one tier,
+    // so a swap waits while a committed neighbour would end up two tiers away, and swaps that
+    // wait for each other go in the same frame: start from every finished swap and drop the ones
+    // that would still leave such a neighbour, until none do.
+    std::vector<int>& swapTier = m_swapTiers; // New tier per slot whose swap goes this frame
+    swapTier.assign(m_grid.size(), -1);
+    for (const auto& request : ready) {
+        if (request->lodChange)
+            swapTier[&GetSlot(request->key.first, request->key.second) - m_grid.data()] = request->chunk->GetLodTier();
+    }
+    for (bool dropped = true; dropped;) {
+        dropped = false;
+        for (size_t i = 0; i < m_grid.size(); ++i) {
+            if (swapTier[i] < 0)
+                continue;
+
+            for (const SideNeighbour& n : SideNeighbours) {
+                const int x = m_grid[i].key.first + n.dx;
+                const int z = m_grid[i].key.second + n.dz;
+                const ChunkSlot& neighbour = GetSlot(x, z);
+                if (!neighbour.chunk || neighbour.key != ChunkKey(x, z))
+                    continue;
+
+                const int neighbourIndex = int(&neighbour - m_grid.data());
+                const int neighbourTier = swapTier[neighbourIndex] >= 0 ? swapTier[neighbourIndex] : neighbour.chunk->GetLodTier();
+                if (std::abs(neighbourTier - swapTier[i]) > 1) {
+                    swapTier[i] = -1;
+                    dropped = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Swaps are not held to the budget (a group split across frames would crack); new chunks are
+    std::vector<std::shared_ptr<ChunkRequest>>& deferred = m_deferredRequests;
+    auto start = std::chrono::steady_clock::now();
+    size_t loaded = 0;
+    for (const auto& request : ready) {
+        ChunkSlot& slot = GetSlot(request->key.first, request->key.second);
+        if (request->lodChange) {
+            if (swapTier[&slot - m_grid.data()] >= 0)
+                CommitChunk(slot, textures);
+            else
+                deferred.push_back(request);
+            continue;
+        }
+
+        if (loaded > 0) {
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= m_commitBudgetMs) {
+                // Over budget: the rest waits for the next frame
+                deferred.push_back(request);
+                continue;
+            }
+        }
+
+        CommitChunk(slot, textures);
+        ++loaded;
+    }
+
+    if (!deferred.empty()) {
+        std::lock_guard<std::mutex> lock(m_streamingQueue->mutex);
+        auto& completed = m_streamingQueue->completed;
+        completed.insert(completed.end(), deferred.begin(), deferred.end());
+    }
+    ready.clear();
+    deferred.clear();
+
+    // Streaming settled: report what the shared patch index buffers save and what LOD costs
+    if (m_pendingCount == 0 && m_logStats) {
+        ReportIndexMemory();
+        ReportLodStats();
+        ReportPoolStats();
+        ReportHeightmapLru();
+    }
+}
+
+void TerrainChunkManager::CommitChunk(ChunkSlot& slot, std::unordered_map<std::string, Texture*>& textures) {
+    std::shared_ptr<TerrainChunk> chunk = slot.request->chunk;
+    chunk->CreateGPUResources(textures);
+    chunk->SetActive(true);
+
+    if (slot.chunk) {
+        // LOD change: the chunk it replaces is retired like one that left the radius
+        RetireChunk(*slot.chunk);
+    }
+    else {
+        ++m_loadedChunkCount;
+    }
+
+    slot.chunk = chunk;
+    slot.request.reset();
+    --m_pendingCount;
+    m_activeChunksDirty = true;
+}
+
+void TerrainChunkManager::ReportIndexMemory() const {
+    size_t perChunkBytes = 0;
+    for (const ChunkSlot& slot : m_grid) {
+        if (slot.chunk)
+            perChunkBytes += TerrainChunk::GetPatchIndexCount(slot.chunk->GetVertsPerSide()) * sizeof(UINT);
+    }
+
+    char buffer[256];
+    sprintf_s(buffer, "Terrain index memory: %zu chunks use %zu KB (shared R16_UINT buffers per tier and stitching variant)"
+        " instead of %zu MB (R32_UINT per chunk)\n", m_loadedChunkCount, TerrainChunk::GetPatchIndexMemory() / 1024,
+        perChunkBytes / (1024 * 1024));
+    OutputDebugStringA(buffer);
+}
+
+void TerrainChunkManager::ReportLodStats() const {
+    std::array<int, TerrainChunk::LodTiers.size()> chunksPerTier = {};
+    size_t samples = 0;
+    size_t fullSamples = 0;
+    for (const ChunkSlot& slot : m_grid) {
+        if (!slot.chunk)
+            continue;
+        const size_t vertsPerSide = size_t(slot.chunk->GetVertsPerSide());
+        const size_t fullVertsPerSide = size_t(m_chunkSize / m_tessFactor);
+        ++chunksPerTier[slot.chunk->GetLodTier()];
+        samples += vertsPerSide * vertsPerSide;
+        fullSamples += fullVertsPerSide * fullVertsPerSide;
+    }
+
+    char buffer[256];
+    int length = sprintf_s(buffer, "Terrain LOD: chunks per tier");
+    for (int count : chunksPerTier)
+        length += sprintf_s(buffer + length, sizeof(buffer) - length, " %d", count);
+    sprintf_s(buffer + length, sizeof(buffer) - length, ", %zu heightmap samples instead of %zu, %lld ms of worker time generating\n",
+        samples, fullSamples, static_cast<long long>(m_streamingQueue->generationMicroseconds.exchange(0) / 1000));
+    OutputDebugStringA(buffer);
+}
+
+void TerrainChunkManager::ReportPoolStats() const {
+    TerrainChunkPool::Stats stats = m_pool->GetStats();
+    char buffer[256];
+    sprintf_s(buffer, "Terrain chunk pool: %zu resource sets created (%zu MB), %zu chunks reused one, %zu free\n",
+        stats.created, stats.bytes / (1024 * 1024), stats.recycled, stats.free);
+    OutputDebugStringA(buffer);
+}
+
+void TerrainChunkManager::ReportHeightmapLru() const {
+    TerrainHeightmapLru::Stats stats = m_heightmapLru->TakeStats();
+    char buffer[256];
+    sprintf_s(buffer, "Terrain heightmap LRU: %zu of %zu generated chunks skipped the noise, %zu heightmaps in %zu KB\n",
+        stats.hits, stats.hits + stats.misses, stats.entries, stats.bytes / 1024);
+    OutputDebugStringA(buffer);
+}
+
+void TerrainChunkManager::GenerateNextChunk(const std::shared_ptr<StreamingQueue>& queue) {
+    std::shared_ptr<ChunkRequest> request;
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        auto& waiting = queue->waiting;
+        if (waiting.empty())
+            return;
+
+        auto nearest = std::min_element(waiting.begin(), waiting.end(),
+            [](const auto& a, const auto& b) { return a->priority < b->priority; });
+        request = *nearest;
+        *nearest = waiting.back();
+        waiting.pop_back();
+    }
+
+    if (request->cancelled)
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    request->chunk->GenerateCPUData();
+    queue->generationMicroseconds += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (!request->cancelled)
+        queue->completed.push_back(request);
+}
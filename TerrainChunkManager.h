@@ -1,69 +1,230 @@
-#pragma once
-
-#include <DirectXMath.h>
-#include <vector>
-#include <unordered_map>
-#include <string>
-#include <d3d12.h>
-#include <memory>
-#include <wrl.h>
-
-#include "TerrainChunk.h"
-
-using namespace DirectX;
-
-class TerrainChunkManager {
-public:
-    TerrainChunkManager() = default;
-    TerrainChunkManager(int chunkSize, float heightScale);
-    void UpdateChunks(const XMFLOAT3& cameraPosition, const std::vector<float>& heightmap, int heightmapWidth, std::unordered_map<std::string, Texture*>& textures);
-    const std::vector<std::shared_ptr<TerrainChunk>>& GetActiveChunks() const;
-
-private:
-    using ChunkKey = std::pair<int, int>;
-
-    struct pair_hash {
-        std::size_t operator()(const ChunkKey& k) const {
-            return std::hash<int>()(k.first) ^ std::hash<int>()(k.second);
-        }
-    };
-
-    // 2) Equality comparator: two keys equal if both coords match
-    struct ChunkKeyEqual {
-        bool operator()(const ChunkKey& a, const ChunkKey& b) const noexcept {
-            return a.first == b.first && a.second == b.second;
-        }
-    };
-
-    // 3) Hash functor: combine x and z into a size_t
-    struct ChunkKeyHash {
-        size_t operator()(const ChunkKey& key) const noexcept {
-            // Option A: combine into 64-bit then hash
-            // Shift x into high 32 bits, z in low 32 bits:
-            uint64_t ux = static_cast<uint32_t>(key.first);
-            uint64_t uz = static_cast<uint32_t>(key.second);
-            uint64_t combined = (ux << 32) ^ uz;
-            return std::hash<uint64_t>()(combined);
-
-            // Option B: manual combine with primes:
-            // size_t h1 = std::hash<int>()(key.x);
-            // size_t h2 = std::hash<int>()(key.z);
-            // return h1 ^ (h2 + 0x9e3779b97f4a7c15ULL + (h1<<6) + (h1>>2));
-        }
-    };
-
-    // assuming TerrainChunk is some class
-    std::unordered_map<ChunkKey, std::shared_ptr<TerrainChunk>,
-        ChunkKeyHash, ChunkKeyEqual> m_chunks;
-    //std::unordered_map<ChunkKey, std::shared_ptr<TerrainChunk>, pair_hash> m_chunks;
-    std::vector<std::shared_ptr<TerrainChunk>> m_activeChunks;
-    int m_chunkSize;
-    float m_heightScale;
-    int m_loadRadius = 3; // Radius in chunks
-
-    int   m_tessFactor = 4;   // e.g. 4
-    int   m_visibleSize = 0;  // = (m_chunkSize/m_tessFactor - 1) * m_tessFactor
-
-    FastNoiseLite m_Noise;
-};
-
+#pragma once
+
+#include <DirectXMath.h>
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <string>
+#include <d3d12.h>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <climits>
+#include <wrl.h>
+
+#include "TerrainChunk.h"
+#include "TerrainChunkPool.h"
+
+using namespace DirectX;
+
+class TerrainChunkCache;
+class TerrainHeightmapLru;
+
+// Heightmap generation speed against accuracy. Balanced and Fast evaluate the low octaves of the
+// terrain noise on a coarse grid (UberNoiseParams::coarseOctaves); Reference evaluates them all
+// per sample.
+enum class TerrainQuality { Reference, Balanced, Fast };
+
+class TerrainChunkManager {
+public:
+    TerrainChunkManager() = default;
+    TerrainChunkManager(int chunkSize, float heightScale);
+    // cameraVelocity is in world units per second; viewDirection need not be normalized. They
+    // steer the load order and the prefetch (see SetPredictionHorizon).
+    void UpdateChunks(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraVelocity, const XMFLOAT3& viewDirection,
+        const std::vector<float>& heightmap, int heightmapWidth, std::unordered_map<std::string, Texture*>& textures);
+    const std::vector<std::shared_ptr<TerrainChunk>>& GetActiveChunks() const;
+    // Heightmaps and normal maps of every chunk; each chunk's constants name its slice
+    const TerrainHeightmapArray& GetHeightmapArray() const { return m_pool->GetHeightmapArray(); }
+
+    // Time UpdateChunks may spend per frame uploading chunks that finished generating.
+    // At least one chunk is committed per frame regardless, so streaming always makes progress.
+    void SetCommitBudget(double milliseconds) { m_commitBudgetMs = milliseconds; }
+    size_t GetPendingChunkCount() const { return m_pendingCount; }
+
+    // Writes index memory, LOD, pool and heightmap LRU statistics to the debugger output each time
+    // streaming settles. Off by default.
+    void SetStatsLogging(bool enable) { m_logStats = enable; }
+
+    // How far ahead, in seconds at the current velocity, the chunks the window will need are
+    // generated in the background (entering chunks and LOD changes alike). They are committed the
+    // moment the camera gets there instead of being started then. 0 turns prefetching off.
+    void SetPredictionHorizon(float seconds) { m_predictionHorizon = std::max(seconds, 0.0f); }
+    float GetPredictionHorizon() const { return m_predictionHorizon; }
+
+    // Chunks load within the load radius and stay loaded until they are past the unload radius,
+    // so a camera going back and forth over a chunk border does not evict and regenerate the
+    // same chunks every time. Changing it rebuilds the window.
+    void SetUnloadRadius(int radius) { m_unloadRadius = std::max(radius, m_loadRadius); }
+    int GetUnloadRadius() const { return m_unloadRadius; }
+
+    // Heightmaps of evicted chunks are kept in memory up to this many bytes, so a chunk that comes
+    // back only needs its vertices, normals and upload (see TerrainHeightmapLru). Quantizing
+    // halves the bytes per heightmap: 16-bit steps over each chunk's height range, the same
+    // rounding as its R16_UNORM texture.
+    void SetHeightmapLruBudget(size_t bytes);
+    void SetHeightmapLruQuantized(bool quantize);
+
+    // Switches the generation quality and regenerates the loaded chunks. The error against
+    // Reference is measured on a probe chunk (GetNoiseError); a preset whose error exceeds its bound
+    // falls back to Reference, so GetQuality may differ from what was asked for. Each preset keeps
+    // its own cache file, so switching back and forth does not regenerate what was cached.
+    void SetQuality(TerrainQuality quality);
+    TerrainQuality GetQuality() const { return m_quality; }
+    const TerrainChunk::NoiseError& GetNoiseError() const { return m_noiseError; }
+
+private:
+    using ChunkKey = std::pair<int, int>;
+
+    // A chunk being generated on the worker pool. 'priority' is the squared chunk distance to
+    // the camera, weighted by direction (see GetPriority), and is refreshed whenever the camera
+    // changes chunk; it and 'key' are guarded by StreamingQueue::mutex.
+    // A LOD change replaces a loaded chunk of another tier and queues behind every missing chunk.
+    // A prefetched request belongs to no slot yet and queues behind both; 'parked' marks one that
+    // finished before the window reached it (both main thread only).
+    struct ChunkRequest {
+        ChunkKey key;
+        float priority = 0.0f;
+        bool lodChange = false;
+        bool prefetched = false;
+        bool parked = false;
+        std::shared_ptr<TerrainChunk> chunk;
+        std::atomic<bool> cancelled = false;
+    };
+
+    // Shared with the worker jobs, which can outlive a frame (or the manager).
+    struct StreamingQueue {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<ChunkRequest>> waiting;   // Not started yet
+        std::vector<std::shared_ptr<ChunkRequest>> completed; // Generated, waiting for the main thread
+        std::atomic<int64_t> generationMicroseconds = 0;      // Worker time spent generating, since the last report
+    };
+
+    // One cell of the chunk window: the chunk that belongs there, committed, being generated, or
+    // both while a LOD change is in flight (the committed chunk draws until the new one replaces it).
+    struct ChunkSlot {
+        ChunkKey key;
+        std::shared_ptr<TerrainChunk> chunk;
+        std::shared_ptr<ChunkRequest> request;
+    };
+
+    // Toroidal window of (2 * m_unloadRadius + 1)^2 slots around the camera chunk. Chunk (x, z)
+    // always lives in slot (x mod size, z mod size), so lookups are O(1) and crossing a chunk
+    // boundary only touches the row or column that entered the window (it reuses the slots of
+    // the one that left). Slots past the load radius only hold chunks left from earlier visits.
+    ChunkSlot& GetSlot(int chunkX, int chunkZ);
+    void ResetGrid(int cameraChunkX, int cameraChunkZ);
+    void ScrollGrid(int cameraChunkX, int cameraChunkZ);
+    void ReplaceSlot(ChunkSlot& slot, const ChunkKey& key, int cameraChunkX, int cameraChunkZ);
+    // ReplaceSlot, unless the slot already holds or is generating that chunk
+    void EnsureSlot(ChunkSlot& slot, const ChunkKey& key, int cameraChunkX, int cameraChunkZ);
+    void ReleaseSlot(ChunkSlot& slot);
+    void RetireChunk(TerrainChunk& chunk);
+    void CancelRequest(ChunkSlot& slot);
+    void RebuildActiveChunks();
+
+    // LOD tier of a chunk from its ring (Chebyshev distance to the camera chunk), and the sides
+    // on which it would border a coarser tier (see TerrainChunk::SetLod)
+    int GetLodTier(const ChunkKey& key, int cameraChunkX, int cameraChunkZ) const;
+    uint32_t GetLodSides(const ChunkKey& key, int cameraChunkX, int cameraChunkZ) const;
+    // Requests a regeneration for every slot whose chunk no longer has the LOD its ring asks for
+    void UpdateLods(int cameraChunkX, int cameraChunkZ);
+    // Tells every committed chunk which neighbours are of another tier
+    void UpdateSeams();
+
+    void RequestChunk(ChunkSlot& slot, const ChunkKey& key, int cameraChunkX, int cameraChunkZ, bool lodChange);
+    std::shared_ptr<ChunkRequest> CreateRequest(const ChunkKey& key, int tier, uint32_t lodSides, float priority);
+    float GetPriority(const ChunkKey& key, int cameraChunkX, int cameraChunkZ, bool lodChange) const;
+
+    // Prefetch: the camera chunks the predicted path crosses within the horizon, and for each the
+    // chunks its window would request. Replanned when the camera or the predicted chunk changes.
+    void UpdateCameraMotion(const XMFLOAT3& cameraPosition, const XMFLOAT3& cameraVelocity, const XMFLOAT3& viewDirection);
+    void UpdatePrefetch(int cameraChunkX, int cameraChunkZ);
+    // Hands a prefetched request for key to its slot if it was built with this LOD, else drops it
+    std::shared_ptr<ChunkRequest> TakePrefetched(const ChunkKey& key, int tier, uint32_t lodSides);
+    void CancelPrefetch();
+    void UpdatePendingChunks(int cameraChunkX, int cameraChunkZ);
+    void CommitCompletedChunks(std::unordered_map<std::string, Texture*>& textures);
+    void CommitChunk(ChunkSlot& slot, std::unordered_map<std::string, Texture*>& textures);
+    static void GenerateNextChunk(const std::shared_ptr<StreamingQueue>& queue);
+    void ReportIndexMemory() const;
+    void ReportLodStats() const;
+    void ReportPoolStats() const;
+    void ReportHeightmapLru() const;
+
+    std::vector<ChunkSlot> m_grid;
+    int m_gridSize = 0;
+    int m_gridCenterX = 0;
+    int m_gridCenterZ = 0;
+    size_t m_loadedChunkCount = 0;
+    size_t m_pendingCount = 0;
+    bool m_activeChunksDirty = false;
+    bool m_logStats = false;
+
+    std::vector<std::shared_ptr<TerrainChunk>> m_activeChunks;
+    int m_chunkSize;
+    float m_heightScale;
+    int m_loadRadius = 3; // Radius in chunks
+    int m_unloadRadius = 4;
+
+    // Streaming: requests live in their grid slot until committed (main thread only)
+    std::shared_ptr<StreamingQueue> m_streamingQueue = std::make_shared<StreamingQueue>();
+    double m_commitBudgetMs = 2.0;
+
+    // Camera motion on the xz plane. The heading is the direction of travel, or the view
+    // direction when standing still.
+    XMFLOAT2 m_cameraPosition = XMFLOAT2(0.0f, 0.0f);
+    XMFLOAT2 m_cameraVelocity = XMFLOAT2(0.0f, 0.0f);
+    XMFLOAT2 m_heading = XMFLOAT2(0.0f, 0.0f);
+    float m_predictionHorizon = 4.0f; // Seconds
+    std::vector<std::shared_ptr<ChunkRequest>> m_prefetched; // Not adopted by a slot yet
+    ChunkKey m_prefetchFrom = { INT_MIN, INT_MIN }; // Camera chunk and predicted chunk of the last plan
+    ChunkKey m_prefetchTo = { INT_MIN, INT_MIN };
+
+    // A chunk the predicted path needs that the current window does not hold at that LOD
+    struct Prefetch {
+        ChunkKey key;
+        int tier;
+        uint32_t lodSides;
+        float priority;
+    };
+    // Scratch of UpdatePrefetch and CommitCompletedChunks, cleared rather than reallocated each frame
+    std::vector<ChunkKey> m_prefetchPath;
+    std::vector<Prefetch> m_prefetchPlan;
+    std::vector<Prefetch> m_prefetchStepPlan;
+    std::vector<std::shared_ptr<ChunkRequest>> m_prefetchKept;
+    std::vector<std::shared_ptr<ChunkRequest>> m_readyRequests;
+    std::vector<std::shared_ptr<ChunkRequest>> m_deferredRequests;
+    std::vector<int> m_swapTiers;
+
+    // Priority weight of a chunk straight behind the heading (0 ahead and to the sides)
+    static constexpr float BehindWeight = 2.0f;
+    // Upper bound on prefetched chunks, nearest step of the path first
+    static constexpr size_t MaxPrefetchedChunks = 16;
+
+    // Persistent heightmap cache shared by every chunk this manager creates: the current quality's.
+    // Each quality has a file of its own (CacheFileName), so switching does not throw away what the
+    // others cached; they are opened on first use.
+    std::shared_ptr<TerrainChunkCache> m_cache;
+    std::array<std::shared_ptr<TerrainChunkCache>, 3> m_qualityCaches;
+    static std::wstring CacheFileName(TerrainQuality quality);
+
+    // Heightmaps of evicted chunks, shared with the chunks this manager creates
+    std::shared_ptr<TerrainHeightmapLru> m_heightmapLru;
+    static constexpr size_t DefaultHeightmapLruBytes = 32 * 1024 * 1024;
+
+    // GPU resources of chunks that left the window, reused by the chunks that enter it
+    std::shared_ptr<TerrainChunkPool> m_pool = std::make_shared<TerrainChunkPool>();
+
+    // Noise parameters given to every new chunk
+    UberNoiseParams m_noiseParams;
+    TerrainQuality m_quality = TerrainQuality::Reference;
+    TerrainChunk::NoiseError m_noiseError;
+    bool m_regenerateChunks = false;
+
+    int   m_tessFactor = 4;   // e.g. 4
+    int   m_visibleSize = 0;  // = (m_chunkSize/m_tessFactor - 1) * m_tessFactor
+};
+
@@ -0,0 +1,131 @@
+#include "TerrainChunkPool.h"
+
+#include <cassert>
+#include <cstring>
+#include "DX12Renderer/Application.h"
+#include "DX12Renderer/CommandQueue.h"
+#include "DX12Renderer/Helpers.h"
+#include "DX12Renderer/d3dx12.h"
+
+TerrainChunkPool::TerrainChunkPool()
+    : m_free(std::make_shared<FreeLists>()) {
+}
+
+std::shared_ptr<TerrainChunkResources> TerrainChunkPool::Acquire(int vertsPerSide, const std::vector<VertexPosition>& vertices,
+    const std::vector<uint8_t>& heightmap, const std::vector<uint8_t>& normalMap) {
+    std::shared_ptr<TerrainChunkResources> resources;
+    {
+        std::lock_guard<std::mutex> lock(m_free->mutex);
+        auto it = m_free->sets.find(vertsPerSide);
+        if (it != m_free->sets.end() && !it->second.empty()) {
+            resources = std::move(it->second.back());
+            it->second.pop_back();
+        }
+    }
+
+    // Slices are not tied to a tier, so they come and go with the chunks rather than the sets
+    const uint32_t slice = m_heightmaps.Allocate();
+
+    if (!resources) {
+        resources = Create(vertsPerSide, slice, vertices, heightmap, normalMap);
+        ++m_created;
+        m_bytes += GetMemory(*resources);
+        return resources;
+    }
+
+    // The fence that freed the set has passed, so nothing on the GPU still reads the vertex
+    // buffer or the upload buffer, and the texture copies queue behind every earlier draw.
+    WriteVertices(*resources->vertexBuffer, vertices);
+    resources->slice = slice;
+    m_heightmaps.Upload(resources->slice, vertsPerSide, heightmap, normalMap, resources->uploadBuffer.Get(), 0);
+    ++m_recycled;
+    return resources;
+}
+
+void TerrainChunkPool::Release(std::shared_ptr<TerrainChunkResources> resources) {
+    if (!resources)
+        return;
+
+    m_heightmaps.Free(resources->slice);
+
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    std::shared_ptr<FreeLists> freeLists = m_free;
+    commands->ReleaseDeferred([freeLists, resources]() {
+        std::lock_guard<std::mutex> lock(freeLists->mutex);
+        freeLists->sets[resources->vertsPerSide].push_back(resources);
+    });
+}
+
+std::shared_ptr<TerrainChunkResources> TerrainChunkPool::Create(int vertsPerSide, uint32_t slice, const std::vector<VertexPosition>& vertices,
+    const std::vector<uint8_t>& heightmap, const std::vector<uint8_t>& normalMap) {
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+
+    auto resources = std::make_shared<TerrainChunkResources>();
+    resources->vertsPerSide = vertsPerSide;
+    resources->slice = slice;
+
+    // Every chunk of a tier has the same number of vertices, so the buffer never needs to grow
+    assert(vertices.size() == size_t(vertsPerSide) * vertsPerSide);
+    const UINT bufferSize = UINT(vertices.size() * sizeof(VertexPosition));
+
+    resources->vertexBuffer = std::make_shared<BufferData>();
+    D3D12_HEAP_PROPERTIES uploadProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize, D3D12_RESOURCE_FLAG_NONE);
+
+    ThrowIfFailed(device->CreateCommittedResource(
+        &uploadProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &bufferDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&resources->vertexBuffer->m_bufferResource)));
+
+    BufferData& vertexBuffer = *resources->vertexBuffer;
+    vertexBuffer.m_vertexView.BufferLocation = vertexBuffer.m_bufferResource->GetGPUVirtualAddress();
+    vertexBuffer.m_vertexView.StrideInBytes = sizeof(VertexPosition);
+    vertexBuffer.m_vertexView.SizeInBytes = bufferSize;
+    WriteVertices(vertexBuffer, vertices);
+
+    // Staging for this upload and every rewrite after it: both footprints back to back
+    D3D12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(TerrainHeightmapArray::GetUploadSize(vertsPerSide), D3D12_RESOURCE_FLAG_NONE);
+    ThrowIfFailed(device->CreateCommittedResource(
+        &uploadProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &uploadDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&resources->uploadBuffer)));
+
+    vertexBuffer.m_bufferResource->SetName(L"Terrain Chunk Vertex Buffer");
+    resources->uploadBuffer->SetName(L"Terrain Chunk Upload Buffer");
+
+    m_heightmaps.Upload(resources->slice, vertsPerSide, heightmap, normalMap, resources->uploadBuffer.Get(), 0);
+    return resources;
+}
+
+TerrainChunkPool::Stats TerrainChunkPool::GetStats() const {
+    Stats stats;
+    stats.created = m_created;
+    stats.recycled = m_recycled;
+    stats.bytes = m_bytes + m_heightmaps.GetMemory();
+
+    std::lock_guard<std::mutex> lock(m_free->mutex);
+    for (const auto& [vertsPerSide, sets] : m_free->sets)
+        stats.free += sets.size();
+    return stats;
+}
+
+void TerrainChunkPool::WriteVertices(BufferData& vertexBuffer, const std::vector<VertexPosition>& vertices) {
+    const size_t bytes = vertices.size() * sizeof(VertexPosition);
+    assert(bytes == vertexBuffer.m_vertexView.SizeInBytes);
+
+    UINT8* vertexData = nullptr;
+    D3D12_RANGE range{ 0, 0 };
+    ThrowIfFailed(vertexBuffer.m_bufferResource->Map(0, &range, reinterpret_cast<void**>(&vertexData)));
+    memcpy(vertexData, vertices.data(), bytes);
+    vertexBuffer.m_bufferResource->Unmap(0, nullptr);
+}
+
+size_t TerrainChunkPool::GetMemory(const TerrainChunkResources& resources) {
+    return size_t(resources.vertexBuffer->m_vertexView.SizeInBytes) + size_t(resources.uploadBuffer->GetDesc().Width);
+}
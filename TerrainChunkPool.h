@@ -0,0 +1,74 @@
+#pragma once
+
+#include "DX12Renderer/Mesh.h"
+#include "TerrainHeightmapArray.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+
+// GPU resources of one terrain chunk, sized for one LOD tier: the vertex buffer, the upload buffer
+// the chunk's heightmap and normal map go through, and the slice of the pool's arrays they go to.
+struct TerrainChunkResources {
+    int vertsPerSide = 0;
+    std::shared_ptr<BufferData> vertexBuffer; // Upload heap, written through Map
+    uint32_t slice = 0;                       // In the pool's TerrainHeightmapArray, while acquired
+    Microsoft::WRL::ComPtr<ID3D12Resource> uploadBuffer; // TerrainHeightmapArray::GetUploadSize
+};
+
+// Recycles chunk GPU resources. A chunk that leaves the window hands its set back instead of
+// releasing it, and the next chunk of the same tier rewrites the contents in place, so once the
+// pool has grown to the window's size streaming creates no resources and allocates no
+// descriptors. Every set's heightmap and normal map are a slice of the pool's
+// TerrainHeightmapArray. Main thread only, apart from the fence callbacks that return released
+// sets.
+class TerrainChunkPool {
+public:
+    TerrainChunkPool();
+
+    TerrainChunkPool(const TerrainChunkPool&) = delete;
+    TerrainChunkPool& operator=(const TerrainChunkPool&) = delete;
+
+    // A set holding the given contents: a free one of the same size rewritten in place, or a new
+    // one when none is free.
+    std::shared_ptr<TerrainChunkResources> Acquire(int vertsPerSide, const std::vector<VertexPosition>& vertices,
+        const std::vector<uint8_t>& heightmap, const std::vector<uint8_t>& normalMap);
+
+    // Frames in flight may still draw with the set and its slice, so they only become free once
+    // the direct queue has passed the next fence.
+    void Release(std::shared_ptr<TerrainChunkResources> resources);
+
+    // Heightmaps and normal maps of every set, for binding and the barriers around the passes
+    const TerrainHeightmapArray& GetHeightmapArray() const { return m_heightmaps; }
+
+    struct Stats {
+        size_t created = 0;  // Sets created over the pool's lifetime
+        size_t recycled = 0; // Acquires served from a free set
+        size_t free = 0;     // Sets waiting for a chunk
+        size_t bytes = 0;    // GPU memory of every set created and the texture arrays
+    };
+    Stats GetStats() const;
+
+private:
+    // Shared with the fence callbacks, which can run after the pool is gone
+    struct FreeLists {
+        std::mutex mutex;
+        std::unordered_map<int, std::vector<std::shared_ptr<TerrainChunkResources>>> sets; // By vertsPerSide
+    };
+
+    std::shared_ptr<TerrainChunkResources> Create(int vertsPerSide, uint32_t slice, const std::vector<VertexPosition>& vertices,
+        const std::vector<uint8_t>& heightmap, const std::vector<uint8_t>& normalMap);
+
+    static void WriteVertices(BufferData& vertexBuffer, const std::vector<VertexPosition>& vertices);
+    static size_t GetMemory(const TerrainChunkResources& resources);
+
+    std::shared_ptr<FreeLists> m_free;
+    TerrainHeightmapArray m_heightmaps;
+    size_t m_created = 0;
+    size_t m_recycled = 0;
+    size_t m_bytes = 0;
+};
@@ -0,0 +1,214 @@
+#include "TerrainClipmap.h"
+#include "DX12Renderer/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+
+namespace {
+    // Floor division for the snapping of negative coordinates
+    int FloorDiv(int value, int divisor) {
+        int quotient = value / divisor;
+        if ((value % divisor != 0) && ((value < 0) != (divisor < 0)))
+            --quotient;
+        return quotient;
+    }
+}
+
+TerrainClipmap::TerrainClipmap(int levelCount, int textureSize, float baseSpacing)
+    : m_noiseScale(1.0f), m_textureSize(textureSize) {
+    // Power of two for the toroidal wrap; the grid (textureSize - 4) a multiple of four so a level
+    // snapped to twice its spacing lands on the coarser level's vertices with a whole-quad hole
+    assert(textureSize >= 8 && (textureSize & (textureSize - 1)) == 0);
+    assert(levelCount > 0);
+
+    m_levels.resize(levelCount);
+    for (int l = 0; l < levelCount; ++l) {
+        m_levels[l].spacing = baseSpacing * float(1 << l);
+        m_levels[l].heights.resize(size_t(textureSize) * textureSize);
+    }
+    SetNoise(m_perlin, m_noiseParams, m_noiseScale);
+}
+
+void TerrainClipmap::SetNoise(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params, float noiseScale) {
+    m_perlin = perlin;
+    m_noiseParams = params;
+    m_noiseScale = noiseScale;
+
+    // Each level halves the sample rate, and each octave multiplies the frequency by the
+    // lacunarity, so a level drops log(2) / log(lacunarity) octaves per doubling
+    const float octavesPerLevel = std::log(2.0f) / std::log(std::max(params.lacunarity, 1.01f));
+    for (int l = 0; l < GetLevelCount(); ++l) {
+        Level& level = m_levels[l];
+        level.octaves = std::max(1, params.octaves - int(std::ceil(float(l) * octavesPerLevel - 1e-4f)));
+        level.valid = false;
+    }
+}
+
+size_t TerrainClipmap::Update(float cameraX, float cameraZ) {
+    const int gridSize = GetGridSize();
+    size_t generated = 0;
+
+    for (Level& level : m_levels) {
+        // Snapped to twice the spacing, so the level's vertices are every other vertex of the
+        // next coarser level
+        const int cameraGridX = int(std::floor(cameraX / level.spacing));
+        const int cameraGridZ = int(std::floor(cameraZ / level.spacing));
+        const int gridX = 2 * FloorDiv(cameraGridX, 2) - gridSize / 2;
+        const int gridZ = 2 * FloorDiv(cameraGridZ, 2) - gridSize / 2;
+
+        // Stored samples start one before the first vertex
+        const int oldX = level.gridX - 1;
+        const int oldZ = level.gridZ - 1;
+        const int newX = gridX - 1;
+        const int newZ = gridZ - 1;
+        const int dx = newX - oldX;
+        const int dz = newZ - oldZ;
+
+        if (!level.valid || std::abs(dx) >= m_textureSize || std::abs(dz) >= m_textureSize) {
+            level.gridX = gridX;
+            level.gridZ = gridZ;
+            GenerateRect(level, newX, newZ, m_textureSize, m_textureSize);
+            generated += size_t(m_textureSize) * m_textureSize;
+            level.valid = true;
+            level.dirty = true;
+            continue;
+        }
+        if (dx == 0 && dz == 0)
+            continue;
+
+        level.gridX = gridX;
+        level.gridZ = gridZ;
+
+        // Rows that scrolled in, across the new width; then the columns that scrolled in, over
+        // the rows that were already there. The slots they land in held the samples that
+        // scrolled out.
+        const int rowsZ = dz > 0 ? oldZ + m_textureSize : newZ;
+        const int rowCount = std::abs(dz);
+        if (rowCount > 0) {
+            GenerateRect(level, newX, rowsZ, m_textureSize, rowCount);
+            generated += size_t(m_textureSize) * rowCount;
+        }
+
+        const int colCount = std::abs(dx);
+        if (colCount > 0) {
+            const int colsX = dx > 0 ? oldX + m_textureSize : newX;
+            const int keptZ = dz > 0 ? newZ : newZ + rowCount;
+            const int keptRows = m_textureSize - rowCount;
+            GenerateRect(level, colsX, keptZ, colCount, keptRows);
+            generated += size_t(colCount) * keptRows;
+        }
+        level.dirty = true;
+    }
+    return generated;
+}
+
+float TerrainClipmap::GetHeight(int level, int gridX, int gridZ) const {
+    const Level& l = m_levels[level];
+    assert(l.valid);
+    assert(gridX >= l.gridX - 1 && gridX < l.gridX - 1 + m_textureSize);
+    assert(gridZ >= l.gridZ - 1 && gridZ < l.gridZ - 1 + m_textureSize);
+
+    const unsigned mask = unsigned(m_textureSize - 1);
+    return l.heights[size_t(unsigned(gridZ) & mask) * m_textureSize + (unsigned(gridX) & mask)];
+}
+
+float TerrainClipmap::GetViewDistance() const {
+    return 0.5f * float(GetGridSize()) * m_levels.back().spacing;
+}
+
+void TerrainClipmap::GetHoleOffset(int level, int& offsetX, int& offsetZ) const {
+    assert(level > 0);
+    const Level& finer = m_levels[level - 1];
+    const Level& ring = m_levels[level];
+    offsetX = finer.gridX / 2 - ring.gridX;
+    offsetZ = finer.gridZ / 2 - ring.gridZ;
+}
+
+int TerrainClipmap::GetIndexRange(int level) const {
+    if (level == 0)
+        return 0;
+
+    const Level& finer = m_levels[level - 1];
+    const Level& ring = m_levels[level];
+    return GetRingIndexRange(GetGridSize(), ring.gridX, ring.gridZ, finer.gridX, finer.gridZ);
+}
+
+int TerrainClipmap::GetRingIndexRange(int gridSize, int gridX, int gridZ, int finerGridX, int finerGridZ) {
+    const int dx = finerGridX / 2 - gridX - gridSize / 4;
+    const int dz = finerGridZ / 2 - gridZ - gridSize / 4;
+    assert(dx >= 0 && dx <= 1 && dz >= 0 && dz <= 1);
+    return 1 + dx + 2 * dz;
+}
+
+std::array<TerrainClipmap::IndexSpan, 5> TerrainClipmap::BuildGridIndices(int gridSize, std::vector<uint32_t>& indices) {
+    assert(gridSize % 4 == 0);
+    const int vertsPerSide = gridSize + 1;
+    const int holeSize = gridSize / 2;
+
+    indices.clear();
+    indices.reserve(size_t(gridSize) * gridSize * 6 + 4 * (size_t(gridSize) * gridSize - size_t(holeSize) * holeSize) * 6);
+
+    // Counter-clockwise seen from above (+x right, +z up), the front face of the terrain PSOs
+    auto addQuad = [&](int x, int z) {
+        const uint32_t i0 = uint32_t(z * vertsPerSide + x);
+        const uint32_t i1 = i0 + 1;
+        const uint32_t i2 = i0 + vertsPerSide;
+        const uint32_t i3 = i2 + 1;
+        indices.insert(indices.end(), { i0, i1, i2, i1, i3, i2 });
+    };
+
+    std::array<IndexSpan, 5> spans{};
+    for (int variant = 0; variant < 5; ++variant) {
+        const int holeX = variant == 0 ? 0 : gridSize / 4 + ((variant - 1) & 1);
+        const int holeZ = variant == 0 ? 0 : gridSize / 4 + ((variant - 1) >> 1);
+
+        spans[variant].startIndex = uint32_t(indices.size());
+        for (int z = 0; z < gridSize; ++z) {
+            for (int x = 0; x < gridSize; ++x) {
+                const bool inHole = variant != 0
+                    && x >= holeX && x < holeX + holeSize
+                    && z >= holeZ && z < holeZ + holeSize;
+                if (!inHole)
+                    addQuad(x, z);
+            }
+        }
+        spans[variant].indexCount = uint32_t(indices.size()) - spans[variant].startIndex;
+    }
+    return spans;
+}
+
+void TerrainClipmap::GenerateRect(Level& level, int gridX, int gridZ, int width, int height) {
+    const unsigned mask = unsigned(m_textureSize - 1);
+    const int octaves = level.octaves;
+    const float spacing = level.spacing;
+    const float noiseScale = m_noiseScale;
+    const TerrainNoise::PerlinSettings perlin = m_perlin;
+
+    std::vector<float> rowX(width);
+    for (int x = 0; x < width; ++x)
+        rowX[x] = float(gridX + x) * spacing * noiseScale;
+
+    // Small strips stay on this thread; a whole level goes to the pool, row by row. A sample
+    // never depends on its neighbours, so the split does not change the result.
+    auto generateRows = [&](int zBegin, int zEnd) {
+        std::vector<float> rowZ(width), row(width);
+        for (int z = zBegin; z < zEnd; ++z) {
+            std::fill(rowZ.begin(), rowZ.end(), float(gridZ + z) * spacing * noiseScale);
+            TerrainNoise::UberNoiseLowOctaves(perlin, m_noiseParams, octaves, rowX.data(), rowZ.data(), row.data(), width);
+
+            // Wrapping row, at most two runs
+            float* dst = &level.heights[size_t(unsigned(gridZ + z) & mask) * m_textureSize];
+            const int first = int(unsigned(gridX) & mask);
+            const int run = std::min(width, m_textureSize - first);
+            std::copy(row.begin(), row.begin() + run, dst + first);
+            std::copy(row.begin() + run, row.end(), dst);
+        }
+    };
+
+    if (size_t(width) * height >= size_t(m_textureSize) * 16)
+        ThreadPool::Get().ParallelFor(height, 8, generateRows);
+    else
+        generateRows(0, height);
+}
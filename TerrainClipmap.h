@@ -0,0 +1,92 @@
+#pragma once
+
+#include "TerrainNoise.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Geometry clipmap of the terrain: nested square grids with the same number of vertices centred
+// on the camera, each with twice the vertex spacing of the one inside it. Level l draws a ring
+// around level l - 1, so the view distance doubles per level at a constant vertex count.
+//
+// Each level keeps its heights in a toroidal buffer of textureSize^2 samples: sample (gx, gz) of
+// the level's grid lives at (gx mod textureSize, gz mod textureSize). When the camera moves, only
+// the rows and columns that scrolled in are generated; every other sample stays where it is, and
+// so does its texel on the GPU. Heights are raw UberNoise, the same function (and at level 0 the
+// same sample positions) as the chunk heightmaps; coarser levels drop the octaves their spacing
+// cannot resolve, like the coarser chunk LOD tiers.
+//
+// CPU only: no GPU state, so the ring update and the generation can be checked without a device.
+// TerrainClipmapRenderer uploads and draws it.
+class TerrainClipmap {
+public:
+    // textureSize is a power of two; each level draws GetGridSize() = textureSize - 4 quads per
+    // side, with one spare sample on every side for the normals. baseSpacing is level 0's world
+    // units per quad.
+    TerrainClipmap(int levelCount, int textureSize, float baseSpacing);
+
+    // Noise of the heights (noiseScale multiplies world coordinates, like HeightNoiseScale).
+    // Invalidates every level.
+    void SetNoise(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params, float noiseScale);
+
+    // Recentres every level on the camera and generates the samples that scrolled in (all of them
+    // on the first call or after a jump of more than a level). Returns the number generated.
+    size_t Update(float cameraX, float cameraZ);
+
+    struct Level {
+        float spacing = 0.0f;  // World units per quad
+        int octaves = 0;       // UberNoise octaves evaluated
+        int gridX = 0;         // Grid coordinates (world / spacing) of the level's first vertex
+        int gridZ = 0;
+        std::vector<float> heights; // textureSize^2, toroidal
+        bool valid = false;    // Holds samples for the current origin
+        bool dirty = false;    // Changed since the last ClearDirty
+    };
+
+    int GetLevelCount() const { return int(m_levels.size()); }
+    int GetTextureSize() const { return m_textureSize; }
+    int GetGridSize() const { return m_textureSize - 4; }
+    const Level& GetLevel(int level) const { return m_levels[level]; }
+    void ClearDirty(int level) { m_levels[level].dirty = false; }
+
+    // Height at grid coordinates of a level; they have to lie in the level's stored samples
+    // (one sample beyond the grid on every side).
+    float GetHeight(int level, int gridX, int gridZ) const;
+
+    // Half the side of the area the outermost level covers, in world units
+    float GetViewDistance() const;
+
+    // Where level - 1 sits inside a ring level, in quads of the ring: GetGridSize() / 4 plus 0 or
+    // 1 on each axis, depending on how the two origins snapped. Selects the ring's index range.
+    void GetHoleOffset(int level, int& offsetX, int& offsetZ) const;
+
+    // Index range into BuildGridIndices' buffer that draws a level: the whole grid for level 0,
+    // the ring around level - 1 for the others.
+    int GetIndexRange(int level) const;
+    // Same for a ring at (gridX, gridZ) around a finer level at (finerGridX, finerGridZ), for
+    // origins kept elsewhere
+    static int GetRingIndexRange(int gridSize, int gridX, int gridZ, int finerGridX, int finerGridZ);
+
+    struct IndexSpan {
+        uint32_t startIndex;
+        uint32_t indexCount;
+    };
+
+    // Triangle list over the (gridSize + 1)^2 vertices every level shares (row major, x fastest).
+    // Span 0 is the full grid; span 1 + dx + 2 * dz the grid minus the gridSize / 2 quads wide
+    // hole at gridSize / 4 + (dx, dz).
+    static std::array<IndexSpan, 5> BuildGridIndices(int gridSize, std::vector<uint32_t>& indices);
+
+private:
+    // Generates the samples of [gridX, gridX + width) x [gridZ, gridZ + height) of a level into
+    // their toroidal slots
+    void GenerateRect(Level& level, int gridX, int gridZ, int width, int height);
+
+    TerrainNoise::PerlinSettings m_perlin;
+    UberNoiseParams m_noiseParams;
+    float m_noiseScale;
+    int m_textureSize;
+    std::vector<Level> m_levels;
+};
@@ -0,0 +1,190 @@
+#include "TerrainClipmapRenderer.h"
+
+#include <cassert>
+#include "DX12Renderer/Application.h"
+#include "DX12Renderer/CommandQueue.h"
+#include "DX12Renderer/Helpers.h"
+#include "DX12Renderer/d3dx12.h"
+
+TerrainClipmapRenderer::TerrainClipmapRenderer(int levelCount, int textureSize, float baseSpacing)
+    : m_clipmap(levelCount, textureSize, baseSpacing) {
+    // Same noise as the chunks, so level 0 matches the finest chunk tier sample for sample
+    TerrainNoise::PerlinSettings perlin;
+    perlin.frequency = TerrainChunk::HeightNoiseScale;
+    m_clipmap.SetNoise(perlin, UberNoiseParams(), TerrainChunk::HeightNoiseScale);
+
+    // One grid of vertex indices for every level; the vertex shader places and displaces it
+    const int gridSize = m_clipmap.GetGridSize();
+    const int vertsPerSide = gridSize + 1;
+    std::vector<VertexPosition> vertices;
+    vertices.reserve(size_t(vertsPerSide) * vertsPerSide);
+    for (int z = 0; z < vertsPerSide; ++z) {
+        for (int x = 0; x < vertsPerSide; ++x)
+            vertices.emplace_back(XMFLOAT3(float(x), 0.0f, float(z)));
+    }
+
+    std::vector<uint32_t> indices;
+    const std::array<TerrainClipmap::IndexSpan, 5> spans = TerrainClipmap::BuildGridIndices(gridSize, indices);
+    for (size_t i = 0; i < spans.size(); ++i)
+        m_ranges[i] = IndexRange{ spans[i].startIndex, spans[i].indexCount };
+
+    m_grid.AddVertexData(std::move(vertices));
+    m_grid.AddIndexData(indices);
+    m_grid.CreateBuffers();
+    m_grid.ReleaseCPUData();
+
+    m_levels.resize(levelCount);
+}
+
+void TerrainClipmapRenderer::Update(const XMFLOAT3& cameraPosition) {
+    m_stats.samplesGenerated += m_clipmap.Update(cameraPosition.x, cameraPosition.z);
+
+    if (!IsReady()) {
+        for (int l = 0; l < GetLevelCount(); ++l)
+            CreateLevel(l);
+        return;
+    }
+
+    // All changed levels upload together or not at all (see the class comment)
+    std::vector<LevelUpload*> uploads(GetLevelCount(), nullptr);
+    size_t changed = 0;
+    bool blocked = false;
+    for (int l = 0; l < GetLevelCount(); ++l) {
+        if (!m_clipmap.GetLevel(l).dirty)
+            continue;
+        ++changed;
+        uploads[l] = FindUpload(l);
+        blocked |= uploads[l] == nullptr;
+    }
+
+    if (blocked) {
+        m_stats.levelsDeferred += changed;
+        return;
+    }
+
+    for (int l = 0; l < GetLevelCount(); ++l) {
+        if (!uploads[l])
+            continue;
+
+        // The texture is in PIXEL_SHADER_RESOURCE between frames, as Texture::Update expects
+        LevelResources& resources = m_levels[l];
+        const std::vector<float>& heights = m_clipmap.GetLevel(l).heights;
+        uploads[l]->fence = resources.heightmap->Update(heights.data(), heights.size() * sizeof(float), uploads[l]->buffer.Get(), 0);
+        resources.gridX = m_clipmap.GetLevel(l).gridX;
+        resources.gridZ = m_clipmap.GetLevel(l).gridZ;
+        m_clipmap.ClearDirty(l);
+        ++m_stats.levelsUploaded;
+    }
+}
+
+void TerrainClipmapRenderer::Shutdown() {
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+
+    for (LevelResources& resources : m_levels) {
+        if (resources.heightmap) {
+            resources.heightmap->Shutdown();
+            resources.heightmap.reset();
+        }
+        for (LevelUpload& upload : resources.uploads)
+            commands->ReleaseDeferred(std::move(upload.buffer));
+        resources.uploads.clear();
+    }
+    m_grid.Shutdown();
+}
+
+TerrainClipmapConstants TerrainClipmapRenderer::GetShaderConstants(int level) const {
+    const TerrainClipmap::Level& clipmapLevel = m_clipmap.GetLevel(level);
+    const LevelResources& resources = m_levels[level];
+
+    TerrainClipmapConstants constants;
+    constants.gridX = resources.gridX;
+    constants.gridZ = resources.gridZ;
+    constants.spacing = clipmapLevel.spacing;
+    constants.heightScale = TerrainChunk::DisplacementScale - 1.0f;
+    constants.gridSize = uint32_t(m_clipmap.GetGridSize());
+    constants.textureMask = uint32_t(m_clipmap.GetTextureSize() - 1);
+    constants.morph = level + 1 < GetLevelCount() ? 1.0f : 0.0f;
+    constants.uvScale = TextureTiling;
+    return constants;
+}
+
+const Texture& TerrainClipmapRenderer::GetCoarserHeightmap(int level) const {
+    return GetHeightmap(level + 1 < GetLevelCount() ? level + 1 : level);
+}
+
+ID3D12Resource* TerrainClipmapRenderer::GetHeightmapResource(int level) const {
+    return static_cast<ID3D12Resource*>(m_levels[level].heightmap->GetTexture());
+}
+
+IndexRange TerrainClipmapRenderer::GetIndexRange(int level) const {
+    if (level == 0)
+        return m_ranges[0];
+
+    // From the origins on the GPU, which may trail the clipmap's by a frame
+    const LevelResources& finer = m_levels[level - 1];
+    const LevelResources& ring = m_levels[level];
+    return m_ranges[TerrainClipmap::GetRingIndexRange(m_clipmap.GetGridSize(), ring.gridX, ring.gridZ, finer.gridX, finer.gridZ)];
+}
+
+TerrainBounds TerrainClipmapRenderer::GetBounds(int level) const {
+    const float spacing = m_clipmap.GetLevel(level).spacing;
+    const float extent = float(m_clipmap.GetGridSize()) * spacing;
+    const LevelResources& resources = m_levels[level];
+
+    TerrainBounds bounds;
+    bounds.min = XMFLOAT3(float(resources.gridX) * spacing, 0.0f, float(resources.gridZ) * spacing);
+    bounds.max = XMFLOAT3(bounds.min.x + extent, TerrainChunk::DisplacementScale - 1.0f, bounds.min.z + extent);
+    return bounds;
+}
+
+TerrainClipmapRenderer::Stats TerrainClipmapRenderer::TakeStats() {
+    Stats stats = m_stats;
+    m_stats = Stats();
+    return stats;
+}
+
+void TerrainClipmapRenderer::CreateLevel(int level) {
+    const int textureSize = m_clipmap.GetTextureSize();
+    const XMFLOAT2 imageSize((float)textureSize, (float)textureSize);
+
+    // Texture takes bytes; this copy is made once per level, the updates upload from the heights
+    const std::vector<float>& heights = m_clipmap.GetLevel(level).heights;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(heights.data());
+    const std::vector<uint8_t> texels(bytes, bytes + heights.size() * sizeof(float));
+
+    LevelResources& resources = m_levels[level];
+    resources.heightmap = std::make_unique<Texture>(texels, imageSize, DXGI_FORMAT_R32_FLOAT);
+    resources.gridX = m_clipmap.GetLevel(level).gridX;
+    resources.gridZ = m_clipmap.GetLevel(level).gridZ;
+    m_clipmap.ClearDirty(level);
+}
+
+TerrainClipmapRenderer::LevelUpload* TerrainClipmapRenderer::FindUpload(int level) {
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    LevelResources& resources = m_levels[level];
+
+    for (LevelUpload& upload : resources.uploads) {
+        if (commands->IsFenceComplete(upload.fence))
+            return &upload;
+    }
+    if (resources.uploads.size() >= MaxUploadBuffers)
+        return nullptr;
+
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+    ID3D12Resource* texture = static_cast<ID3D12Resource*>(resources.heightmap->GetTexture());
+    D3D12_HEAP_PROPERTIES uploadProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    D3D12_RESOURCE_DESC uploadDesc = CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(texture, 0, 1), D3D12_RESOURCE_FLAG_NONE);
+
+    LevelUpload upload;
+    ThrowIfFailed(device->CreateCommittedResource(
+        &uploadProperties,
+        D3D12_HEAP_FLAG_NONE,
+        &uploadDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ,
+        nullptr,
+        IID_PPV_ARGS(&upload.buffer)));
+    upload.buffer->SetName(L"Terrain Clipmap Upload Buffer");
+
+    resources.uploads.push_back(std::move(upload));
+    return &resources.uploads.back();
+}
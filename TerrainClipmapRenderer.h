@@ -0,0 +1,109 @@
+#pragma once
+
+#include "TerrainChunk.h"
+#include "TerrainClipmap.h"
+#include "DX12Renderer/Mesh.h"
+#include "DX12Renderer/Texture.h"
+
+#include <DirectXMath.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+
+using namespace DirectX;
+
+// Root constants of one clipmap level, read by VSTerrainClipmap (b1)
+struct TerrainClipmapConstants {
+    int32_t gridX;        // Grid coordinates of the level's first vertex
+    int32_t gridZ;
+    float spacing;        // World units per quad
+    float heightScale;    // Rendered height of the noise range, (n + 1) / 2 * heightScale
+    uint32_t gridSize;    // Quads per side
+    uint32_t textureMask; // textureSize - 1, for the toroidal wrap
+    float morph;          // 1 when the level blends into the next coarser one at its border
+    float uvScale;        // World units per PSTerrain UV unit (a chunk's visible size)
+};
+
+// GPU side of a TerrainClipmap: one R32_FLOAT texture per level, updated in place when the level
+// scrolls, and the grid mesh every level draws with (the full grid for level 0, a ring around the
+// finer level for the others). The texels never move, the vertex shader wraps its fetches, so a
+// level that scrolled uploads without any data being shifted.
+//
+// Each level rewrites its texture through a few upload buffers, taking one whose copy has
+// completed. When a changed level finds none free, every level keeps drawing what it uploaded
+// last and the changes wait for the next frame, so the levels on the GPU always come from the same
+// update and their rings still fit together. Main thread only.
+class TerrainClipmapRenderer {
+public:
+    TerrainClipmapRenderer(int levelCount, int textureSize, float baseSpacing);
+
+    TerrainClipmapRenderer(const TerrainClipmapRenderer&) = delete;
+    TerrainClipmapRenderer& operator=(const TerrainClipmapRenderer&) = delete;
+
+    // Recentres the clipmap on the camera, generates what scrolled in and uploads the levels
+    // that changed. The first call creates the textures.
+    void Update(const XMFLOAT3& cameraPosition);
+
+    // Retires the textures and buffers on the direct queue
+    void Shutdown();
+
+    // False until the first Update has created the textures
+    bool IsReady() const { return !m_levels.empty() && m_levels[0].heightmap; }
+
+    int GetLevelCount() const { return m_clipmap.GetLevelCount(); }
+    float GetViewDistance() const { return m_clipmap.GetViewDistance(); }
+    const TerrainClipmap& GetClipmap() const { return m_clipmap; }
+    const Mesh& GetMesh() const { return m_grid; }
+
+    TerrainClipmapConstants GetShaderConstants(int level) const;
+    // The level's heights, and those of the level its border morphs into (itself for the
+    // outermost)
+    const Texture& GetHeightmap(int level) const { return *m_levels[level].heightmap; }
+    const Texture& GetCoarserHeightmap(int level) const;
+    ID3D12Resource* GetHeightmapResource(int level) const;
+    IndexRange GetIndexRange(int level) const;
+    // World-space box of the level over the whole height range, for frustum culling
+    TerrainBounds GetBounds(int level) const;
+
+    struct Stats {
+        size_t samplesGenerated = 0; // Since the last call
+        size_t levelsUploaded = 0;
+        size_t levelsDeferred = 0;   // Changed, but held back while upload buffers were in flight
+    };
+    Stats TakeStats();
+
+private:
+    // World units per repeat of the ground textures' UV: the visible size of a 1024 chunk, so
+    // they tile as they do on the chunks
+    static constexpr float TextureTiling = 1020.0f;
+
+    // Upload buffers per level; two cover a copy in flight while the next frame uploads, the
+    // third the frames the GPU can run behind
+    static constexpr size_t MaxUploadBuffers = 3;
+
+    struct LevelUpload {
+        Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+        uint64_t fence = 0;
+    };
+
+    struct LevelResources {
+        std::unique_ptr<Texture> heightmap;
+        std::vector<LevelUpload> uploads;
+        int gridX = 0; // Origin of the heights on the GPU
+        int gridZ = 0;
+    };
+
+    void CreateLevel(int level);
+    // An upload buffer of the level whose last copy has completed, created if there are fewer
+    // than MaxUploadBuffers. nullptr when all of them are in flight.
+    LevelUpload* FindUpload(int level);
+
+    TerrainClipmap m_clipmap;
+    Mesh m_grid;
+    std::array<IndexRange, 5> m_ranges{};
+    std::vector<LevelResources> m_levels;
+    Stats m_stats;
+};
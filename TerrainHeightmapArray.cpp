@@ -0,0 +1,212 @@
+#include "TerrainHeightmapArray.h"
+
+#include <cassert>
+#include <cstring>
+#include "DX12Renderer/Application.h"
+#include "DX12Renderer/CommandQueue.h"
+#include "DX12Renderer/DescriptorHeap.h"
+#include "DX12Renderer/Helpers.h"
+#include "DX12Renderer/ResourceStateTracker.h"
+#include "DX12Renderer/d3dx12.h"
+
+namespace {
+    constexpr DXGI_FORMAT HeightmapFormat = DXGI_FORMAT_R16_UNORM;
+    constexpr DXGI_FORMAT NormalMapFormat = DXGI_FORMAT_R8G8_UNORM;
+    constexpr UINT BytesPerTexel = 2; // Both formats
+
+    // Both terrain passes read the arrays from the vertex and domain shaders as well as the pixel
+    // shader, so they stay readable by all of them between uploads
+    constexpr D3D12_RESOURCE_STATES ShaderResourceState =
+        D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE | D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+
+    D3D12_RESOURCE_DESC ArrayDesc(DXGI_FORMAT format, uint32_t slices) {
+        return CD3DX12_RESOURCE_DESC::Tex2D(format, TerrainHeightmapArray::SliceSize, TerrainHeightmapArray::SliceSize, UINT16(slices), 1);
+    }
+}
+
+TerrainHeightmapArray::TerrainHeightmapArray(uint32_t initialCapacity)
+    : m_initialCapacity(initialCapacity), m_free(std::make_shared<FreeSlices>()) {
+    assert(initialCapacity > 0);
+}
+
+uint32_t TerrainHeightmapArray::Allocate() {
+    {
+        std::lock_guard<std::mutex> lock(m_free->mutex);
+        if (!m_free->slices.empty()) {
+            uint32_t slice = m_free->slices.back();
+            m_free->slices.pop_back();
+            return slice;
+        }
+    }
+
+    // Every slice is taken or waiting on a fence: grow, and hand out the first new one
+    const uint32_t first = m_capacity;
+    Resize(m_capacity == 0 ? m_initialCapacity : m_capacity * 2);
+
+    std::lock_guard<std::mutex> lock(m_free->mutex);
+    for (uint32_t slice = m_capacity - 1; slice > first; --slice)
+        m_free->slices.push_back(slice);
+    return first;
+}
+
+void TerrainHeightmapArray::Free(uint32_t slice) {
+    assert(slice < m_capacity);
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    std::shared_ptr<FreeSlices> freeSlices = m_free;
+    commands->ReleaseDeferred([freeSlices, slice]() {
+        std::lock_guard<std::mutex> lock(freeSlices->mutex);
+        freeSlices->slices.push_back(slice);
+    });
+}
+
+uint64_t TerrainHeightmapArray::Upload(uint32_t slice, int vertsPerSide, const std::vector<uint8_t>& heightmap,
+    const std::vector<uint8_t>& normalMap, ID3D12Resource* uploadBuffer, UINT64 uploadOffset) {
+    assert(slice < m_capacity && vertsPerSide <= SliceSize);
+    const size_t rowBytes = size_t(vertsPerSide) * BytesPerTexel;
+    assert(heightmap.size() >= rowBytes * vertsPerSide && normalMap.size() >= rowBytes * vertsPerSide);
+
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprints[2];
+    GetFootprints(vertsPerSide, uploadOffset, footprints[0], footprints[1]);
+
+    // Rows into the footprints' pitch
+    UINT8* mapped = nullptr;
+    D3D12_RANGE readRange{ 0, 0 };
+    ThrowIfFailed(uploadBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mapped)));
+    const std::vector<uint8_t>* sources[2] = { &heightmap, &normalMap };
+    for (int map = 0; map < 2; ++map) {
+        for (int row = 0; row < vertsPerSide; ++row) {
+            memcpy(mapped + footprints[map].Offset + size_t(row) * footprints[map].Footprint.RowPitch,
+                sources[map]->data() + row * rowBytes, rowBytes);
+        }
+    }
+    uploadBuffer->Unmap(0, nullptr);
+
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList = commands->GetCommandList();
+    ResourceStateTracker& stateTracker = commands->GetResourceStateTracker(commandList.Get());
+
+    // Only the slice changes state; the rest of the arrays stay readable
+    ID3D12Resource* arrays[2] = { m_heightmaps.Get(), m_normalMaps.Get() };
+    const UINT subresource = D3D12CalcSubresource(0, slice, 0, 1, m_capacity);
+    for (int map = 0; map < 2; ++map)
+        stateTracker.TransitionResource(arrays[map], D3D12_RESOURCE_STATE_COPY_DEST, subresource);
+    stateTracker.FlushResourceBarriers(commandList.Get());
+
+    for (int map = 0; map < 2; ++map) {
+        CD3DX12_TEXTURE_COPY_LOCATION destination(arrays[map], subresource);
+        CD3DX12_TEXTURE_COPY_LOCATION source(uploadBuffer, footprints[map]);
+        commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+        stateTracker.TransitionResource(arrays[map], ShaderResourceState, subresource);
+    }
+
+    return commands->ExecuteCommandList(commandList);
+}
+
+UINT64 TerrainHeightmapArray::GetUploadSize(int vertsPerSide) {
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT heightmap, normalMap;
+    UINT64 totalBytes = 0;
+    GetFootprints(vertsPerSide, 0, heightmap, normalMap, &totalBytes);
+    return totalBytes;
+}
+
+size_t TerrainHeightmapArray::GetMemory() const {
+    if (!IsCreated())
+        return 0;
+
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+    size_t bytes = 0;
+    for (ID3D12Resource* resource : { m_heightmaps.Get(), m_normalMaps.Get() }) {
+        D3D12_RESOURCE_DESC desc = resource->GetDesc();
+        bytes += size_t(device->GetResourceAllocationInfo(0, 1, &desc).SizeInBytes);
+    }
+    return bytes;
+}
+
+void TerrainHeightmapArray::Resize(uint32_t capacity) {
+    assert(capacity > m_capacity && capacity <= D3D12_REQ_TEXTURE2D_ARRAY_AXIS_DIMENSION);
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+    auto commands = Application::Get().GetCommandQueue(D3D12_COMMAND_LIST_TYPE_DIRECT);
+    auto srvHeap = Application::Get().GetDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+
+    const bool copy = IsCreated();
+    const DXGI_FORMAT formats[2] = { HeightmapFormat, NormalMapFormat };
+    Microsoft::WRL::ComPtr<ID3D12Resource>* arrays[2] = { &m_heightmaps, &m_normalMaps };
+    uint32_t* descriptors[2] = { &m_heightmapDescriptor, &m_normalMapDescriptor };
+    Microsoft::WRL::ComPtr<ID3D12Resource> created[2];
+
+    // Slices get their texels from Upload before any chunk samples them, so a new array can start
+    // out readable; one that takes the old slices starts as the copy destination
+    D3D12_HEAP_PROPERTIES heapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+    for (int map = 0; map < 2; ++map) {
+        D3D12_RESOURCE_DESC desc = ArrayDesc(formats[map], capacity);
+        ThrowIfFailed(device->CreateCommittedResource(
+            &heapProperties,
+            D3D12_HEAP_FLAG_NONE,
+            &desc,
+            copy ? D3D12_RESOURCE_STATE_COPY_DEST : ShaderResourceState,
+            nullptr,
+            IID_PPV_ARGS(&created[map])));
+        ResourceStateTracker::AddGlobalResourceState(created[map].Get(), copy ? D3D12_RESOURCE_STATE_COPY_DEST : ShaderResourceState);
+    }
+    created[0]->SetName(L"Terrain Heightmap Array");
+    created[1]->SetName(L"Terrain Normal Map Array");
+
+    if (copy) {
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList = commands->GetCommandList();
+        ResourceStateTracker& stateTracker = commands->GetResourceStateTracker(commandList.Get());
+
+        // The old arrays are retired as the copy source; nothing records against them after this
+        for (int map = 0; map < 2; ++map)
+            stateTracker.TransitionResource(arrays[map]->Get(), D3D12_RESOURCE_STATE_COPY_SOURCE);
+        stateTracker.FlushResourceBarriers(commandList.Get());
+
+        for (int map = 0; map < 2; ++map) {
+            for (uint32_t slice = 0; slice < m_capacity; ++slice) {
+                CD3DX12_TEXTURE_COPY_LOCATION destination(created[map].Get(), D3D12CalcSubresource(0, slice, 0, 1, capacity));
+                CD3DX12_TEXTURE_COPY_LOCATION source(arrays[map]->Get(), D3D12CalcSubresource(0, slice, 0, 1, m_capacity));
+                commandList->CopyTextureRegion(&destination, 0, 0, 0, &source, nullptr);
+            }
+            stateTracker.TransitionResource(created[map].Get(), ShaderResourceState);
+        }
+
+        // Frames in flight keep reading the old arrays through the old descriptors
+        uint64_t fenceValue = commands->ExecuteCommandList(commandList);
+        for (int map = 0; map < 2; ++map) {
+            ResourceStateTracker::RemoveGlobalResourceState(arrays[map]->Get());
+            commands->ReleaseDeferred(std::move(*arrays[map]), fenceValue);
+            commands->FreeDescriptorDeferred(srvHeap, *descriptors[map], fenceValue);
+        }
+    }
+
+    for (int map = 0; map < 2; ++map) {
+        *arrays[map] = std::move(created[map]);
+
+        D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+        srvDesc.Format = formats[map];
+        srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+        srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+        srvDesc.Texture2DArray.MipLevels = 1;
+        srvDesc.Texture2DArray.ArraySize = capacity;
+
+        *descriptors[map] = srvHeap->GetNextIndex();
+        device->CreateShaderResourceView(arrays[map]->Get(), &srvDesc, srvHeap->GetCPUHandleAt(*descriptors[map]));
+    }
+    m_capacity = capacity;
+}
+
+void TerrainHeightmapArray::GetFootprints(int vertsPerSide, UINT64 uploadOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT& heightmap,
+    D3D12_PLACED_SUBRESOURCE_FOOTPRINT& normalMap, UINT64* totalBytes) {
+    ComPtr<ID3D12Device2> device = Application::Get().GetDevice();
+
+    // Footprints of a vertsPerSide texture: the copies write only that corner of the slice
+    D3D12_RESOURCE_DESC heightmapDesc = CD3DX12_RESOURCE_DESC::Tex2D(HeightmapFormat, UINT64(vertsPerSide), UINT(vertsPerSide), 1, 1);
+    D3D12_RESOURCE_DESC normalMapDesc = CD3DX12_RESOURCE_DESC::Tex2D(NormalMapFormat, UINT64(vertsPerSide), UINT(vertsPerSide), 1, 1);
+
+    UINT64 heightmapBytes = 0, normalMapBytes = 0;
+    device->GetCopyableFootprints(&heightmapDesc, 0, 1, uploadOffset, &heightmap, nullptr, nullptr, &heightmapBytes);
+    const UINT64 normalOffset = Math::AlignUp(uploadOffset + heightmapBytes, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+    device->GetCopyableFootprints(&normalMapDesc, 0, 1, normalOffset, &normalMap, nullptr, nullptr, &normalMapBytes);
+
+    if (totalBytes)
+        *totalBytes = normalOffset + normalMapBytes - uploadOffset;
+}
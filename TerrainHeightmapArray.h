@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <d3d12.h>
+#include <wrl.h>
+
+// Heightmaps and normal maps of every terrain chunk, as slices of two Texture2DArrays (R16_UNORM
+// heights, octahedral RG8_UNORM normals) with one SRV each. A chunk holds a slice instead of two
+// textures of its own, so the terrain passes bind both arrays once and transition them with one
+// barrier call however many chunks are loaded. Slices are SliceSize texels square; a chunk of a
+// coarser LOD tier fills the top-left vertsPerSide texels of its slice.
+//
+// Slices come from a free list. When it runs dry the arrays are recreated at twice the size and
+// the slices copied over on the GPU, so the descriptors change; read them every frame. Between
+// uploads both arrays are readable by every shader stage, which is what the terrain passes ask the
+// state tracker for. Main thread only, apart from the fence callbacks that return freed slices.
+class TerrainHeightmapArray {
+public:
+    static constexpr int SliceSize = 256; // Texels per side, the finest tier's heightmap
+
+    explicit TerrainHeightmapArray(uint32_t initialCapacity = 64);
+
+    TerrainHeightmapArray(const TerrainHeightmapArray&) = delete;
+    TerrainHeightmapArray& operator=(const TerrainHeightmapArray&) = delete;
+
+    // A free slice; the arrays are created on the first call and grow when every slice is taken
+    uint32_t Allocate();
+    // Frames in flight may still sample the slice, so it only becomes free once the direct queue
+    // has passed the next fence.
+    void Free(uint32_t slice);
+
+    // Copies vertsPerSide^2 tightly packed texels of each map into the top-left of the slice,
+    // through uploadBuffer (GetUploadSize bytes from uploadOffset). Returns the fence value after
+    // which that part of the upload buffer is free again.
+    uint64_t Upload(uint32_t slice, int vertsPerSide, const std::vector<uint8_t>& heightmap,
+        const std::vector<uint8_t>& normalMap, ID3D12Resource* uploadBuffer, UINT64 uploadOffset);
+    static UINT64 GetUploadSize(int vertsPerSide);
+
+    bool IsCreated() const { return m_heightmaps != nullptr; }
+    ID3D12Resource* GetHeightmapResource() const { return m_heightmaps.Get(); }
+    ID3D12Resource* GetNormalMapResource() const { return m_normalMaps.Get(); }
+    uint32_t GetHeightmapDescriptor() const { return m_heightmapDescriptor; }
+    uint32_t GetNormalMapDescriptor() const { return m_normalMapDescriptor; }
+    uint32_t GetCapacity() const { return m_capacity; }
+    size_t GetMemory() const; // GPU memory of both arrays
+
+private:
+    // Shared with the fence callbacks, which can run after the array is gone
+    struct FreeSlices {
+        std::mutex mutex;
+        std::vector<uint32_t> slices;
+    };
+
+    // Creates both arrays with capacity slices and their SRVs, copying the current slices over
+    void Resize(uint32_t capacity);
+    // Placed footprints of both maps in an upload buffer, heights first
+    static void GetFootprints(int vertsPerSide, UINT64 uploadOffset, D3D12_PLACED_SUBRESOURCE_FOOTPRINT& heightmap,
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT& normalMap, UINT64* totalBytes = nullptr);
+
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_heightmaps;
+    Microsoft::WRL::ComPtr<ID3D12Resource> m_normalMaps;
+    uint32_t m_heightmapDescriptor = UINT32_MAX;
+    uint32_t m_normalMapDescriptor = UINT32_MAX;
+    uint32_t m_capacity = 0;
+    uint32_t m_initialCapacity;
+    std::shared_ptr<FreeSlices> m_free;
+};
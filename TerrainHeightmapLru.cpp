@@ -0,0 +1,114 @@
+#include "TerrainHeightmapLru.h"
+#include "DX12Renderer/PixelConversion.h"
+
+TerrainHeightmapLru::TerrainHeightmapLru(size_t byteBudget, bool quantize)
+    : m_byteBudget(byteBudget), m_quantize(quantize)
+{
+}
+
+bool TerrainHeightmapLru::Load(int chunkX, int chunkZ, uint64_t paramHash, std::vector<float>& heights)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(Key(chunkX, chunkZ, paramHash));
+    if (it == m_index.end()) {
+        ++m_misses;
+        return false;
+    }
+
+    // Most recently used goes to the front
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    const Entry& entry = *it->second;
+    ++m_hits;
+
+    if (entry.steps.empty()) {
+        heights = entry.heights;
+        return true;
+    }
+
+    // Same mapping as FloatToUnorm16, inverted. Written as a blend so the end steps give back
+    // the minimum and maximum exactly and the chunk's height range comes out unchanged.
+    heights.resize(entry.steps.size());
+    for (size_t i = 0; i < entry.steps.size(); ++i) {
+        const float t = float(entry.steps[i]) / 65535.0f;
+        heights[i] = entry.minHeight * (1.0f - t) + entry.maxHeight * t;
+    }
+    return true;
+}
+
+void TerrainHeightmapLru::Store(int chunkX, int chunkZ, uint64_t paramHash, std::vector<float>&& heights)
+{
+    if (heights.empty())
+        return;
+
+    bool quantize;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        quantize = m_quantize;
+    }
+
+    Entry entry;
+    entry.key = Key(chunkX, chunkZ, paramHash);
+    if (quantize) {
+        // Quantized outside the lock; workers may be loading meanwhile
+        PixelConversion::MinMax(heights.data(), heights.size(), entry.minHeight, entry.maxHeight);
+        entry.steps.resize(heights.size());
+        PixelConversion::FloatToUnorm16(heights.data(), entry.steps.data(), heights.size(), entry.minHeight, entry.maxHeight);
+        entry.bytes = entry.steps.size() * sizeof(uint16_t);
+    }
+    else {
+        entry.heights = std::move(heights);
+        entry.bytes = entry.heights.size() * sizeof(float);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (entry.bytes > m_byteBudget)
+        return;
+
+    auto existing = m_index.find(entry.key);
+    if (existing != m_index.end()) {
+        m_bytes -= existing->second->bytes;
+        m_entries.erase(existing->second);
+        m_index.erase(existing);
+    }
+
+    // Make room first, so the new entry is never the one evicted
+    Evict(m_byteBudget - entry.bytes);
+    m_bytes += entry.bytes;
+    m_entries.push_front(std::move(entry));
+    m_index[m_entries.front().key] = m_entries.begin();
+}
+
+void TerrainHeightmapLru::SetByteBudget(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_byteBudget = bytes;
+    Evict(m_byteBudget);
+}
+
+void TerrainHeightmapLru::SetQuantized(bool quantize)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quantize = quantize;
+}
+
+TerrainHeightmapLru::Stats TerrainHeightmapLru::TakeStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    stats.entries = m_entries.size();
+    stats.bytes = m_bytes;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    m_hits = 0;
+    m_misses = 0;
+    return stats;
+}
+
+void TerrainHeightmapLru::Evict(size_t byteBudget)
+{
+    while (m_bytes > byteBudget && !m_entries.empty()) {
+        m_bytes -= m_entries.back().bytes;
+        m_index.erase(m_entries.back().key);
+        m_entries.pop_back();
+    }
+}
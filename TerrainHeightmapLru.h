@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+// In-memory cache of the heightmaps of recently evicted chunks, least recently used first out.
+//
+// Keyed like TerrainChunkCache: chunk coordinates plus the hash of every parameter that affects
+// the heights (including the sample count, so each LOD tier has its own entries). Entries of
+// older parameters simply age out. A chunk that comes back while its heightmap is still here
+// skips noise generation.
+//
+// Quantized entries store each sample as a 16-bit step between the chunk's minimum and maximum,
+// half the bytes of float samples. That is the quantization of the R16_UNORM heightmap texture,
+// so the texture a returning chunk uploads is unchanged; only its normals and bounds see the
+// rounding. It is plain range quantization of the heights, not delta coding between neighbouring
+// samples: every sample stands alone, so one step is (max - min) / 65535 and, rounding to nearest,
+// a sample comes back within half a step of what was stored. The chunk's minimum and maximum
+// themselves come back exactly.
+//
+// Thread-safe: chunks are generated on the worker pool.
+class TerrainHeightmapLru {
+public:
+    TerrainHeightmapLru(size_t byteBudget, bool quantize);
+
+    TerrainHeightmapLru(const TerrainHeightmapLru&) = delete;
+    TerrainHeightmapLru& operator=(const TerrainHeightmapLru&) = delete;
+
+    // Copies the heights into 'heights' and marks the entry most recently used. Returns false on
+    // a miss.
+    bool Load(int chunkX, int chunkZ, uint64_t paramHash, std::vector<float>& heights);
+    // Takes over the heights, replacing an entry with the same key, then drops the least recently
+    // used entries until the cache fits its budget again. An entry larger than the whole budget
+    // is not kept.
+    void Store(int chunkX, int chunkZ, uint64_t paramHash, std::vector<float>&& heights);
+
+    // Shrinking the budget evicts right away; the quantization setting applies to new entries.
+    // Quantized heights are off by at most (max - min) / 131070 of their chunk (see above).
+    void SetByteBudget(size_t bytes);
+    void SetQuantized(bool quantize);
+
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+    // Hit and miss counts since the last call
+    Stats TakeStats();
+
+private:
+    using Key = std::tuple<int, int, uint64_t>;
+
+    struct Entry {
+        Key key;
+        std::vector<float> heights;    // Unquantized entries
+        std::vector<uint16_t> steps;   // Quantized entries
+        float minHeight = 0.0f;
+        float maxHeight = 0.0f;
+        size_t bytes = 0;
+    };
+
+    void Evict(size_t byteBudget);
+
+    std::list<Entry> m_entries; // Most recently used first
+    std::map<Key, std::list<Entry>::iterator> m_index;
+    size_t m_bytes = 0;
+    size_t m_byteBudget;
+    bool m_quantize;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    std::mutex m_mutex;
+};
@@ -0,0 +1,400 @@
+#include "TerrainNoise.h"
+#include "DX12Renderer/NoiseGradient.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace
+{
+    using namespace Simd;
+
+    std::atomic<Level>& ActiveLevel()
+    {
+        static std::atomic<Level> level(GetSupportedLevel());
+        return level;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Kernels. Written once over the Simd lane types, so every width rounds the same way.
+    ////////////////////////////////////////////////////////////////////////////////
+
+    template <class L>
+    typename L::F PerlinKernel(const TerrainNoise::PerlinSettings& settings, typename L::F x, typename L::F y)
+    {
+        return NoiseGradient::Perlin<L>(settings.seed, settings.frequency, x, y);
+    }
+
+    template <class L>
+    NoiseGradient::Sample<L> PerlinGradKernel(const TerrainNoise::PerlinSettings& settings, typename L::F x, typename L::F y)
+    {
+        return NoiseGradient::PerlinSample<L>(settings.seed, settings.frequency, x, y);
+    }
+
+    // Theoretical amplitude sum (no attenuation) for normalization.
+    float AmplitudeSum(int octaves, float gain)
+    {
+        float sumAmp = 0.0f;
+        float ampTmp = 1.0f;
+        for (int i = 0; i < octaves; i++) {
+            sumAmp += ampTmp;
+            ampTmp *= gain;
+        }
+        return sumAmp;
+    }
+
+    // Everything TerrainNoiseReference::UberNoise carries from one octave to the next. The field order
+    // matches TerrainNoise::UberNoiseStateFields.
+    template <class L>
+    struct UberNoiseState
+    {
+        using F = typename L::F;
+        static constexpr int FieldCount = 11;
+
+        F sum, amplitude, dampedAmplitude;
+        F slopeDerX, slopeDerZ;
+        F ridgeDerX, ridgeDerZ;
+        F perturbDerX, perturbDerZ;
+        F offsetX, offsetZ; // Perturbation the next octave samples at (x = x0 * freq + offset)
+
+        static constexpr F UberNoiseState::* Fields[FieldCount] = {
+            &UberNoiseState::sum, &UberNoiseState::amplitude, &UberNoiseState::dampedAmplitude,
+            &UberNoiseState::slopeDerX, &UberNoiseState::slopeDerZ,
+            &UberNoiseState::ridgeDerX, &UberNoiseState::ridgeDerZ,
+            &UberNoiseState::perturbDerX, &UberNoiseState::perturbDerZ,
+            &UberNoiseState::offsetX, &UberNoiseState::offsetZ };
+
+        static UberNoiseState Initial()
+        {
+            const F zero = L::Set(0.0f);
+            return { L::Set(0.5f), L::Set(1.0f), zero, zero, zero, zero, zero, zero, zero, zero, zero };
+        }
+    };
+
+    // Frequency octave i is evaluated at: lacunarity^i, multiplied up the same way the loop does.
+    float OctaveFrequency(int octave, float lacunarity)
+    {
+        float freq = 1.0f;
+        for (int i = 0; i < octave; i++)
+            freq *= lacunarity;
+        return freq;
+    }
+
+    // Octaves [first, last) of TerrainNoiseReference::UberNoise. Running [0, a) and then [a, b) on the
+    // same state gives the same bits as running [0, b).
+    template <class L>
+    void UberNoiseOctaves(const TerrainNoise::PerlinSettings& settings, const UberNoiseParams& p,
+        UberNoiseState<L>& st, typename L::F x0, typename L::F z0, int first, int last)
+    {
+        using F = typename L::F;
+
+        const float billowT = std::max(0.0f, p.sharpness);
+        const float ridgedT = std::abs(std::min(0.0f, p.sharpness));
+        const F zero = L::Set(0.0f);
+        const F one = L::Set(1.0f);
+
+        float prevFreq = first > 0 ? OctaveFrequency(first - 1, p.lacunarity) : 1.0f;
+        float freq = first > 0 ? prevFreq * p.lacunarity : 1.0f;
+
+        for (int i = first; i < last; i++) {
+            const float currentGain = i == 0 ? p.gain : p.gain + p.amplify;
+            F x = i == 0 ? x0 : (x0 * L::Set(prevFreq)) + st.offsetX;
+            F z = i == 0 ? z0 : (z0 * L::Set(prevFreq)) + st.offsetZ;
+
+            // Sample noise together with its gradient
+            NoiseGradient::Sample<L> sample = PerlinGradKernel<L>(settings, x, z);
+            F n = sample.value;
+
+            F ridgedNoise = one - Abs(n);
+            F billowNoise = n * n;
+
+            // The derivative follows the shaping, so erosion sees the slope of the noise it adds.
+            F shapeDer = one;
+            n = LerpExact<L>(n, billowNoise, billowT);
+            if (billowT != 0.0f) {
+                shapeDer = one + L::Set(billowT) * (L::Set(2.0f) * sample.value - one);
+            }
+            F dnX = sample.dx * shapeDer;
+            F dnZ = sample.dy * shapeDer;
+
+            n = LerpExact<L>(n, ridgedNoise, ridgedT);
+            if (ridgedT != 0.0f) {
+                F ridgedDer = Select(sample.value < zero, one, -one);
+                dnX = dnX + L::Set(ridgedT) * (sample.dx * ridgedDer - dnX);
+                dnZ = dnZ + L::Set(ridgedT) * (sample.dy * ridgedDer - dnZ);
+            }
+
+            // Derivative of this octave's noise (in base coords)
+            F dx_n = zero, dz_n = zero;
+            if (p.kAtten > 0.0f) {
+                dx_n = dnX * L::Set(freq);
+                dz_n = dnZ * L::Set(freq);
+            }
+
+            st.slopeDerX = (st.slopeDerX + dx_n) * L::Set(p.slopeErode);
+            st.slopeDerZ = (st.slopeDerZ + dz_n) * L::Set(p.slopeErode);
+            F dot = st.slopeDerX * st.slopeDerX + st.slopeDerZ * st.slopeDerZ;
+
+            st.sum += st.amplitude * n * (one / (one + dot));
+            st.sum += st.dampedAmplitude * n * (one / (one + dot));
+
+            // smoothstep(0, 1, sum)
+            F s = Min(Max(st.sum, zero), one);
+            s = s * s * (L::Set(3.0f) - L::Set(2.0f) * s);
+            st.amplitude *= LerpExact<L>(L::Set(currentGain), L::Set(currentGain) * s, p.altitudeErode);
+
+            st.ridgeDerX = (st.ridgeDerX + dx_n) * L::Set(p.ridgeErode);
+            st.ridgeDerZ = (st.ridgeDerZ + dz_n) * L::Set(p.ridgeErode);
+            F dotRidge = st.ridgeDerX * st.ridgeDerX + st.ridgeDerZ * st.ridgeDerZ;
+            st.dampedAmplitude = st.amplitude * (one - (L::Set(p.ridgeErode) / (one + dotRidge)));
+
+            st.offsetX = st.perturbDerX;
+            st.offsetZ = st.perturbDerZ;
+            st.perturbDerX = (st.perturbDerX + dx_n) * L::Set(p.perturbAmt);
+            st.perturbDerZ = (st.perturbDerZ + dz_n) * L::Set(p.perturbAmt);
+
+            prevFreq = freq;
+            freq *= p.lacunarity;
+        }
+    }
+
+    // TerrainNoiseReference::UberNoise.
+    template <class L>
+    typename L::F UberNoiseKernel(const TerrainNoise::PerlinSettings& settings, const UberNoiseParams& p,
+        typename L::F x0, typename L::F z0)
+    {
+        UberNoiseState<L> st = UberNoiseState<L>::Initial();
+        UberNoiseOctaves<L>(settings, p, st, x0, z0, 0, p.octaves);
+        return st.sum / L::Set(AmplitudeSum(p.octaves, p.gain));
+    }
+
+    // UberNoise cut off after 'octaves' octaves, divided by the full amplitude sum.
+    template <class L>
+    typename L::F UberNoiseLowOctavesKernel(const TerrainNoise::PerlinSettings& settings, const UberNoiseParams& p,
+        int octaves, typename L::F x0, typename L::F z0)
+    {
+        UberNoiseState<L> st = UberNoiseState<L>::Initial();
+        UberNoiseOctaves<L>(settings, p, st, x0, z0, 0, octaves);
+        return st.sum / L::Set(AmplitudeSum(p.octaves, p.gain));
+    }
+
+    // TerrainNoiseReference::FbmNoiseWithFD.
+    template <class L>
+    typename L::F FbmNoiseWithFDKernel(const TerrainNoise::PerlinSettings& settings,
+        int octaves, float lac, float gain, float kAtten,
+        typename L::F x0, typename L::F z0)
+    {
+        using F = typename L::F;
+
+        const float sumAmp = AmplitudeSum(octaves, gain);
+        const F zero = L::Set(0.0f);
+        const F one = L::Set(1.0f);
+
+        F sum = L::Set(0.5f);
+        F amplitude = one;
+        float freq = 1.0f;
+
+        F dsumX = zero, dsumZ = zero;
+        F derivX = zero, derivZ = zero;
+
+        for (int i = 0; i < octaves; i++) {
+            F x = x0 * L::Set(freq);
+            F z = z0 * L::Set(freq);
+
+            NoiseGradient::Sample<L> sample = PerlinGradKernel<L>(settings, x, z);
+            F n = sample.value;
+
+            F dx_n = zero, dz_n = zero;
+            if (kAtten > 0.0f) {
+                dx_n = sample.dx * L::Set(freq);
+                dz_n = sample.dy * L::Set(freq);
+            }
+
+            dsumX = dsumX + dx_n;
+            dsumZ = dsumZ + dz_n;
+            F dot = dsumX * dsumX + dsumZ * dsumZ;
+
+            sum += amplitude * n / (one + dot);
+
+            if (kAtten > 0.0f) {
+                derivX += dx_n * amplitude;
+                derivZ += dz_n * amplitude;
+                F slopeAccum = Sqrt(derivX * derivX + derivZ * derivZ);
+                F attenuation = Exp<L>(L::Set(-kAtten) * slopeAccum);
+                amplitude *= L::Set(gain) * attenuation;
+            }
+            else {
+                amplitude *= L::Set(gain);
+            }
+
+            freq *= lac;
+        }
+
+        return sum / L::Set(sumAmp);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    // Dispatch
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // Runs the kernel over whole blocks of L::Width starting at 'first' and returns the
+    // index of the first sample it did not process.
+    template <class L, class Kernel>
+    int RunBlocks(const float* x, const float* z, float* out, int first, int count, const Kernel& kernel)
+    {
+        int i = first;
+        for (; i + L::Width <= count; i += L::Width) {
+            L::Store(out + i, kernel(L(), L::Load(x + i), L::Load(z + i)));
+        }
+        return i;
+    }
+
+    // Like RunBlocks, for kernels that also read or write UberNoise state. Field f of sample i
+    // lives at state[f * stateStride + i].
+    template <class L, class Kernel>
+    int RunStateBlocks(const float* x, const float* z, float* state, size_t stateStride, float* out,
+        int first, int count, const Kernel& kernel)
+    {
+        int i = first;
+        for (; i + L::Width <= count; i += L::Width) {
+            kernel(L(), L::Load(x + i), L::Load(z + i), state + i, stateStride, out ? out + i : nullptr);
+        }
+        return i;
+    }
+
+    template <class Kernel>
+    void RunState(const float* x, const float* z, float* state, size_t stateStride, float* out, int count, const Kernel& kernel)
+    {
+        int i = 0;
+        switch (TerrainNoise::GetSimdLevel()) {
+        case Level::AVX2:
+            i = RunStateBlocks<AVX2Lanes>(x, z, state, stateStride, out, i, count, kernel);
+            break;
+        case Level::SSE41:
+            i = RunStateBlocks<SSE41Lanes>(x, z, state, stateStride, out, i, count, kernel);
+            break;
+        default:
+            break;
+        }
+        RunStateBlocks<ScalarLanes>(x, z, state, stateStride, out, i, count, kernel);
+    }
+
+    template <class Kernel>
+    void Run(const float* x, const float* z, float* out, int count, const Kernel& kernel)
+    {
+        int i = 0;
+        switch (TerrainNoise::GetSimdLevel()) {
+        case Level::AVX2:
+            i = RunBlocks<AVX2Lanes>(x, z, out, i, count, kernel);
+            break;
+        case Level::SSE41:
+            i = RunBlocks<SSE41Lanes>(x, z, out, i, count, kernel);
+            break;
+        default:
+            break;
+        }
+        RunBlocks<ScalarLanes>(x, z, out, i, count, kernel);
+    }
+}
+
+Simd::Level TerrainNoise::GetSimdLevel()
+{
+    return ActiveLevel().load(std::memory_order_relaxed);
+}
+
+void TerrainNoise::SetSimdLevel(Simd::Level level)
+{
+    const Level supported = GetSupportedLevel();
+    ActiveLevel().store(level > supported ? supported : level, std::memory_order_relaxed);
+}
+
+float TerrainNoise::Perlin(const PerlinSettings& settings, float x, float y)
+{
+    return PerlinKernel<ScalarLanes>(settings, x, y);
+}
+
+void TerrainNoise::Perlin(const PerlinSettings& settings, const float* x, const float* y, float* out, int count)
+{
+    Run(x, y, out, count, [&](auto lanes, auto vx, auto vy) {
+        return PerlinKernel<decltype(lanes)>(settings, vx, vy);
+    });
+}
+
+void TerrainNoise::UberNoise(const PerlinSettings& settings, const UberNoiseParams& params,
+    const float* x, const float* z, float* out, int count)
+{
+    Run(x, z, out, count, [&](auto lanes, auto vx, auto vz) {
+        return UberNoiseKernel<decltype(lanes)>(settings, params, vx, vz);
+    });
+}
+
+void TerrainNoise::UberNoiseLowOctaves(const PerlinSettings& settings, const UberNoiseParams& params, int octaveCount,
+    const float* x, const float* z, float* out, int count)
+{
+    const int octaves = std::min(octaveCount, params.octaves);
+    Run(x, z, out, count, [&](auto lanes, auto vx, auto vz) {
+        return UberNoiseLowOctavesKernel<decltype(lanes)>(settings, params, octaves, vx, vz);
+    });
+}
+
+void TerrainNoise::UberNoiseBegin(const PerlinSettings& settings, const UberNoiseParams& params, int octaveCount,
+    const float* x, const float* z, float* state, size_t stateStride, int count)
+{
+    assert(octaveCount >= 0 && octaveCount <= params.octaves);
+    RunState(x, z, state, stateStride, nullptr, count, [&](auto lanes, auto vx, auto vz, float* st, size_t stride, float*) {
+        using L = decltype(lanes);
+        UberNoiseState<L> s = UberNoiseState<L>::Initial();
+        UberNoiseOctaves<L>(settings, params, s, vx, vz, 0, octaveCount);
+        for (int f = 0; f < UberNoiseState<L>::FieldCount; f++)
+            L::Store(st + f * stride, s.*UberNoiseState<L>::Fields[f]);
+    });
+}
+
+void TerrainNoise::UberNoiseFinish(const PerlinSettings& settings, const UberNoiseParams& params, int firstOctave,
+    const float* x, const float* z, const float* state, size_t stateStride, float* out, int count)
+{
+    assert(firstOctave >= 0 && firstOctave <= params.octaves);
+    const float sumAmp = AmplitudeSum(params.octaves, params.gain);
+    RunState(x, z, const_cast<float*>(state), stateStride, out, count, [&](auto lanes, auto vx, auto vz, float* st, size_t stride, float* o) {
+        using L = decltype(lanes);
+        UberNoiseState<L> s;
+        for (int f = 0; f < UberNoiseState<L>::FieldCount; f++)
+            s.*UberNoiseState<L>::Fields[f] = L::Load(st + f * stride);
+        UberNoiseOctaves<L>(settings, params, s, vx, vz, firstOctave, params.octaves);
+        L::Store(o, s.sum / L::Set(sumAmp));
+    });
+}
+
+void TerrainNoise::BlendRows(const float* r0, const float* r1, const float* r2, const float* r3,
+    const float weights[4], float* out, int count)
+{
+    auto blend = [&](auto lanes, int i) {
+        using L = decltype(lanes);
+        L::Store(out + i, L::Set(weights[0]) * L::Load(r0 + i) + L::Set(weights[1]) * L::Load(r1 + i)
+            + L::Set(weights[2]) * L::Load(r2 + i) + L::Set(weights[3]) * L::Load(r3 + i));
+    };
+
+    int i = 0;
+    switch (GetSimdLevel()) {
+    case Level::AVX2:
+        for (; i + AVX2Lanes::Width <= count; i += AVX2Lanes::Width)
+            blend(AVX2Lanes(), i);
+        break;
+    case Level::SSE41:
+        for (; i + SSE41Lanes::Width <= count; i += SSE41Lanes::Width)
+            blend(SSE41Lanes(), i);
+        break;
+    default:
+        break;
+    }
+    for (; i < count; ++i)
+        blend(ScalarLanes(), i);
+}
+
+void TerrainNoise::FbmNoiseWithFD(const PerlinSettings& settings, int octaves, float lac, float gain, float kAtten,
+    const float* x, const float* z, float* out, int count)
+{
+    Run(x, z, out, count, [&](auto lanes, auto vx, auto vz) {
+        return FbmNoiseWithFDKernel<decltype(lanes)>(settings, octaves, lac, gain, kAtten, vx, vz);
+    });
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "DX12Renderer/SimdLanes.h"
+
+// Parameters of TerrainNoise::UberNoise. The defaults are the values GenerateChunkHeightmap uses.
+struct UberNoiseParams
+{
+    int   octaves = 8;
+    float perturbAmt = 0.15f;
+    float sharpness = 0.25f;
+    float amplify = 0.2f;
+    float altitudeErode = 0.75f;
+    float ridgeErode = 0.75f;
+    float slopeErode = 0.001f;
+    float lacunarity = 1.8f;
+    float gain = 0.5f;
+    float kAtten = 0.5f;
+
+    // Multi-rate evaluation (TerrainChunk::GenerateChunkHeightmap). The first coarseOctaves
+    // octaves change slowly between neighbouring samples, so they are evaluated on a grid
+    // coarseStride times sparser and upsampled bicubically; only the remaining octaves run at
+    // full resolution. 0 evaluates every octave per sample (the reference).
+    int   coarseOctaves = 0;
+    int   coarseStride = 4;
+};
+
+// Batched terrain noise. Evaluates 8 (AVX2) or 4 (SSE4.1) samples per step and picks the
+// widest instruction set the CPU supports at runtime; leftover samples run on the scalar path.
+//
+// Per-octave slopes come from the analytic Perlin gradient (NoiseGradient.h), so each octave
+// costs one noise evaluation instead of three and has no eps-dependent error.
+//
+// Tolerance: every width produces the same bits, so the scalar fallback is exact. Perlin is
+// bit-identical to FastNoiseLite::GetNoise under /fp:precise, and UberNoise to the scalar
+// reference TerrainNoiseReference::UberNoise. FbmNoiseWithFD uses a polynomial exp for the slope
+// attenuation, within 2 ulp of std::exp (TerrainNoiseReference::FbmNoiseWithFD uses std::exp).
+namespace TerrainNoise
+{
+    // The FastNoiseLite Perlin state the terrain samples: NoiseType_Perlin, FractalType_None.
+    struct PerlinSettings
+    {
+        int seed = 1337;
+        float frequency = 0.01f;
+    };
+
+    // Instruction set used by the batch functions. Defaults to the best supported one;
+    // SetSimdLevel clamps to what the CPU supports (use Scalar to compare against the SIMD paths).
+    Simd::Level GetSimdLevel();
+    void SetSimdLevel(Simd::Level level);
+
+    float Perlin(const PerlinSettings& settings, float x, float y);
+
+    void Perlin(const PerlinSettings& settings, const float* x, const float* y, float* out, int count);
+
+    void UberNoise(const PerlinSettings& settings, const UberNoiseParams& params,
+        const float* x, const float* z, float* out, int count);
+
+    // The first octaveCount octaves of UberNoise, normalized like the full sum, so the result is
+    // the reference minus its finest octaves. For distant terrain sampled too sparsely to resolve
+    // the rest. octaveCount >= params.octaves gives the same bits as UberNoise.
+    void UberNoiseLowOctaves(const PerlinSettings& settings, const UberNoiseParams& params, int octaveCount,
+        const float* x, const float* z, float* out, int count);
+
+    // UberNoise split at an octave boundary, for multi-rate evaluation. UberNoiseBegin runs the
+    // first octaveCount octaves and writes the state carried into the next one, field-major:
+    // field f of sample i at state[f * stateStride + i]. UberNoiseFinish runs the remaining
+    // octaves from such a state (which may have been resampled in between). Begin followed by
+    // Finish on the same samples gives the same bits as UberNoise.
+    constexpr int UberNoiseStateFields = 11;
+
+    void UberNoiseBegin(const PerlinSettings& settings, const UberNoiseParams& params, int octaveCount,
+        const float* x, const float* z, float* state, size_t stateStride, int count);
+
+    void UberNoiseFinish(const PerlinSettings& settings, const UberNoiseParams& params, int firstOctave,
+        const float* x, const float* z, const float* state, size_t stateStride, float* out, int count);
+
+    // out[i] = sum of weights[k] * rk[i]. Used to upsample UberNoise state between grids.
+    void BlendRows(const float* r0, const float* r1, const float* r2, const float* r3,
+        const float weights[4], float* out, int count);
+
+    void FbmNoiseWithFD(const PerlinSettings& settings, int octaves, float lac, float gain, float kAtten,
+        const float* x, const float* z, float* out, int count);
+}
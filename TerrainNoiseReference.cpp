@@ -0,0 +1,193 @@
+#include "TerrainNoiseReference.h"
+#include "DX12Renderer/FastNoiseLite.h"
+#include "DX12Renderer/NoiseGradient.h"
+
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace {
+    // FastNoiseLite in the state TerrainNoise::PerlinSettings describes
+    FastNoiseLite MakeReferenceNoise(const TerrainNoise::PerlinSettings& perlin) {
+        FastNoiseLite noise(perlin.seed);
+        noise.SetNoiseType(FastNoiseLite::NoiseType_Perlin);
+        noise.SetFrequency(perlin.frequency);
+        noise.SetFractalType(FastNoiseLite::FractalType_None);
+        return noise;
+    }
+
+    float smoothstep(float edge0, float edge1, float x) {
+        // Scale, bias and saturate x to 0..1 range
+        x = std::clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+        // Evaluate polynomial
+        return x * x * (3 - 2 * x);
+    }
+}
+
+float TerrainNoiseReference::FbmNoiseWithFD(const TerrainNoise::PerlinSettings& perlin, int octaves, float lac, float gain, float kAtten,
+    float x0, float z0)
+{
+    FastNoiseLite noise = MakeReferenceNoise(perlin);
+
+    // 1. Theoretical amplitude sum (no attenuation) for normalization
+    float sumAmp = 0.0f;
+    {
+        float ampTmp = 1.0f;
+        for (int i = 0; i < octaves; i++) {
+            sumAmp += ampTmp;
+            ampTmp *= gain;
+        }
+    }
+
+    float sum = 0.5f;
+    float amplitude = 1.0f;
+    float freq = 1.0f;
+
+    XMFLOAT2 dsum = XMFLOAT2(0, 0);
+
+    // Running derivative of height so far (in base coordinate space)
+    float derivX = 0.0f;
+    float derivZ = 0.0f;
+
+    for (int i = 0; i < octaves; i++) {
+        float x = x0 * freq;
+        float z = z0 * freq;
+
+        // Sample noise
+        float n = noise.GetNoise(x, z); // [-1,1]
+
+        // Derivative of this octave's noise (in base coords)
+        float dx_n = 0.0f, dz_n = 0.0f;
+        if (kAtten > 0.0f) {
+            NoiseGradient::PerlinWithGradient(perlin.seed, perlin.frequency, x, z, dx_n, dz_n);
+            dx_n *= freq;
+            dz_n *= freq;
+        }
+
+        dsum = XMFLOAT2(dsum.x + dx_n, dsum.y + dz_n);
+        float dot = dsum.x * dsum.x + dsum.y * dsum.y;
+
+        sum += amplitude * n / (1 + dot);
+
+        // Update running derivative sum
+        if (kAtten > 0.0f) {
+            derivX += dx_n * amplitude;
+            derivZ += dz_n * amplitude;
+            // Compute slope of accumulated height so far
+            float slopeAccum = std::sqrt(derivX * derivX + derivZ * derivZ);
+            // Attenuate next octave's amplitude
+            float attenuation = std::exp(-kAtten * slopeAccum);
+            amplitude *= gain * attenuation;
+        }
+        else {
+            // No attenuation
+            amplitude *= gain;
+        }
+
+        freq *= lac;
+    }
+
+    // Normalize to [-1,1]
+    return sum / sumAmp;
+}
+
+float TerrainNoiseReference::UberNoise(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params, float x0, float z0)
+{
+    FastNoiseLite noise = MakeReferenceNoise(perlin);
+
+    const int   octaves = params.octaves;
+    const float perturbAmt = params.perturbAmt;
+    const float sharpness = params.sharpness;
+    const float amplify = params.amplify;
+    const float altitudeErode = params.altitudeErode;
+    const float ridgeErode = params.ridgeErode;
+    const float slopeErode = params.slopeErode;
+    const float lacunarity = params.lacunarity;
+    const float gain = params.gain;
+    const float kAtten = params.kAtten; // FDG's slope attenuation
+
+    // 1. Theoretical amplitude sum (no attenuation) for normalization
+    float sumAmp = 0.0f;
+    {
+        float ampTmp = 1.0f;
+        for (int i = 0; i < octaves; i++) {
+            sumAmp += ampTmp;
+            ampTmp *= gain;
+        }
+    }
+
+    const float billowT = std::max(0.0f, sharpness);
+    const float ridgedT = std::abs(std::min(0.0f, sharpness));
+
+    float x = x0;
+    float z = z0;
+
+    float sum = 0.5f;
+    float amplitude = 1.0f;
+    float freq = 1.0f;
+    float dampedAmplitude = 0.0f;
+    float currentGain = gain;
+
+    XMFLOAT2 slopeErosionDerSum = XMFLOAT2(0, 0);
+    XMFLOAT2 ridgeErosionDerSum = XMFLOAT2(0, 0);
+    XMFLOAT2 perturbDerSum = XMFLOAT2(0, 0);
+
+    for (int i = 0; i < octaves; i++) {
+
+        // Sample noise
+        const float raw = noise.GetNoise(x, z); // [-1,1]
+        float rawDx, rawDz;
+        NoiseGradient::PerlinWithGradient(perlin.seed, perlin.frequency, x, z, rawDx, rawDz);
+
+        float ridgedNoise = 1.0f - std::abs(raw);
+        float billowNoise = raw * raw;
+
+        // The derivative follows the shaping: d(n^2) = 2n, d(1 - |n|) = -sign(n)
+        float n = std::lerp(raw, billowNoise, billowT);
+        float dnX = rawDx, dnZ = rawDz;
+        if (billowT != 0.0f) {
+            const float shapeDer = 1.0f + billowT * (2.0f * raw - 1.0f);
+            dnX = rawDx * shapeDer;
+            dnZ = rawDz * shapeDer;
+        }
+
+        n = std::lerp(n, ridgedNoise, ridgedT);
+        if (ridgedT != 0.0f) {
+            const float ridgedDer = raw < 0.0f ? 1.0f : -1.0f;
+            dnX = dnX + ridgedT * (rawDx * ridgedDer - dnX);
+            dnZ = dnZ + ridgedT * (rawDz * ridgedDer - dnZ);
+        }
+
+        // Derivative of this octave's noise (in base coords)
+        float dx_n = 0.0f, dz_n = 0.0f;
+        if (kAtten > 0.0f) {
+            dx_n = dnX * freq;
+            dz_n = dnZ * freq;
+        }
+
+        slopeErosionDerSum = XMFLOAT2((slopeErosionDerSum.x + dx_n) * slopeErode, (slopeErosionDerSum.y + dz_n) * slopeErode);
+        float dot = slopeErosionDerSum.x * slopeErosionDerSum.x + slopeErosionDerSum.y * slopeErosionDerSum.y;
+
+        sum += amplitude * n * (1.0f / (1.0f + dot));
+
+        sum += dampedAmplitude * n * (1.0f / (1.0f + dot));
+
+        amplitude *= std::lerp(currentGain, currentGain * smoothstep(0.0f, 1.0f, sum), altitudeErode);
+
+        ridgeErosionDerSum = XMFLOAT2((ridgeErosionDerSum.x + dx_n) * ridgeErode, (ridgeErosionDerSum.y + dz_n) * ridgeErode);
+        float dotRidge = ridgeErosionDerSum.x * ridgeErosionDerSum.x + ridgeErosionDerSum.y * ridgeErosionDerSum.y;
+        dampedAmplitude = amplitude * (1.0f - (ridgeErode / (1.0f + dotRidge)));
+
+        x = (x0 * freq) + perturbDerSum.x;
+        z = (z0 * freq) + perturbDerSum.y;
+        perturbDerSum = XMFLOAT2((perturbDerSum.x + dx_n) * perturbAmt, (perturbDerSum.y + dz_n) * perturbAmt);
+
+        currentGain = gain + amplify;
+        freq *= lacunarity;
+    }
+
+    // Normalize to [-1,1]
+    return sum / sumAmp;
+}
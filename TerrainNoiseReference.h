@@ -0,0 +1,16 @@
+#pragma once
+
+#include "TerrainNoise.h"
+
+// Scalar reference for the TerrainNoise batch kernels of the same name, written independently of
+// them: the noise value comes from FastNoiseLite itself, the octave loop is plain float code with
+// std::lerp and std::exp. Only the per-octave gradient is shared (NoiseGradient::PerlinWithGradient,
+// which is checked against finite differences on its own). One sample per call; slow, for tests.
+namespace TerrainNoiseReference
+{
+    // Evaluates params.octaves octaves (the multi-rate fields are ignored)
+    float UberNoise(const TerrainNoise::PerlinSettings& perlin, const UberNoiseParams& params, float x0, float z0);
+
+    float FbmNoiseWithFD(const TerrainNoise::PerlinSettings& perlin, int octaves, float lac, float gain, float kAtten,
+        float x0, float z0);
+}
@@ -0,0 +1,217 @@
+#define NOMINMAX
+
+#include "TerrainPatchTree.h"
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    // Spread the low 16 bits of v to the even bits of the result
+    uint32_t Part1By1(uint32_t v) {
+        v &= 0x0000ffff;
+        v = (v | (v << 8)) & 0x00ff00ff;
+        v = (v | (v << 4)) & 0x0f0f0f0f;
+        v = (v | (v << 2)) & 0x33333333;
+        v = (v | (v << 1)) & 0x55555555;
+        return v;
+    }
+
+    // Inverse of Part1By1: gather the even bits of v
+    uint32_t Compact1By1(uint32_t v) {
+        v &= 0x55555555;
+        v = (v | (v >> 1)) & 0x33333333;
+        v = (v | (v >> 2)) & 0x0f0f0f0f;
+        v = (v | (v >> 4)) & 0x00ff00ff;
+        v = (v | (v >> 8)) & 0x0000ffff;
+        return v;
+    }
+
+    uint32_t MortonEncode(uint32_t x, uint32_t z) {
+        return Part1By1(x) | (Part1By1(z) << 1);
+    }
+
+    // Index of the first node of a quadtree level when levels are stored root first
+    size_t LevelOffset(int level) {
+        return ((size_t(1) << (2 * level)) - 1) / 3;
+    }
+
+    enum class Containment { Outside, Intersects, Inside };
+
+    // Same plane convention as Tutorial2::IsBoxInsideFrustum (inside is the positive side)
+    Containment ClassifyBox(const XMFLOAT3& bmin, const XMFLOAT3& bmax, const std::array<XMFLOAT4, 6>& planes) {
+        Containment result = Containment::Inside;
+        for (const XMFLOAT4& P : planes) {
+            // Corner furthest along the plane normal, and the one furthest against it
+            float px = P.x >= 0 ? bmax.x : bmin.x;
+            float py = P.y >= 0 ? bmax.y : bmin.y;
+            float pz = P.z >= 0 ? bmax.z : bmin.z;
+            if (P.x * px + P.y * py + P.z * pz + P.w < 0)
+                return Containment::Outside;
+
+            float nx = P.x >= 0 ? bmin.x : bmax.x;
+            float ny = P.y >= 0 ? bmin.y : bmax.y;
+            float nz = P.z >= 0 ? bmin.z : bmax.z;
+            if (P.x * nx + P.y * ny + P.z * nz + P.w < 0)
+                result = Containment::Intersects;
+        }
+        return result;
+    }
+}
+
+const std::vector<std::pair<uint16_t, uint16_t>>& TerrainPatchTree::GetPatchOrder(int patchesPerSide) {
+    // Layouts are never dropped from the cache, so the order outlives this shared_ptr
+    return GetLayout(patchesPerSide)->order;
+}
+
+std::shared_ptr<const TerrainPatchTree::Layout> TerrainPatchTree::GetLayout(int patchesPerSide) {
+    // Chunks generate on worker threads, so the first one to get here builds it for everyone.
+    // One layout per LOD tier.
+    static std::mutex s_mutex;
+    static std::unordered_map<int, std::shared_ptr<const Layout>> s_layouts;
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    std::shared_ptr<const Layout>& cached = s_layouts[patchesPerSide];
+    if (cached)
+        return cached;
+
+    auto layout = std::make_shared<Layout>();
+    layout->patchesPerSide = patchesPerSide;
+    layout->gridSize = 1;
+    while (layout->gridSize < patchesPerSide)
+        layout->gridSize *= 2;
+    layout->levelCount = 1;
+    for (int size = layout->gridSize; size > LeafSize; size /= 2)
+        ++layout->levelCount;
+
+    // Walk the power-of-two grid in Morton order and keep the patches that exist. firstPatch[c]
+    // is how many real patches come before Morton code c.
+    const uint32_t codeCount = uint32_t(layout->gridSize) * uint32_t(layout->gridSize);
+    std::vector<UINT> firstPatch(codeCount + 1);
+    layout->order.reserve(size_t(patchesPerSide) * patchesPerSide);
+    for (uint32_t code = 0; code < codeCount; ++code) {
+        firstPatch[code] = UINT(layout->order.size());
+        uint32_t x = Compact1By1(code);
+        uint32_t z = Compact1By1(code >> 1);
+        if (int(x) < patchesPerSide && int(z) < patchesPerSide)
+            layout->order.emplace_back(uint16_t(x), uint16_t(z));
+    }
+    firstPatch[codeCount] = UINT(layout->order.size());
+
+    // A node of side S at Morton index m covers codes [m * S^2, (m + 1) * S^2)
+    size_t nodeCount = LevelOffset(layout->levelCount);
+    layout->nodeFirstPatch.reserve(nodeCount);
+    layout->nodePatchCount.reserve(nodeCount);
+    for (int level = 0; level < layout->levelCount; ++level) {
+        uint32_t nodesInLevel = 1u << (2 * level);
+        uint32_t size = uint32_t(layout->gridSize >> level);
+        uint32_t codesPerNode = size * size;
+        for (uint32_t m = 0; m < nodesInLevel; ++m) {
+            UINT first = firstPatch[m * codesPerNode];
+            UINT last = firstPatch[(m + 1) * codesPerNode];
+            layout->nodeFirstPatch.push_back(first);
+            layout->nodePatchCount.push_back(last - first);
+        }
+    }
+
+    cached = layout;
+    return cached;
+}
+
+void TerrainPatchTree::Build(int patchesPerSide, const std::vector<XMFLOAT2>& patchHeights) {
+    assert(patchHeights.size() == size_t(patchesPerSide) * patchesPerSide);
+    m_layout = GetLayout(patchesPerSide);
+
+    const Layout& layout = *m_layout;
+    const int leafLevel = layout.levelCount - 1;
+    const int leafSize = layout.gridSize >> leafLevel;
+
+    // Empty nodes (past the edge of a non-power-of-two grid) keep an inverted range
+    m_nodeHeights.assign(layout.nodeFirstPatch.size(), XMFLOAT2(FLT_MAX, -FLT_MAX));
+
+    const size_t leafOffset = LevelOffset(leafLevel);
+    for (const auto& [x, z] : layout.order) {
+        const XMFLOAT2& patch = patchHeights[size_t(z) * patchesPerSide + x];
+        XMFLOAT2& leaf = m_nodeHeights[leafOffset + MortonEncode(x / leafSize, z / leafSize)];
+        leaf.x = std::min(leaf.x, patch.x);
+        leaf.y = std::max(leaf.y, patch.y);
+    }
+
+    for (int level = leafLevel - 1; level >= 0; --level) {
+        const size_t offset = LevelOffset(level);
+        const size_t childOffset = LevelOffset(level + 1);
+        const size_t nodesInLevel = size_t(1) << (2 * level);
+        for (size_t m = 0; m < nodesInLevel; ++m) {
+            XMFLOAT2& node = m_nodeHeights[offset + m];
+            for (size_t c = 0; c < 4; ++c) {
+                const XMFLOAT2& child = m_nodeHeights[childOffset + m * 4 + c];
+                node.x = std::min(node.x, child.x);
+                node.y = std::max(node.y, child.y);
+            }
+        }
+    }
+}
+
+void TerrainPatchTree::Cull(const std::array<XMFLOAT4, 6>& planes, float originX, float originZ, int patchSize, int stitchReach,
+    std::vector<IndexRange>& outRanges) const {
+    outRanges.clear();
+    if (!m_layout)
+        return;
+
+    const Layout& layout = *m_layout;
+    const int leafLevel = layout.levelCount - 1;
+
+    // Depth-first with children pushed in reverse, so nodes are emitted in index order and
+    // neighbouring visible nodes merge into one range. At most 3 siblings wait per level.
+    struct Node { int level; uint32_t morton; };
+    std::array<Node, 64> stack;
+    int top = 0;
+    stack[top++] = { 0, 0 };
+
+    while (top > 0) {
+        const Node node = stack[--top];
+        const size_t nodeIndex = LevelOffset(node.level) + node.morton;
+        const UINT patchCount = layout.nodePatchCount[nodeIndex];
+        if (patchCount == 0)
+            continue;
+
+        const int size = layout.gridSize >> node.level;
+        const int x0 = int(Compact1By1(node.morton)) * size;
+        const int z0 = int(Compact1By1(node.morton >> 1)) * size;
+        const int x1 = std::min(x0 + size, layout.patchesPerSide);
+        const int z1 = std::min(z0 + size, layout.patchesPerSide);
+        const XMFLOAT2& heights = m_nodeHeights[nodeIndex];
+
+        int bx0 = x0, bx1 = x1, bz0 = z0, bz1 = z1;
+        if (z0 == 0 || z1 == layout.patchesPerSide) {
+            bx0 = std::max(bx0 - stitchReach, 0);
+            bx1 = std::min(bx1 + stitchReach, layout.patchesPerSide);
+        }
+        if (x0 == 0 || x1 == layout.patchesPerSide) {
+            bz0 = std::max(bz0 - stitchReach, 0);
+            bz1 = std::min(bz1 + stitchReach, layout.patchesPerSide);
+        }
+
+        XMFLOAT3 bmin(originX + float(bx0 * patchSize), heights.x, originZ + float(bz0 * patchSize));
+        XMFLOAT3 bmax(originX + float(bx1 * patchSize), heights.y, originZ + float(bz1 * patchSize));
+
+        Containment containment = ClassifyBox(bmin, bmax, planes);
+        if (containment == Containment::Outside)
+            continue;
+
+        if (containment == Containment::Inside || node.level == leafLevel) {
+            const UINT startIndex = layout.nodeFirstPatch[nodeIndex] * 4;
+            const UINT indexCount = patchCount * 4;
+            if (!outRanges.empty() && outRanges.back().startIndex + outRanges.back().indexCount == startIndex)
+                outRanges.back().indexCount += indexCount;
+            else
+                outRanges.push_back({ startIndex, indexCount });
+            continue;
+        }
+
+        assert(top + 4 <= int(stack.size()));
+        for (int c = 3; c >= 0; --c)
+            stack[top++] = { node.level + 1, node.morton * 4 + uint32_t(c) };
+    }
+}
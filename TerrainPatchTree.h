@@ -0,0 +1,51 @@
+#pragma once
+
+#include "DX12Renderer/Mesh.h"
+#include <DirectXMath.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace DirectX;
+
+// Min/max height quadtree over the patches of one terrain chunk (TerrainChunk::CullPatches).
+// Patch indices are laid out in Morton (Z) order, so every node of the tree covers one
+// contiguous run of the index buffer and culling comes out as a few index ranges.
+//
+// CPU only: no GPU state, so the culling can be checked without a device.
+class TerrainPatchTree {
+public:
+    static constexpr int LeafSize = 8; // Patches per side of a leaf
+
+    // (x, z) of every patch in draw order. The same for every chunk with that many patches per
+    // side; built once and kept for the life of the program.
+    static const std::vector<std::pair<uint16_t, uint16_t>>& GetPatchOrder(int patchesPerSide);
+
+    // patchHeights holds the (min, max) world height of every patch, row major
+    void Build(int patchesPerSide, const std::vector<XMFLOAT2>& patchHeights);
+
+    // Writes the index ranges (4 indices per patch) of the patches that intersect the frustum,
+    // merging neighbours. (originX, originZ) is the world position of the chunk's first patch
+    // corner; patches are patchSize apart. A patch's footprint grows by stitchReach patches along
+    // a border it stitches. Does not allocate once outRanges has the capacity.
+    void Cull(const std::array<XMFLOAT4, 6>& planes, float originX, float originZ, int patchSize, int stitchReach,
+        std::vector<IndexRange>& outRanges) const;
+
+private:
+    // Patch draw order and the patch range of every node
+    struct Layout {
+        int patchesPerSide = 0;
+        int gridSize = 0;   // patchesPerSide rounded up to a power of two
+        int levelCount = 0; // Root (level 0) down to leaves of LeafSize patches
+        std::vector<std::pair<uint16_t, uint16_t>> order;
+        // Per node: levels stored root first, nodes in Morton order within a level
+        std::vector<UINT> nodeFirstPatch;
+        std::vector<UINT> nodePatchCount;
+    };
+    static std::shared_ptr<const Layout> GetLayout(int patchesPerSide);
+
+    std::shared_ptr<const Layout> m_layout;
+    std::vector<XMFLOAT2> m_nodeHeights; // (min, max) per node, laid out like Layout
+};
@@ -0,0 +1,195 @@
+#include "TestHelpers.h"
+#include "../DX12Renderer/RenderGraph.h"
+#include "../DX12Renderer/CommandQueue.h"
+
+#include <cstdlib>
+
+// The tests only compile graphs and never execute one, so the queue Execute asks for its state
+// trackers is never there; this keeps the device and the rest of the queue out of the link
+ResourceStateTracker& CommandQueue::GetResourceStateTracker(ID3D12GraphicsCommandList2*) {
+    std::abort();
+}
+
+namespace {
+    using Barrier = RenderGraph::Barrier;
+
+    constexpr uint64_t MB = 1024 * 1024;
+
+    D3D12_RESOURCE_DESC TargetDesc() {
+        D3D12_RESOURCE_DESC desc = {};
+        desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+        desc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+        return desc;
+    }
+
+    RenderGraph::ResourceHandle AddTransient(RenderGraph& graph, const char* name, uint64_t size) {
+        return graph.CreateTransient(name, TargetDesc(), {}, { size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT });
+    }
+
+    RenderGraph::PassHandle AddPass(RenderGraph& graph, const char* name) {
+        return graph.AddPass(name, [](Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2>&) {});
+    }
+
+    bool IsTransition(const Barrier& barrier, RenderGraph::ResourceHandle resource, bool stateBeforeKnown,
+        D3D12_RESOURCE_STATES stateBefore, D3D12_RESOURCE_STATES stateAfter) {
+        return barrier.type == Barrier::Type::Transition && barrier.resource == resource &&
+            barrier.stateBeforeKnown == stateBeforeKnown && (!stateBeforeKnown || barrier.stateBefore == stateBefore) &&
+            barrier.stateAfter == stateAfter;
+    }
+
+    bool IsAliasing(const Barrier& barrier, RenderGraph::ResourceHandle resource, RenderGraph::ResourceHandle resourceBefore) {
+        return barrier.type == Barrier::Type::Aliasing && barrier.resource == resource && barrier.resourceBefore == resourceBefore;
+    }
+
+    // Passes are kept for what the outputs need, through reads; a pass that only writes a
+    // resource ends the need for the passes before it
+    void TestCulling() {
+        RenderGraph graph;
+        const auto backBuffer = graph.ImportResource("back buffer");
+        const auto shadowMap = AddTransient(graph, "shadow map", 4 * MB);
+        const auto unused = AddTransient(graph, "unused", 4 * MB);
+        const auto feedsUnused = AddTransient(graph, "feeds unused", 4 * MB);
+        graph.MarkOutput(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+
+        const auto overwritten = AddPass(graph, "overwritten");
+        graph.Write(overwritten, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        const auto shadow = AddPass(graph, "shadow");
+        graph.Write(shadow, shadowMap, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+        const auto feeder = AddPass(graph, "feeder");
+        graph.Write(feeder, feedsUnused, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        const auto dead = AddPass(graph, "dead");
+        graph.Read(dead, feedsUnused, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        graph.Read(dead, shadowMap, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        graph.Write(dead, unused, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        const auto clear = AddPass(graph, "clear");
+        graph.Write(clear, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        const auto lighting = AddPass(graph, "lighting");
+        graph.Read(lighting, shadowMap, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+        graph.Read(lighting, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        graph.Write(lighting, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        graph.Compile();
+
+        CHECK(graph.IsPassCulled(overwritten));
+        CHECK(!graph.IsPassCulled(shadow));
+        CHECK(graph.IsPassCulled(feeder));
+        CHECK(graph.IsPassCulled(dead));
+        CHECK(!graph.IsPassCulled(clear));
+        CHECK(!graph.IsPassCulled(lighting));
+
+        // Only what the kept passes use gets memory, and culled passes get no barriers
+        CHECK(graph.GetHeapSize() == 4 * MB);
+        CHECK(graph.GetPassBarriers(overwritten).empty());
+        CHECK(graph.GetPassBarriers(dead).empty());
+    }
+
+    // Transients that are alive at the same time never share memory; the others do, and take it
+    // over with an aliasing barrier before their first use
+    void TestPlacement() {
+        RenderGraph graph;
+        const auto backBuffer = graph.ImportResource("back buffer");
+        const auto a = AddTransient(graph, "a", 8 * MB);   // Passes 0 and 1
+        const auto b = AddTransient(graph, "b", 4 * MB);   // Passes 2 and 3
+        const auto c = AddTransient(graph, "c", 4 * MB);   // Passes 1 and 2
+        graph.MarkOutput(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+
+        const RenderGraph::ResourceHandle written[] = { a, c, b, RenderGraph::InvalidHandle };
+        const RenderGraph::ResourceHandle read[] = { RenderGraph::InvalidHandle, a, c, b };
+        RenderGraph::PassHandle passes[4];
+        for (int i = 0; i < 4; ++i) {
+            passes[i] = AddPass(graph, "pass");
+            if (written[i] != RenderGraph::InvalidHandle)
+                graph.Write(passes[i], written[i], D3D12_RESOURCE_STATE_RENDER_TARGET);
+            if (read[i] != RenderGraph::InvalidHandle)
+                graph.Read(passes[i], read[i], D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+            graph.Read(passes[i], backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+            graph.Write(passes[i], backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        }
+
+        graph.Compile();
+
+        for (RenderGraph::PassHandle pass : passes)
+            CHECK(!graph.IsPassCulled(pass));
+
+        auto overlaps = [&graph](RenderGraph::ResourceHandle x, uint64_t xSize, RenderGraph::ResourceHandle y, uint64_t ySize) {
+            return graph.GetHeapOffset(x) < graph.GetHeapOffset(y) + ySize && graph.GetHeapOffset(y) < graph.GetHeapOffset(x) + xSize;
+        };
+        CHECK(!overlaps(a, 8 * MB, c, 4 * MB));
+        CHECK(!overlaps(b, 4 * MB, c, 4 * MB));
+        CHECK(overlaps(a, 8 * MB, b, 4 * MB));
+        CHECK(graph.GetHeapSize() == 12 * MB);
+        for (auto transient : { a, b, c })
+            CHECK(graph.GetHeapOffset(transient) % D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT == 0);
+
+        // a and b hand their memory to each other every frame; c keeps its own
+        const std::vector<Barrier>& first = graph.GetPassBarriers(passes[0]);
+        const std::vector<Barrier>& third = graph.GetPassBarriers(passes[2]);
+        CHECK(!first.empty() && IsAliasing(first[0], a, b));
+        CHECK(!third.empty() && IsAliasing(third[0], b, a));
+        for (RenderGraph::PassHandle pass : passes) {
+            for (const Barrier& barrier : graph.GetPassBarriers(pass))
+                CHECK(barrier.type != Barrier::Type::Aliasing || barrier.resource != c);
+        }
+    }
+
+    // Transients start in the state they end the frame in; the first transition of an imported
+    // resource comes from whatever the state tracker knows, and outputs end in their final state
+    void TestBarriers() {
+        RenderGraph graph;
+        const auto backBuffer = graph.ImportResource("back buffer");
+        const auto shadowMap = AddTransient(graph, "shadow map", 4 * MB);
+        graph.MarkOutput(backBuffer, D3D12_RESOURCE_STATE_PRESENT);
+
+        const auto shadow = AddPass(graph, "shadow");
+        graph.Write(shadow, shadowMap, D3D12_RESOURCE_STATE_DEPTH_WRITE);
+
+        const auto sky = AddPass(graph, "sky");
+        graph.Write(sky, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+
+        const auto terrain = AddPass(graph, "terrain");
+        graph.Read(terrain, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        graph.Write(terrain, backBuffer, D3D12_RESOURCE_STATE_RENDER_TARGET);
+        graph.Read(terrain, shadowMap, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+        graph.Compile();
+
+        CHECK(graph.GetInitialState(shadowMap) == D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+        const std::vector<Barrier>& shadowBarriers = graph.GetPassBarriers(shadow);
+        CHECK(shadowBarriers.size() == 1);
+        CHECK(!shadowBarriers.empty() && IsTransition(shadowBarriers[0], shadowMap, true,
+            D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_DEPTH_WRITE));
+
+        const std::vector<Barrier>& skyBarriers = graph.GetPassBarriers(sky);
+        CHECK(skyBarriers.size() == 1);
+        CHECK(!skyBarriers.empty() && IsTransition(skyBarriers[0], backBuffer, false,
+            D3D12_RESOURCE_STATE_COMMON, D3D12_RESOURCE_STATE_RENDER_TARGET));
+
+        // Already a render target, so only the shadow map moves
+        const std::vector<Barrier>& terrainBarriers = graph.GetPassBarriers(terrain);
+        CHECK(terrainBarriers.size() == 1);
+        CHECK(!terrainBarriers.empty() && IsTransition(terrainBarriers[0], shadowMap, true,
+            D3D12_RESOURCE_STATE_DEPTH_WRITE, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE));
+
+        const std::vector<Barrier>& finalBarriers = graph.GetFinalBarriers();
+        CHECK(finalBarriers.size() == 1);
+        CHECK(!finalBarriers.empty() && IsTransition(finalBarriers[0], backBuffer, true,
+            D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PRESENT));
+
+        // Compiling again gives the same barriers, not a second set
+        graph.Compile();
+        CHECK(graph.GetPassBarriers(shadow).size() == 1);
+        CHECK(graph.GetFinalBarriers().size() == 1);
+    }
+}
+
+void RunRenderGraphTests() {
+    TestCulling();
+    TestPlacement();
+    TestBarriers();
+}
@@ -0,0 +1,140 @@
+#include "TestHelpers.h"
+#include "StubCommandList.h"
+#include "../DX12Renderer/ResourceBarrierBatch.h"
+
+namespace {
+    constexpr D3D12_RESOURCE_STATES StateA = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    constexpr D3D12_RESOURCE_STATES StateB = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    constexpr D3D12_RESOURCE_STATES StateC = D3D12_RESOURCE_STATE_DEPTH_WRITE;
+
+    // The batch only compares resource pointers, so they need not point at real resources
+    ID3D12Resource* FakeResource(int index) {
+        static char storage[8];
+        return reinterpret_cast<ID3D12Resource*>(&storage[index]);
+    }
+
+    bool IsTransition(const D3D12_RESOURCE_BARRIER& barrier, ID3D12Resource* resource, D3D12_RESOURCE_STATES stateBefore,
+        D3D12_RESOURCE_STATES stateAfter, UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES) {
+        return barrier.Type == D3D12_RESOURCE_BARRIER_TYPE_TRANSITION && barrier.Transition.pResource == resource &&
+            barrier.Transition.StateBefore == stateBefore && barrier.Transition.StateAfter == stateAfter &&
+            barrier.Transition.Subresource == subresource;
+    }
+
+    // A -> B then B -> C reaches the list as A -> C
+    void TestFold() {
+        ResourceBarrierBatch batch;
+        StubCommandList commandList;
+        ID3D12Resource* resource = FakeResource(0);
+
+        batch.Transition(resource, StateA, StateB);
+        batch.Transition(resource, StateB, StateC);
+        batch.Flush(&commandList);
+
+        CHECK(commandList.barrierCalls.size() == 1);
+        CHECK(commandList.GetBarrierCount() == 1);
+        CHECK(commandList.GetBarrierCount() == 1 && IsTransition(commandList.barrierCalls[0][0], resource, StateA, StateC));
+    }
+
+    // A -> B then B -> A cancels out, and a transition to the same state is dropped
+    void TestRoundTrip() {
+        ResourceBarrierBatch batch;
+        StubCommandList commandList;
+        ID3D12Resource* resource = FakeResource(0);
+
+        batch.Transition(resource, StateA, StateB);
+        batch.Transition(resource, StateB, StateA);
+        batch.Transition(FakeResource(1), StateC, StateC);
+        CHECK(batch.IsEmpty());
+
+        batch.Flush(&commandList);
+        CHECK(commandList.barrierCalls.empty());
+    }
+
+    // A transition of another subresource, or an aliasing barrier involving the resource, sits
+    // between the two transitions, so they are recorded as queued
+    void TestFoldBreaks() {
+        ID3D12Resource* resource = FakeResource(0);
+        ID3D12Resource* other = FakeResource(1);
+
+        {
+            ResourceBarrierBatch batch;
+            StubCommandList commandList;
+            batch.Transition(resource, StateA, StateB, 0);
+            batch.Transition(resource, StateB, StateC);
+            batch.Flush(&commandList);
+
+            CHECK(commandList.barrierCalls.size() == 1);
+            CHECK(commandList.GetBarrierCount() == 2);
+            if (commandList.GetBarrierCount() == 2) {
+                CHECK(IsTransition(commandList.barrierCalls[0][0], resource, StateA, StateB, 0));
+                CHECK(IsTransition(commandList.barrierCalls[0][1], resource, StateB, StateC));
+            }
+        }
+        {
+            ResourceBarrierBatch batch;
+            StubCommandList commandList;
+            batch.Transition(resource, StateA, StateB);
+            batch.Aliasing(other, resource);
+            batch.Transition(resource, StateB, StateC);
+            batch.Flush(&commandList);
+
+            CHECK(commandList.GetBarrierCount() == 3);
+            if (commandList.GetBarrierCount() == 3) {
+                const std::vector<D3D12_RESOURCE_BARRIER>& barriers = commandList.barrierCalls[0];
+                CHECK(IsTransition(barriers[0], resource, StateA, StateB));
+                CHECK(barriers[1].Type == D3D12_RESOURCE_BARRIER_TYPE_ALIASING &&
+                    barriers[1].Aliasing.pResourceBefore == other && barriers[1].Aliasing.pResourceAfter == resource);
+                CHECK(IsTransition(barriers[2], resource, StateB, StateC));
+            }
+        }
+
+        // Aliasing between other resources leaves the fold alone
+        {
+            ResourceBarrierBatch batch;
+            StubCommandList commandList;
+            batch.Transition(resource, StateA, StateB);
+            batch.Aliasing(other, FakeResource(2));
+            batch.Transition(resource, StateB, StateC);
+            batch.Flush(&commandList);
+
+            CHECK(commandList.GetBarrierCount() == 2);
+            CHECK(commandList.GetBarrierCount() == 2 && IsTransition(commandList.barrierCalls[0][0], resource, StateA, StateC));
+        }
+    }
+
+    // One ResourceBarrier call per Flush with anything pending, none without, and the stats of a
+    // frame's worth of them
+    void TestOneCallPerFlush() {
+        ResourceBarrierBatch batch;
+        StubCommandList commandList;
+
+        for (int i = 0; i < 4; ++i)
+            batch.Transition(FakeResource(i), StateA, StateB);
+        batch.Flush(&commandList);
+        batch.Flush(&commandList);
+        CHECK(commandList.barrierCalls.size() == 1);
+        CHECK(commandList.GetBarrierCount() == 4);
+
+        // The next pass takes two of them back and the other two on
+        for (int i = 0; i < 4; ++i)
+            batch.Transition(FakeResource(i), StateB, i < 2 ? StateA : StateC);
+        batch.Flush(&commandList);
+        CHECK(commandList.barrierCalls.size() == 2);
+        CHECK(commandList.GetBarrierCount() == 8);
+
+        const ResourceBarrierBatch::Stats stats = batch.TakeStats();
+        CHECK(stats.requested == 8);
+        CHECK(stats.submitted == 8);
+        CHECK(stats.calls == 2);
+
+        // Taking them starts over
+        CHECK(batch.TakeStats().requested == 0);
+    }
+}
+
+void RunResourceBarrierBatchTests() {
+    TestFold();
+    TestRoundTrip();
+    TestFoldBreaks();
+    TestOneCallPerFlush();
+}
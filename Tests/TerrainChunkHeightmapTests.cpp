@@ -0,0 +1,65 @@
+#include "TestHelpers.h"
+#include "../TerrainChunkHeightmap.h"
+#include "../DX12Renderer/ThreadPool.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Generates the grid on this thread alone, then through pools of several sizes, which have to
+    // give the same bits
+    void CheckSameOnEveryPool(const UberNoiseParams& params, const TerrainChunkHeightmap::Grid& grid) {
+        const TerrainNoise::PerlinSettings perlin = { 1337, grid.noiseScale };
+        const size_t sampleCount = size_t(grid.vertsPerSide) * grid.vertsPerSide;
+
+        std::vector<float> serial(sampleCount);
+        TerrainChunkHeightmap::Generate(perlin, params, grid, serial.data(), nullptr);
+
+        const unsigned threadCounts[] = { 1, 2, 3, std::max(std::thread::hardware_concurrency(), 1u) };
+        for (unsigned threadCount : threadCounts) {
+            ThreadPool pool(threadCount);
+            std::vector<float> threaded(sampleCount, -1.0f);
+            TerrainChunkHeightmap::Generate(perlin, params, grid, threaded.data(), &pool);
+            CHECK(std::memcmp(serial.data(), threaded.data(), sampleCount * sizeof(float)) == 0);
+        }
+    }
+
+    void TestEveryOctavePerSample() {
+        TerrainChunkHeightmap::Grid grid;
+        grid.chunkX = 3;
+        grid.chunkZ = -2;
+        CheckSameOnEveryPool(UberNoiseParams(), grid);
+    }
+
+    void TestMultiRate() {
+        UberNoiseParams params;
+        params.coarseOctaves = 4;
+        params.coarseStride = 4;
+
+        TerrainChunkHeightmap::Grid grid;
+        grid.chunkX = -1;
+        grid.chunkZ = 5;
+        grid.multiRate = true;
+        CheckSameOnEveryPool(params, grid);
+    }
+
+    // The 86x86 tier: fewer octaves, and rows that are not a whole number of SIMD blocks
+    void TestCoarserTier() {
+        TerrainChunkHeightmap::Grid grid;
+        grid.chunkX = 7;
+        grid.chunkZ = 0;
+        grid.vertsPerSide = 86;
+        grid.patchSize = 12;
+        grid.octaves = 5;
+        CheckSameOnEveryPool(UberNoiseParams(), grid);
+    }
+}
+
+void RunTerrainChunkHeightmapTests() {
+    TestEveryOctavePerSample();
+    TestMultiRate();
+    TestCoarserTier();
+}
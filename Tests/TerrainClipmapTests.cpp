@@ -0,0 +1,144 @@
+#include "TestHelpers.h"
+#include "../TerrainClipmap.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+    constexpr int LevelCount = 3;
+    constexpr int TextureSize = 64;
+    constexpr float BaseSpacing = 1.0f;
+
+    // Every stored sample of every level matches a clipmap generated from scratch at the camera
+    bool MatchesFreshClipmap(const TerrainClipmap& clipmap, float cameraX, float cameraZ) {
+        TerrainClipmap fresh(LevelCount, TextureSize, BaseSpacing);
+        fresh.Update(cameraX, cameraZ);
+
+        for (int l = 0; l < LevelCount; ++l) {
+            const TerrainClipmap::Level& level = clipmap.GetLevel(l);
+            if (level.gridX != fresh.GetLevel(l).gridX || level.gridZ != fresh.GetLevel(l).gridZ)
+                return false;
+            for (int z = level.gridZ - 1; z < level.gridZ - 1 + TextureSize; ++z) {
+                for (int x = level.gridX - 1; x < level.gridX - 1 + TextureSize; ++x) {
+                    if (clipmap.GetHeight(l, x, z) != fresh.GetHeight(l, x, z))
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Level 0 snaps to two quads, so moving the camera by 2 * BaseSpacing moves it one step; the
+    // coarser levels move with it only every 2^l steps
+    void TestToroidalUpdate() {
+        TerrainClipmap clipmap(LevelCount, TextureSize, BaseSpacing);
+        CHECK(clipmap.Update(0.0f, 0.0f) == size_t(LevelCount) * TextureSize * TextureSize);
+        for (int l = 0; l < LevelCount; ++l)
+            CHECK(clipmap.GetLevel(l).valid && clipmap.GetLevel(l).dirty);
+
+        // Standing still generates nothing
+        for (int l = 0; l < LevelCount; ++l)
+            clipmap.ClearDirty(l);
+        CHECK(clipmap.Update(0.5f, 0.5f) == 0);
+        CHECK(!clipmap.GetLevel(0).dirty);
+
+        // One step each way on each axis: two new columns or rows of level 0
+        const float step = 2.0f * BaseSpacing;
+        const float moves[][2] = { { step, 0.0f }, { -step, 0.0f }, { 0.0f, step }, { 0.0f, -step } };
+        for (const auto& move : moves) {
+            TerrainClipmap moved(LevelCount, TextureSize, BaseSpacing);
+            moved.Update(0.0f, 0.0f);
+            moved.ClearDirty(0);
+
+            const size_t generated = moved.Update(move[0], move[1]);
+            CHECK(generated >= size_t(2) * TextureSize);
+            CHECK(generated <= size_t(LevelCount) * 2 * TextureSize);
+            CHECK(moved.GetLevel(0).dirty);
+            CHECK(MatchesFreshClipmap(moved, move[0], move[1]));
+        }
+
+        // Several steps at once, diagonally and back, and a jump past the stored samples
+        const float path[][2] = { { 5.0f * step, 3.0f * step }, { -7.0f * step, 2.0f * step }, { -6.5f * step, -9.0f * step },
+            { 1000.0f, -2000.0f } };
+        for (const auto& camera : path) {
+            clipmap.Update(camera[0], camera[1]);
+            CHECK(MatchesFreshClipmap(clipmap, camera[0], camera[1]));
+        }
+        CHECK(clipmap.Update(0.0f, 0.0f) == size_t(LevelCount) * TextureSize * TextureSize);
+    }
+
+    // The finer level sits gridSize / 4 quads into each ring, plus one depending on how the two
+    // snapped; all four combinations occur as the camera moves
+    void TestHoleOffsets() {
+        TerrainClipmap clipmap(LevelCount, TextureSize, BaseSpacing);
+        bool seen[2][2] = {};
+        for (int i = -8; i < 8; ++i) {
+            for (int j = -8; j < 8; ++j) {
+                clipmap.Update(float(i) * 2.0f * BaseSpacing, float(j) * 2.0f * BaseSpacing);
+                for (int l = 1; l < LevelCount; ++l) {
+                    int offsetX, offsetZ;
+                    clipmap.GetHoleOffset(l, offsetX, offsetZ);
+                    const int dx = offsetX - clipmap.GetGridSize() / 4;
+                    const int dz = offsetZ - clipmap.GetGridSize() / 4;
+                    CHECK(dx == 0 || dx == 1);
+                    CHECK(dz == 0 || dz == 1);
+                    if ((dx == 0 || dx == 1) && (dz == 0 || dz == 1))
+                        seen[dz][dx] = true;
+                    CHECK(clipmap.GetIndexRange(l) == 1 + dx + 2 * dz);
+                }
+                CHECK(clipmap.GetIndexRange(0) == 0);
+            }
+        }
+        CHECK(seen[0][0] && seen[0][1] && seen[1][0] && seen[1][1]);
+    }
+
+    // Span 0 covers every quad once; span 1 + dx + 2 * dz every quad outside its hole once
+    void TestRingIndexRanges() {
+        const int gridSize = TextureSize - 4;
+        const int vertsPerSide = gridSize + 1;
+        const int hole = gridSize / 2;
+
+        std::vector<uint32_t> indices;
+        const std::array<TerrainClipmap::IndexSpan, 5> spans = TerrainClipmap::BuildGridIndices(gridSize, indices);
+
+        uint32_t expectedStart = 0;
+        for (int span = 0; span < 5; ++span) {
+            CHECK(spans[span].startIndex == expectedStart);
+            CHECK(spans[span].indexCount % 6 == 0);
+            expectedStart += spans[span].indexCount;
+
+            const int holeX = span == 0 ? -1 : gridSize / 4 + (span - 1) % 2;
+            const int holeZ = span == 0 ? -1 : gridSize / 4 + (span - 1) / 2;
+            auto inHole = [&](int x, int z) {
+                return span != 0 && x >= holeX && x < holeX + hole && z >= holeZ && z < holeZ + hole;
+            };
+
+            // Two triangles per quad, each named by the quad's lowest x and z among its corners
+            std::vector<int> trianglesPerQuad(size_t(gridSize) * gridSize, 0);
+            for (uint32_t i = spans[span].startIndex; i < spans[span].startIndex + spans[span].indexCount; i += 3) {
+                int x = vertsPerSide, z = vertsPerSide;
+                for (uint32_t corner = i; corner < i + 3; ++corner) {
+                    x = std::min(x, int(indices[corner] % vertsPerSide));
+                    z = std::min(z, int(indices[corner] / vertsPerSide));
+                }
+                CHECK(x < gridSize && z < gridSize);
+                if (x < gridSize && z < gridSize)
+                    ++trianglesPerQuad[size_t(z) * gridSize + x];
+            }
+
+            int wrongQuads = 0;
+            for (int z = 0; z < gridSize; ++z) {
+                for (int x = 0; x < gridSize; ++x)
+                    wrongQuads += trianglesPerQuad[size_t(z) * gridSize + x] != (inHole(x, z) ? 0 : 2);
+            }
+            CHECK(wrongQuads == 0);
+        }
+        CHECK(expectedStart == indices.size());
+    }
+}
+
+void RunTerrainClipmapTests() {
+    TestToroidalUpdate();
+    TestHoleOffsets();
+    TestRingIndexRanges();
+}
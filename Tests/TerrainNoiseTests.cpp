@@ -0,0 +1,115 @@
+#include "TestHelpers.h"
+#include "../TerrainNoise.h"
+#include "../TerrainNoiseReference.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+    // Sample positions of a few rows of a chunk, as TerrainChunkHeightmap lays them out. 255 per
+    // row, so every width also runs its scalar leftovers.
+    constexpr int RowLength = 255;
+    constexpr int PatchSize = 4;
+    constexpr float NoiseScale = 0.075f;
+    constexpr int ChunkX = 3;
+    constexpr int ChunkZ = -2;
+    constexpr int Rows[] = { 0, 1, 128, 254 };
+
+    void ChunkRow(int row, std::vector<float>& x, std::vector<float>& z) {
+        const int visibleSize = RowLength * PatchSize;
+        x.resize(RowLength);
+        z.resize(RowLength);
+        for (int i = 0; i < RowLength; ++i) {
+            x[i] = float(ChunkX * visibleSize + i * PatchSize) * NoiseScale;
+            z[i] = float(ChunkZ * visibleSize + row * PatchSize) * NoiseScale;
+        }
+    }
+
+    // Scalar first, so it is the one every other level is compared with
+    std::vector<Simd::Level> SupportedLevels() {
+        std::vector<Simd::Level> levels = { Simd::Level::Scalar };
+        if (Simd::GetSupportedLevel() >= Simd::Level::SSE41)
+            levels.push_back(Simd::Level::SSE41);
+        if (Simd::GetSupportedLevel() >= Simd::Level::AVX2)
+            levels.push_back(Simd::Level::AVX2);
+        return levels;
+    }
+
+    // Every instruction set gives the reference's bits
+    void TestUberNoiseMatchesReference() {
+        const TerrainNoise::PerlinSettings perlin = { 1337, 0.01f };
+        const Simd::Level previous = TerrainNoise::GetSimdLevel();
+
+        for (float sharpness : { 0.25f, -0.4f, 0.0f }) {
+            UberNoiseParams params;
+            params.sharpness = sharpness;
+
+            std::vector<float> x, z;
+            for (int row : Rows) {
+                ChunkRow(row, x, z);
+                std::vector<float> reference(RowLength);
+                for (int i = 0; i < RowLength; ++i)
+                    reference[i] = TerrainNoiseReference::UberNoise(perlin, params, x[i], z[i]);
+
+                for (Simd::Level level : SupportedLevels()) {
+                    TerrainNoise::SetSimdLevel(level);
+                    std::vector<float> batch(RowLength);
+                    TerrainNoise::UberNoise(perlin, params, x.data(), z.data(), batch.data(), RowLength);
+                    CHECK(std::memcmp(batch.data(), reference.data(), RowLength * sizeof(float)) == 0);
+                }
+            }
+        }
+
+        TerrainNoise::SetSimdLevel(previous);
+    }
+
+    // Every instruction set gives the same bits, within the polynomial exp's error of the reference
+    void TestFbmNoiseWithFDMatchesReference() {
+        const TerrainNoise::PerlinSettings perlin = { 1337, 0.01f };
+        const Simd::Level previous = TerrainNoise::GetSimdLevel();
+        const int octaves = 8;
+        const float lacunarity = 1.8f;
+        const float gain = 0.5f;
+
+        // Each octave's amplitude carries the attenuation error of the ones before it (2 ulp of exp
+        // each), and the sum is normalized to about [-1, 1]
+        const float tolerance = 2.0f * octaves * FLT_EPSILON;
+
+        for (float kAtten : { 0.5f, 0.0f }) {
+            std::vector<float> x, z;
+            for (int row : Rows) {
+                ChunkRow(row, x, z);
+                std::vector<float> reference(RowLength);
+                for (int i = 0; i < RowLength; ++i)
+                    reference[i] = TerrainNoiseReference::FbmNoiseWithFD(perlin, octaves, lacunarity, gain, kAtten, x[i], z[i]);
+
+                std::vector<float> scalar;
+                for (Simd::Level level : SupportedLevels()) {
+                    TerrainNoise::SetSimdLevel(level);
+                    std::vector<float> batch(RowLength);
+                    TerrainNoise::FbmNoiseWithFD(perlin, octaves, lacunarity, gain, kAtten, x.data(), z.data(), batch.data(), RowLength);
+
+                    float maxError = 0.0f;
+                    for (int i = 0; i < RowLength; ++i)
+                        maxError = std::max(maxError, std::abs(batch[i] - reference[i]));
+                    CHECK(maxError <= tolerance);
+
+                    if (scalar.empty())
+                        scalar = batch;
+                    else
+                        CHECK(std::memcmp(batch.data(), scalar.data(), RowLength * sizeof(float)) == 0);
+                }
+            }
+        }
+
+        TerrainNoise::SetSimdLevel(previous);
+    }
+}
+
+void RunTerrainNoiseTests() {
+    TestUberNoiseMatchesReference();
+    TestFbmNoiseWithFDMatchesReference();
+}
@@ -0,0 +1,164 @@
+#include "TestHelpers.h"
+#include "StubCommandList.h"
+#include "../TerrainPatchTree.h"
+#include "../DX12Renderer/AllocationCounter.h"
+#include "../DX12Renderer/Application.h"
+#include "../DX12Renderer/CommandQueue.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+// Mesh creates and retires its own buffers through the application, which the tests never ask it
+// to; this keeps the device and the queue out of the link
+Application& Application::Get() {
+    std::abort();
+}
+
+Microsoft::WRL::ComPtr<ID3D12Device2> Application::GetDevice() const {
+    std::abort();
+}
+
+std::shared_ptr<CommandQueue> Application::GetCommandQueue(D3D12_COMMAND_LIST_TYPE) const {
+    std::abort();
+}
+
+void CommandQueue::ReleaseDeferred(Microsoft::WRL::ComPtr<ID3D12Pageable>, uint64_t) {
+    std::abort();
+}
+
+namespace {
+    // A tier with a power-of-two patch grid and one with empty nodes past its edge
+    constexpr int PatchesPerSideCases[] = { 64, 85 };
+    constexpr int PatchSize = 4;
+
+    std::vector<XMFLOAT2> PatchHeights(int patchesPerSide) {
+        std::vector<XMFLOAT2> heights(size_t(patchesPerSide) * patchesPerSide);
+        for (int z = 0; z < patchesPerSide; ++z)
+            for (int x = 0; x < patchesPerSide; ++x)
+                heights[size_t(z) * patchesPerSide + x] = XMFLOAT2(float((x * 7 + z * 3) % 50), float((x * 7 + z * 3) % 50 + 20));
+        return heights;
+    }
+
+    // Every plane passes the test with the last one replaced
+    std::array<XMFLOAT4, 6> Planes(const XMFLOAT4& plane) {
+        std::array<XMFLOAT4, 6> planes;
+        planes.fill(XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f));
+        planes[5] = plane;
+        return planes;
+    }
+
+    // Ranges come in index order, never overlap, and neighbours are merged
+    bool RangesAreMerged(const std::vector<IndexRange>& ranges) {
+        for (size_t i = 1; i < ranges.size(); ++i) {
+            if (ranges[i].startIndex <= ranges[i - 1].startIndex + ranges[i - 1].indexCount)
+                return false;
+        }
+        return true;
+    }
+
+    void TestCullAllOrNothing() {
+        for (int patchesPerSide : PatchesPerSideCases) {
+            TerrainPatchTree tree;
+            tree.Build(patchesPerSide, PatchHeights(patchesPerSide));
+            std::vector<IndexRange> ranges;
+
+            tree.Cull(Planes(XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f)), 0.0f, 0.0f, PatchSize, 0, ranges);
+            CHECK(ranges.size() == 1);
+            CHECK(ranges.size() == 1 && ranges[0].startIndex == 0 && ranges[0].indexCount == UINT(patchesPerSide * patchesPerSide * 4));
+
+            tree.Cull(Planes(XMFLOAT4(0.0f, 1.0f, 0.0f, -1000.0f)), 0.0f, 0.0f, PatchSize, 0, ranges);
+            CHECK(ranges.empty());
+        }
+    }
+
+    // Against a plane x >= cutX every leaf that reaches past it is drawn whole, and nothing else
+    void TestCullMatchesLeaves() {
+        for (int patchesPerSide : PatchesPerSideCases) {
+            TerrainPatchTree tree;
+            tree.Build(patchesPerSide, PatchHeights(patchesPerSide));
+            const auto& order = TerrainPatchTree::GetPatchOrder(patchesPerSide);
+            CHECK(order.size() == size_t(patchesPerSide) * patchesPerSide);
+
+            const float originX = -300.0f;
+            for (float cutX : { -250.0f, -3.0f, 17.5f, 45.0f }) {
+                std::vector<IndexRange> ranges;
+                tree.Cull(Planes(XMFLOAT4(1.0f, 0.0f, 0.0f, -cutX)), originX, 0.0f, PatchSize, 0, ranges);
+                CHECK(RangesAreMerged(ranges));
+
+                std::vector<bool> drawn(order.size(), false);
+                for (const IndexRange& range : ranges) {
+                    for (UINT index = range.startIndex; index < range.startIndex + range.indexCount; index += 4)
+                        drawn[index / 4] = true;
+                }
+
+                for (size_t patch = 0; patch < order.size(); ++patch) {
+                    const int leafX1 = std::min((order[patch].first / TerrainPatchTree::LeafSize + 1) * TerrainPatchTree::LeafSize, patchesPerSide);
+                    const bool visible = originX + float(leafX1 * PatchSize) >= cutX;
+                    if (drawn[patch] != visible) {
+                        CHECK(drawn[patch] == visible);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    // The steady-state part of recording one chunk (Tutorial2::RecordTerrainChunk): mesh handle
+    // copies and getters, culling into the recorder's reserved ranges and the draw-range loop.
+    // None of it may touch the heap. ScopedAllocationCounter counts in Debug builds only.
+    void TestChunkRecordingDoesNotAllocate() {
+        const int patchesPerSide = 85;
+        const UINT indexCount = UINT(patchesPerSide * patchesPerSide * 4);
+
+        TerrainPatchTree tree;
+        tree.Build(patchesPerSide, PatchHeights(patchesPerSide));
+
+        Mesh mesh;
+        mesh.SetSharedVertexBuffer(std::make_shared<BufferData>());
+        mesh.SetSharedIndexBuffer(std::make_shared<BufferData>(), indexCount);
+        mesh.AddTextureData({ { "Grass", nullptr }, { "Blend", nullptr }, { "Rock", nullptr } });
+
+        StubCommandList stubList;
+        Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList2> commandList = &stubList;
+
+        // Reserved like the chunk recorders: one range per leaf at most
+        const int leavesPerSide = (patchesPerSide + TerrainPatchTree::LeafSize - 1) / TerrainPatchTree::LeafSize;
+        std::vector<IndexRange> drawRanges;
+        drawRanges.reserve(size_t(leavesPerSide) * leavesPerSide);
+
+        // A few chunks either side of the cut, so some cull to nothing and some to several ranges
+        auto recordChunks = [&](size_t& drawnRanges) {
+            const std::array<XMFLOAT4, 6> planes = Planes(XMFLOAT4(1.0f, 0.0f, -1.0f, 0.0f));
+            for (int chunk = -2; chunk <= 2; ++chunk) {
+                const Mesh handle = mesh;
+                if (handle.GetIndexCount() != indexCount || handle.GetTexture("Grass") != nullptr || !handle.GetIndexList().empty())
+                    return;
+
+                tree.Cull(planes, float(chunk * patchesPerSide * PatchSize), 0.0f, PatchSize, 4, drawRanges);
+                handle.Draw(commandList, D3D_PRIMITIVE_TOPOLOGY_4_CONTROL_POINT_PATCHLIST, drawRanges);
+                drawnRanges += drawRanges.size();
+            }
+        };
+
+        size_t drawnRanges = 0;
+        recordChunks(drawnRanges);
+        const size_t warmUpDraws = stubList.drawCount;
+        CHECK(warmUpDraws == drawnRanges);
+        CHECK(warmUpDraws > 5);
+
+        drawnRanges = 0;
+        {
+            ScopedAllocationCounter allocations;
+            recordChunks(drawnRanges);
+            CHECK(allocations.GetCount() == 0);
+        }
+        CHECK(stubList.drawCount == warmUpDraws * 2);
+        CHECK(drawnRanges == warmUpDraws);
+    }
+}
+
+void RunTerrainPatchTreeTests() {
+    TestCullAllOrNothing();
+    TestCullMatchesLeaves();
+    TestChunkRecordingDoesNotAllocate();
+}
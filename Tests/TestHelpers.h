@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdio>
+
+// Unlike assert, CHECK stays on in Release builds. A failure is reported and counted, and main
+// returns nonzero.
+inline int& TestFailureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                  \
+    do {                                                                                  \
+        if (!(condition)) {                                                               \
+            std::printf("%s(%d): CHECK(%s) failed\n", __FILE__, __LINE__, #condition);    \
+            ++TestFailureCount();                                                         \
+        }                                                                                 \
+    } while (false)
@@ -0,0 +1,23 @@
+// CPU-only tests of the parts of the renderer that need no device. Run after building; the exit
+// code is the number of failed checks.
+#include "TestHelpers.h"
+
+void RunRenderGraphTests();
+void RunResourceBarrierBatchTests();
+void RunTerrainChunkHeightmapTests();
+void RunTerrainClipmapTests();
+void RunTerrainNoiseTests();
+void RunTerrainPatchTreeTests();
+
+int main() {
+    RunRenderGraphTests();
+    RunResourceBarrierBatchTests();
+    RunTerrainChunkHeightmapTests();
+    RunTerrainClipmapTests();
+    RunTerrainNoiseTests();
+    RunTerrainPatchTreeTests();
+
+    if (TestFailureCount() == 0)
+        std::printf("All tests passed\n");
+    return TestFailureCount();
+}
@@ -1,136 +1,163 @@
-#pragma once
-
-/*
- *  Copyright(c) 2018 Jeremiah van Oosten
- *
- *  Permission is hereby granted, free of charge, to any person obtaining a copy
- *  of this software and associated documentation files(the "Software"), to deal
- *  in the Software without restriction, including without limitation the rights
- *  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
- *  copies of the Software, and to permit persons to whom the Software is
- *  furnished to do so, subject to the following conditions :
- *
- *  The above copyright notice and this permission notice shall be included in
- *  all copies or substantial portions of the Software.
- *
- *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
- *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
- *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
- *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
- *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
- *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
- *  IN THE SOFTWARE.
- */
-
- /**
-  *  @file UploadBuffer.h
-  *  @date October 24, 2018
-  *  @author Jeremiah van Oosten
-  *
-  *  @brief An UploadBuffer provides a convenient method to upload resources to the GPU.
-  */
-
-#include "Defines.h"
-
-#include <d3d12.h>
-#include <wrl.h>
-
-#include <deque>
-#include <memory>
-
-class Device;
-
-class UploadBuffer
-{
-public:
-    // Use to upload data to the GPU
-    struct Allocation
-    {
-        void* CPU;
-        D3D12_GPU_VIRTUAL_ADDRESS GPU;
-    };
-
-    /**
-        * The maximum size of an allocation is the size of a single page.
-        */
-    size_t GetPageSize() const
-    {
-        return m_PageSize;
-    }
-
-    /**
-        * Allocate memory in an Upload heap.
-        * An allocation must not exceed the size of a page.
-        * Use a memcpy or similar method to copy the
-        * buffer data to CPU pointer in the Allocation structure returned from
-        * this function.
-        */
-    Allocation Allocate(size_t sizeInBytes, size_t alignment);
-
-    /**
-        * Release all allocated pages. This should only be done when the command list
-        * is finished executing on the CommandQueue.
-        */
-    void Reset();
-
-protected:
-    friend class std::default_delete<UploadBuffer>;
-
-    /**
-        * @param pageSize The size to use to allocate new pages in GPU memory.
-        */
-    explicit UploadBuffer(Microsoft::WRL::ComPtr<ID3D12Device2> device, size_t pageSize = _2MB);
-    virtual ~UploadBuffer();
-
-private:
-    // A single page for the allocator.
-    struct Page
-    {
-        Page(Microsoft::WRL::ComPtr<ID3D12Device2> device, size_t sizeInBytes);
-        ~Page();
-
-        // Check to see if the page has room to satisfy the requested
-        // allocation.
-        bool HasSpace(size_t sizeInBytes, size_t alignment) const;
-
-        // Allocate memory from the page.
-        // Throws std::bad_alloc if the the allocation size is larger
-        // that the page size or the size of the allocation exceeds the
-        // remaining space in the page.
-        Allocation Allocate(size_t sizeInBytes, size_t alignment);
-
-        // Reset the page for reuse.
-        void Reset();
-
-    private:
-        Microsoft::WRL::ComPtr<ID3D12Device2> m_Device;
-        Microsoft::WRL::ComPtr<ID3D12Resource> m_d3d12Resource;
-
-        // Base pointer.
-        void* m_CPUPtr;
-        D3D12_GPU_VIRTUAL_ADDRESS m_GPUPtr;
-
-        // Allocated page size.
-        size_t m_PageSize;
-        // Current allocation offset in bytes.
-        size_t m_Offset;
-    };
-
-    // A pool of memory pages.
-    using PagePool = std::deque<std::shared_ptr<Page>>;
-
-    // The device that was used to create this upload buffer.
-    Microsoft::WRL::ComPtr<ID3D12Device2> m_Device;
-
-    // Request a page from the pool of available pages
-    // or create a new page if there are no available pages.
-    std::shared_ptr<Page> RequestPage();
-
-    PagePool m_PagePool;
-    PagePool m_AvailablePages;
-
-    std::shared_ptr<Page> m_CurrentPage;
-
-    // The size of each page of memory.
-    size_t m_PageSize;
+#pragma once
+
+/*
+ *  Copyright(c) 2018 Jeremiah van Oosten
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files(the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions :
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *  FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ *  IN THE SOFTWARE.
+ */
+
+ /**
+  *  @file UploadBuffer.h
+  *  @date October 24, 2018
+  *  @author Jeremiah van Oosten
+  *
+  *  @brief An UploadBuffer provides a convenient method to upload resources to the GPU.
+  */
+
+#include "Defines.h"
+
+#include <d3d12.h>
+#include <wrl.h>
+
+#include <deque>
+#include <memory>
+#include <utility>
+
+class CommandQueue;
+class Device;
+
+class UploadBuffer
+{
+public:
+    // Use to upload data to the GPU
+    struct Allocation
+    {
+        void* CPU;
+        D3D12_GPU_VIRTUAL_ADDRESS GPU;
+    };
+
+    /**
+        * The maximum size of an allocation is the size of a single page.
+        */
+    size_t GetPageSize() const
+    {
+        return m_PageSize;
+    }
+
+    /**
+        * Allocate memory in an Upload heap.
+        * An allocation must not exceed the size of a page.
+        * Use a memcpy or similar method to copy the
+        * buffer data to CPU pointer in the Allocation structure returned from
+        * this function.
+        */
+    Allocation Allocate(size_t sizeInBytes, size_t alignment);
+
+    /**
+        * Release all allocated pages. This should only be done when the command list
+        * is finished executing on the CommandQueue.
+        */
+    void Reset();
+
+    /**
+        * Retire the pages allocated since the last call. They return to the pool once
+        * the queue has passed fenceValue (the fence of the submission that reads them),
+        * so the next frame can allocate without waiting for this one to finish.
+        */
+    void Retire(CommandQueue& queue, uint64_t fenceValue);
+
+    /**
+        * How many times a page was taken, new or pooled. Taking one may allocate (pool
+        * bookkeeping), so allocation checks around Allocate calls compare this before and after.
+        */
+    uint64_t GetPageRequestCount() const
+    {
+        return m_PageRequestCount;
+    }
+
+protected:
+    friend class std::default_delete<UploadBuffer>;
+
+    /**
+        * @param pageSize The size to use to allocate new pages in GPU memory.
+        */
+    explicit UploadBuffer(Microsoft::WRL::ComPtr<ID3D12Device2> device, size_t pageSize = _2MB);
+    virtual ~UploadBuffer();
+
+private:
+    // A single page for the allocator.
+    struct Page
+    {
+        Page(Microsoft::WRL::ComPtr<ID3D12Device2> device, size_t sizeInBytes);
+        ~Page();
+
+        // Check to see if the page has room to satisfy the requested
+        // allocation.
+        bool HasSpace(size_t sizeInBytes, size_t alignment) const;
+
+        // Allocate memory from the page.
+        // Throws std::bad_alloc if the the allocation size is larger
+        // that the page size or the size of the allocation exceeds the
+        // remaining space in the page.
+        Allocation Allocate(size_t sizeInBytes, size_t alignment);
+
+        // Reset the page for reuse.
+        void Reset();
+
+    private:
+        Microsoft::WRL::ComPtr<ID3D12Device2> m_Device;
+        Microsoft::WRL::ComPtr<ID3D12Resource> m_d3d12Resource;
+
+        // Base pointer.
+        void* m_CPUPtr;
+        D3D12_GPU_VIRTUAL_ADDRESS m_GPUPtr;
+
+        // Allocated page size.
+        size_t m_PageSize;
+        // Current allocation offset in bytes.
+        size_t m_Offset;
+    };
+
+    // A pool of memory pages.
+    using PagePool = std::deque<std::shared_ptr<Page>>;
+
+    // The device that was used to create this upload buffer.
+    Microsoft::WRL::ComPtr<ID3D12Device2> m_Device;
+
+    // Request a page from the pool of available pages
+    // or create a new page if there are no available pages.
+    std::shared_ptr<Page> RequestPage();
+
+    // Return retired pages whose fence is at or below fenceValue to the available pool.
+    void ReclaimPages(uint64_t fenceValue);
+
+    PagePool m_PagePool;
+    PagePool m_AvailablePages;
+    // Pages handed out since the last Retire.
+    PagePool m_UsedPages;
+    // Pages the GPU may still be reading, with the fence value that frees them.
+    std::deque<std::pair<uint64_t, std::shared_ptr<Page>>> m_RetiredPages;
+
+    std::shared_ptr<Page> m_CurrentPage;
+
+    // The size of each page of memory.
+    size_t m_PageSize;
+
+    uint64_t m_PageRequestCount = 0;
 };
\ No newline at end of file